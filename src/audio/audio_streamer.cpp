@@ -0,0 +1,173 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "audio/audio_streamer.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+
+#include "audio/stream_sound_source.hpp"
+
+namespace {
+
+/** How often the buffer queues are topped up, each one holds a few
+    seconds of audio */
+const std::chrono::milliseconds REFILL_INTERVAL(50);
+
+} // namespace
+
+AudioStreamer::AudioStreamer(bool threaded) :
+  m_commands(64),
+  m_sent(0),
+  m_processed(0),
+  m_mutex(),
+  m_wake_cond(),
+  m_done_cond(),
+  m_sources(),
+  m_thread()
+{
+  if (threaded)
+  {
+    m_thread = std::thread(&AudioStreamer::run, this);
+  }
+}
+
+AudioStreamer::~AudioStreamer()
+{
+  if (m_thread.joinable())
+  {
+    send(Command::QUIT, nullptr);
+    m_thread.join();
+  }
+}
+
+void
+AudioStreamer::add(StreamSoundSource& source)
+{
+  send(Command::ADD, &source);
+}
+
+void
+AudioStreamer::remove(StreamSoundSource& source)
+{
+  const uint64_t command = send(Command::REMOVE, &source);
+  if (m_thread.joinable())
+  {
+    wait_for(command);
+  }
+  else
+  {
+    process_commands();
+  }
+}
+
+void
+AudioStreamer::refill()
+{
+  assert(!m_thread.joinable());
+
+  process_commands();
+  for (auto* source : m_sources)
+  {
+    source->refill();
+  }
+}
+
+uint64_t
+AudioStreamer::send(Command::Type type, StreamSoundSource* source)
+{
+  while (!m_commands.push(Command{type, source}))
+  {
+    if (!m_thread.joinable())
+    {
+      // nobody else is going to make room
+      process_commands();
+    }
+    std::this_thread::yield();
+  }
+
+  {
+    // makes sure the thread either sees the command or is already
+    // waiting when notified
+    std::lock_guard<std::mutex> lock(m_mutex);
+  }
+  m_wake_cond.notify_one();
+
+  return ++m_sent;
+}
+
+void
+AudioStreamer::wait_for(uint64_t command)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_cond.wait(lock, [this, command]{ return m_processed.load() >= command; });
+}
+
+bool
+AudioStreamer::process_commands()
+{
+  bool quit = false;
+  Command command;
+  uint64_t processed = m_processed.load();
+  while (!quit && m_commands.pop(command))
+  {
+    switch (command.type)
+    {
+      case Command::ADD:
+        m_sources.push_back(command.source);
+        break;
+
+      case Command::REMOVE:
+        m_sources.erase(std::remove(m_sources.begin(), m_sources.end(), command.source),
+                        m_sources.end());
+        break;
+
+      case Command::QUIT:
+        quit = true;
+        break;
+    }
+    ++processed;
+  }
+
+  if (processed != m_processed.load())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_processed = processed;
+    }
+    m_done_cond.notify_all();
+  }
+
+  return !quit;
+}
+
+void
+AudioStreamer::run()
+{
+  while (process_commands())
+  {
+    for (auto* source : m_sources)
+    {
+      source->refill();
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake_cond.wait_for(lock, REFILL_INTERVAL, [this]{ return !m_commands.empty(); });
+  }
+}
+
+/* EOF */
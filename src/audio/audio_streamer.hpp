@@ -0,0 +1,97 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_AUDIO_AUDIO_STREAMER_HPP
+#define HEADER_SUPERTUX_AUDIO_AUDIO_STREAMER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+#include "util/spsc_queue.hpp"
+
+class StreamSoundSource;
+
+/** Thread that keeps the buffer queues of all StreamSoundSources
+    filled, so that decoding doesn't happen on the game thread and long
+    frames don't let the music run dry. The game thread hands sources
+    over through a lock-free queue, add() and remove() must only be
+    called from it. Without a thread, the game thread calls refill()
+    itself, which keeps the timing deterministic for rendering
+    offline. */
+class AudioStreamer final
+{
+public:
+  AudioStreamer(bool threaded = true);
+  ~AudioStreamer();
+
+  /** Starts refilling source */
+  void add(StreamSoundSource& source);
+
+  /** Stops refilling source, returns once the thread let go of it */
+  void remove(StreamSoundSource& source);
+
+  /** Tops up all sources, only to be called when there is no thread */
+  void refill();
+
+private:
+  struct Command
+  {
+    enum Type { ADD, REMOVE, QUIT };
+
+    Type type;
+    StreamSoundSource* source;
+  };
+
+  /** Returns the number the command will have in m_processed */
+  uint64_t send(Command::Type type, StreamSoundSource* source);
+  void wait_for(uint64_t command);
+
+  /** Returns false once QUIT came in */
+  bool process_commands();
+  void run();
+
+private:
+  SPSCQueue<Command> m_commands;
+
+  /** Commands sent, only touched by the game thread */
+  uint64_t m_sent;
+
+  /** Commands the thread is done with */
+  std::atomic<uint64_t> m_processed;
+
+  /** Only used to sleep and wake up, the data is passed through
+      m_commands */
+  std::mutex m_mutex;
+  std::condition_variable m_wake_cond;
+  std::condition_variable m_done_cond;
+
+  /** Sources being refilled, only touched by the thread */
+  std::vector<StreamSoundSource*> m_sources;
+
+  std::thread m_thread;
+
+private:
+  AudioStreamer(const AudioStreamer&) = delete;
+  AudioStreamer& operator=(const AudioStreamer&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -20,26 +20,28 @@
 #include "util/log.hpp"
 
 OpenALSoundSource::OpenALSoundSource() :
-  m_source(),
+  m_source(SoundManager::current()->acquire_source()),
   m_gain(1.0f),
   m_volume(1.0f)
 {
-  alGenSources(1, &m_source);
-  try
-  {
-    SoundManager::check_al_error("Couldn't create audio source: ");
-  }
-  catch(std::exception& e)
-  {
-    log_warning << e.what() << std::endl;
-  }
+  // pooled sources keep whatever their last user set
+  alSourcef(m_source, AL_GAIN, 1.0f);
+  alSourcef(m_source, AL_PITCH, 1.0f);
+  alSource3f(m_source, AL_POSITION, 0.0f, 0.0f, 0.0f);
+  alSource3f(m_source, AL_VELOCITY, 0.0f, 0.0f, 0.0f);
+  alSourcei(m_source, AL_SOURCE_RELATIVE, AL_FALSE);
+  alSourcei(m_source, AL_LOOPING, AL_FALSE);
   set_reference_distance(128);
 }
 
 OpenALSoundSource::~OpenALSoundSource()
 {
   stop();
-  alDeleteSources(1, &m_source);
+  if (SoundManager::current()) {
+    SoundManager::current()->release_source(m_source);
+  } else {
+    alDeleteSources(1, &m_source);
+  }
 }
 
 void
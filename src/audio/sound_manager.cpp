@@ -17,43 +17,106 @@
 #include "audio/sound_manager.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <assert.h>
 #include <stdexcept>
 #include <sstream>
 #include <memory>
+#include <set>
 
+#include "audio/audio_streamer.hpp"
 #include "audio/dummy_sound_source.hpp"
 #include "audio/sound_file.hpp"
 #include "audio/stream_sound_source.hpp"
+#include "supertux/level_manifest.hpp"
 #include "util/log.hpp"
 
-SoundManager::SoundManager() :
-  m_device(alcOpenDevice(nullptr)),
-  m_context(alcCreateContext(m_device, nullptr)),
+// from alext.h, which not every OpenAL implementation ships
+#ifndef ALC_SOFT_loopback
+#define ALC_FORMAT_CHANNELS_SOFT 0x1990
+#define ALC_FORMAT_TYPE_SOFT 0x1991
+#define ALC_SHORT_SOFT 0x1402
+#define ALC_STEREO_SOFT 0x1501
+typedef ALCdevice* (ALC_APIENTRY *LPALCLOOPBACKOPENDEVICESOFT)(const ALCchar* device_name);
+#endif
+
+SoundManager::SoundManager(Output output) :
+  m_output(output),
+  m_device(nullptr),
+  m_context(nullptr),
+  m_render_samples(nullptr),
   m_sound_enabled(false),
   m_sound_volume(0),
   m_buffers(),
+  m_play_counts(),
+  m_buffer_use_counter(0),
+  m_buffer_bytes(0),
+  m_buffer_budget(16 * 1024 * 1024),
+  m_cache_hits(0),
+  m_cache_misses(0),
+  m_cache_evictions(0),
   m_sources(),
-  m_update_list(),
+  m_source_pool(),
+  m_all_sources(),
+  m_sources_peak(0),
+  m_plays_rejected(0),
+  m_voices_stolen(0),
+  m_source_failures(0),
+  m_source_failing(false),
+  m_listener_position(),
+  m_streamer(),
   m_music_source(),
   m_music_enabled(false),
   m_music_volume(0),
   m_current_music()
 {
+  if (m_output == OUTPUT_NONE)
+    return;
+
   try {
-    if (m_device == nullptr) {
-      throw std::runtime_error("Couldn't open audio device.");
+    if (m_output == OUTPUT_LOOPBACK) {
+      open_loopback_device();
+    } else {
+      m_device = alcOpenDevice(nullptr);
+      if (m_device == nullptr) {
+        throw std::runtime_error("Couldn't open audio device.");
+      }
+      m_context = alcCreateContext(m_device, nullptr);
     }
     check_alc_error("Couldn't create audio context: ");
     alcMakeContextCurrent(m_context);
     check_alc_error("Couldn't select audio context: ");
 
     check_al_error("Audio error after init: ");
+
+    for (size_t i = 0; i < SOURCE_POOL_SIZE; ++i) {
+      ALuint source;
+      alGenSources(1, &source);
+      if (alGetError() != AL_NO_ERROR) {
+        // the driver ran out of sources
+        break;
+      }
+      m_source_pool.push_back(source);
+    }
+    m_all_sources = m_source_pool;
+    if (m_all_sources.size() <= RESERVED_SOURCES) {
+      throw std::runtime_error("Couldn't create enough audio sources");
+    }
+    log_info << "Allocated " << m_all_sources.size() << " audio sources" << std::endl;
+
+    // a thread would refill the streams at unpredictable points in the
+    // loopback output, render() does it instead
+    m_streamer = std::make_unique<AudioStreamer>(m_output == OUTPUT_DEVICE);
     m_sound_enabled = true;
     m_music_enabled = true;
 
     set_listener_orientation(Vector(0.0f, 0.0f), Vector(0.0f, -1.0f));
   } catch(std::exception& e) {
+    if (!m_source_pool.empty()) {
+      alDeleteSources(static_cast<ALsizei>(m_source_pool.size()), m_source_pool.data());
+      m_source_pool.clear();
+      m_all_sources.clear();
+    }
     if (m_context != nullptr) {
       alcDestroyContext(m_context);
       m_context = nullptr;
@@ -62,6 +125,7 @@ SoundManager::SoundManager() :
       alcCloseDevice(m_device);
       m_device = nullptr;
     }
+    m_render_samples = nullptr;
     log_warning << "Couldn't initialize audio device: " << e.what() << std::endl;
     print_openal_version();
   }
@@ -71,9 +135,18 @@ SoundManager::~SoundManager()
 {
   m_music_source.reset();
   m_sources.clear();
+  m_streamer.reset();
+
+  if (m_source_pool.size() != m_all_sources.size()) {
+    log_warning << (m_all_sources.size() - m_source_pool.size())
+                << " audio sources outlive the SoundManager" << std::endl;
+  }
+  if (!m_source_pool.empty()) {
+    alDeleteSources(static_cast<ALsizei>(m_source_pool.size()), m_source_pool.data());
+  }
 
   for (const auto& buffer : m_buffers) {
-    alDeleteBuffers(1, &buffer.second);
+    alDeleteBuffers(1, &buffer.second.buffer);
   }
 
   if (m_context != nullptr) {
@@ -114,31 +187,40 @@ SoundManager::intern_create_sound_source(const std::string& filename)
 {
   assert(m_sound_enabled);
 
-  auto source = std::make_unique<OpenALSoundSource>();
-  source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+  const int plays = ++m_play_counts[filename];
 
   ALuint buffer;
 
   // reuse an existing static sound buffer
   auto it = m_buffers.find(filename);
   if (it != m_buffers.end()) {
-    buffer = it->second;
+    m_cache_hits += 1;
+    it->second.last_use = ++m_buffer_use_counter;
+    buffer = it->second.buffer;
   } else {
+    m_cache_misses += 1;
+
+    if (LevelManifest::current()) {
+      LevelManifest::current()->report_load(filename);
+    }
+
     // Load sound file
     std::unique_ptr<SoundFile> file(load_sound_file(filename));
 
-    if (file->m_size < 100000) {
-      buffer = load_file_into_buffer(*file);
-      m_buffers.insert(std::make_pair(filename, buffer));
+    if (worth_caching(file->m_size, plays)) {
+      buffer = cache_buffer(filename, *file);
     } else {
       auto source_ = std::make_unique<StreamSoundSource>();
       source_->set_sound_file(std::move(file));
+      source_->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
       return std::move(source_);
     }
 
     log_debug << "Uncached sound \"" << filename << "\" requested to be played" << std::endl;
   }
 
+  auto source = std::make_unique<OpenALSoundSource>();
+  source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
   alSourcei(source->m_source, AL_BUFFER, buffer);
   return source;
 }
@@ -150,9 +232,16 @@ SoundManager::create_sound_source(const std::string& filename)
     return create_dummy_sound_source();
 
   try {
-    return intern_create_sound_source(filename);
+    auto source = intern_create_sound_source(filename);
+    m_source_failing = false;
+    return std::move(source);
   } catch(std::exception &e) {
-    log_warning << "Couldn't create audio source: " << e.what() << std::endl;
+    // objects keep asking every frame while the sources are used up
+    m_source_failures += 1;
+    if (!m_source_failing) {
+      log_warning << "Couldn't create audio source: " << e.what() << std::endl;
+      m_source_failing = true;
+    }
     return create_dummy_sound_source();
   }
 }
@@ -167,35 +256,113 @@ SoundManager::preload(const std::string& filename)
   // already loaded?
   if (it != m_buffers.end())
     return;
+
+  if (LevelManifest::current()) {
+    LevelManifest::current()->report_load(filename);
+  }
+
   try {
     std::unique_ptr<SoundFile> file (load_sound_file(filename));
-    // only keep small files
-    if (file->m_size >= 100000)
+    // a preload announces a play, but isn't one yet
+    if (!worth_caching(file->m_size, m_play_counts[filename] + 1))
       return;
 
-    ALuint buffer = load_file_into_buffer(*file);
-    m_buffers.insert(std::make_pair(filename, buffer));
+    cache_buffer(filename, *file);
   } catch(std::exception& e) {
     log_warning << "Error while preloading sound file: " << e.what() << std::endl;
   }
 }
 
+void
+SoundManager::set_cache_budget(size_t bytes)
+{
+  m_buffer_budget = bytes;
+  evict_buffers(0);
+}
+
+bool
+SoundManager::worth_caching(size_t size, int plays) const
+{
+  return size <= m_buffer_budget && size < static_cast<size_t>(plays) * STREAM_THRESHOLD;
+}
+
+ALuint
+SoundManager::cache_buffer(const std::string& filename, SoundFile& file)
+{
+  evict_buffers(file.m_size);
+
+  ALuint buffer = load_file_into_buffer(file);
+  m_buffers[filename] = CachedBuffer{buffer, file.m_size, ++m_buffer_use_counter};
+  m_buffer_bytes += file.m_size;
+  return buffer;
+}
+
+void
+SoundManager::evict_buffers(size_t needed)
+{
+  if (m_buffer_bytes + needed <= m_buffer_budget)
+    return;
+
+  // OpenAL refuses to delete buffers that are still attached
+  std::set<ALuint> attached;
+  for (const auto& source : m_all_sources) {
+    ALint buffer = 0;
+    alGetSourcei(source, AL_BUFFER, &buffer);
+    attached.insert(static_cast<ALuint>(buffer));
+  }
+
+  std::vector<std::map<std::string, CachedBuffer>::iterator> candidates;
+  for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it) {
+    if (attached.find(it->second.buffer) == attached.end()) {
+      candidates.push_back(it);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::map<std::string, CachedBuffer>::iterator& lhs,
+               const std::map<std::string, CachedBuffer>::iterator& rhs) {
+              return lhs->second.last_use < rhs->second.last_use;
+            });
+
+  for (const auto& it : candidates) {
+    if (m_buffer_bytes + needed <= m_buffer_budget)
+      break;
+
+    log_debug << "Dropping cached sound \"" << it->first << "\"" << std::endl;
+    alDeleteBuffers(1, &it->second.buffer);
+    m_buffer_bytes -= it->second.size;
+    m_buffers.erase(it);
+    m_cache_evictions += 1;
+  }
+}
+
 void
 SoundManager::play(const std::string& filename, const Vector& pos)
 {
   if (!m_sound_enabled)
     return;
 
+  const bool relative = (pos.x < 0 || pos.y < 0);
+  const float distance = relative ? 0.0f : (pos - m_listener_position).norm();
+
+  const auto instances = std::count_if(m_sources.begin(), m_sources.end(),
+                                       [&filename](const Voice& voice) {
+                                         return voice.filename == filename && voice.source->playing();
+                                       });
+  if (instances >= MAX_SOUND_INSTANCES || !reserve_voice(distance)) {
+    m_plays_rejected += 1;
+    return;
+  }
+
   try {
     std::unique_ptr<OpenALSoundSource> source(intern_create_sound_source(filename));
 
-    if (pos.x < 0 || pos.y < 0) {
+    if (relative) {
       source->set_relative(true);
     } else {
       source->set_position(pos);
     }
     source->play();
-    m_sources.push_back(std::move(source));
+    m_sources.push_back(Voice{std::move(source), filename, distance});
   } catch(std::exception& e) {
     log_warning << "Couldn't play sound " << filename << ": " << e.what() << std::endl;
   }
@@ -208,32 +375,98 @@ SoundManager::manage_source(std::unique_ptr<SoundSource> source)
   if (dynamic_cast<OpenALSoundSource*>(source.get()))
   {
     std::unique_ptr<OpenALSoundSource> openal_source(dynamic_cast<OpenALSoundSource*>(source.release()));
-    m_sources.push_back(std::move(openal_source));
+    m_sources.push_back(Voice{std::move(openal_source), std::string(), -1.0f});
   }
 }
 
+ALuint
+SoundManager::acquire_source()
+{
+  if (m_source_pool.empty()) {
+    // persistent sources of objects like flames can drain the pool,
+    // the driver may well have more
+    ALuint source;
+    alGenSources(1, &source);
+    if (alGetError() != AL_NO_ERROR) {
+      throw std::runtime_error("No audio sources left");
+    }
+    m_all_sources.push_back(source);
+    m_source_pool.push_back(source);
+  }
+
+  ALuint source = m_source_pool.back();
+  m_source_pool.pop_back();
+  m_sources_peak = std::max(m_sources_peak, m_all_sources.size() - m_source_pool.size());
+  return source;
+}
+
+void
+SoundManager::release_source(ALuint source)
+{
+  m_source_pool.push_back(source);
+}
+
+bool
+SoundManager::reserve_voice(float distance)
+{
+  if (m_source_pool.size() > RESERVED_SOURCES)
+    return true;
+
+  // finished voices are otherwise only cleaned up in update()
+  m_sources.erase(std::remove_if(m_sources.begin(), m_sources.end(),
+                                 [](const Voice& voice) {
+                                   return !voice.source->playing();
+                                 }),
+                  m_sources.end());
+  if (m_source_pool.size() > RESERVED_SOURCES)
+    return true;
+
+  auto victim = m_sources.end();
+  for (auto it = m_sources.begin(); it != m_sources.end(); ++it) {
+    if (it->distance >= 0.0f &&
+        (victim == m_sources.end() || it->distance > victim->distance)) {
+      victim = it;
+    }
+  }
+
+  if (victim == m_sources.end() || victim->distance <= distance)
+    return false;
+
+  m_sources.erase(victim);
+  m_voices_stolen += 1;
+  return true;
+}
+
+void
+SoundManager::print_stats() const
+{
+  log_info << "audio sources: " << (m_all_sources.size() - m_source_pool.size())
+           << " of " << m_all_sources.size() << " in use, peak " << m_sources_peak
+           << ", " << m_sources.size() << " managed" << std::endl;
+  log_info << "plays rejected: " << m_plays_rejected
+           << ", voices stolen: " << m_voices_stolen
+           << ", sources failed: " << m_source_failures << std::endl;
+  log_info << "sound cache: " << m_buffers.size() << " sounds, "
+           << m_buffer_bytes / 1024 << " of " << m_buffer_budget / 1024 << " KiB, "
+           << m_cache_hits << " hits, " << m_cache_misses << " misses, "
+           << m_cache_evictions << " evictions" << std::endl;
+}
+
 void
 SoundManager::register_for_update(StreamSoundSource* sss)
 {
-  if (sss)
+  if (sss && m_streamer)
   {
-    m_update_list.push_back(sss);
+    m_streamer->add(*sss);
   }
 }
 
 void
 SoundManager::remove_from_update(StreamSoundSource* sss)
 {
-  if (sss)
+  if (sss && m_streamer)
   {
-    auto it = m_update_list.begin();
-    while (it != m_update_list.end()) {
-      if (*it == sss) {
-        it = m_update_list.erase(it);
-      } else {
-        ++it;
-      }
-    }
+    m_streamer->remove(*sss);
   }
 }
 
@@ -342,9 +575,9 @@ SoundManager::pause_music(float fadetime)
 void
 SoundManager::pause_sounds()
 {
-  for (auto& source : m_sources) {
-    if (source->playing()) {
-      source->pause();
+  for (auto& voice : m_sources) {
+    if (voice.source->playing()) {
+      voice.source->pause();
     }
   }
 }
@@ -352,9 +585,9 @@ SoundManager::pause_sounds()
 void
 SoundManager::resume_sounds()
 {
-  for (auto& source : m_sources) {
-    if (source->paused()) {
-      source->resume();
+  for (auto& voice : m_sources) {
+    if (voice.source->paused()) {
+      voice.source->resume();
     }
   }
 }
@@ -362,8 +595,8 @@ SoundManager::resume_sounds()
 void
 SoundManager::stop_sounds()
 {
-  for (auto& source : m_sources) {
-    source->stop();
+  for (auto& voice : m_sources) {
+    voice.source->stop();
   }
 }
 
@@ -371,8 +604,8 @@ void
 SoundManager::set_sound_volume(int volume)
 {
   m_sound_volume = volume;
-  for (auto& source : m_sources) {
-    source->set_volume(static_cast<float>(volume) / 100.0f);
+  for (auto& voice : m_sources) {
+    voice.source->set_volume(static_cast<float>(volume) / 100.0f);
   }
 }
 
@@ -394,12 +627,17 @@ SoundManager::resume_music(float fadetime)
 void
 SoundManager::set_listener_position(const Vector& pos)
 {
+  m_listener_position = pos;
+
   static Uint32 lastticks = SDL_GetTicks();
 
-  Uint32 current_ticks = SDL_GetTicks();
-  if (current_ticks - lastticks < 300)
-    return;
-  lastticks = current_ticks;
+  // the loopback output must not depend on the wall clock
+  if (m_output == OUTPUT_DEVICE) {
+    Uint32 current_ticks = SDL_GetTicks();
+    if (current_ticks - lastticks < 300)
+      return;
+    lastticks = current_ticks;
+  }
 
   alListener3f(AL_POSITION, pos.x, pos.y, -300);
 }
@@ -421,15 +659,18 @@ void
 SoundManager::update()
 {
   static Uint32 lasttime = SDL_GetTicks();
-  Uint32 now = SDL_GetTicks();
 
-  if (now - lasttime < 300)
-    return;
-  lasttime = now;
+  // the loopback output must not depend on the wall clock
+  if (m_output == OUTPUT_DEVICE) {
+    Uint32 now = SDL_GetTicks();
+    if (now - lasttime < 300)
+      return;
+    lasttime = now;
+  }
 
   // update and check for finished sound sources
   for (auto it = m_sources.begin(); it != m_sources.end(); ) {
-    auto& source = *it;
+    auto& source = it->source;
 
     source->update();
 
@@ -449,13 +690,51 @@ SoundManager::update()
     alcProcessContext(m_context);
     check_alc_error("Error while processing audio context: ");
   }
+}
+
+void
+SoundManager::render(int16_t* samples, size_t frames)
+{
+  assert(m_output == OUTPUT_LOOPBACK);
 
-  //run update() for stream_sound_source
-  auto s = m_update_list.begin();
-  while (s != m_update_list.end()) {
-    (*s)->update();
-    ++s;
+  if (m_render_samples == nullptr || m_device == nullptr) {
+    std::fill(samples, samples + 2 * frames, int16_t(0));
+    return;
   }
+
+  if (m_streamer) {
+    m_streamer->refill();
+  }
+  m_render_samples(m_device, samples, static_cast<ALCsizei>(frames));
+}
+
+void
+SoundManager::open_loopback_device()
+{
+  if (!alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback")) {
+    throw std::runtime_error("OpenAL has no loopback device, ALC_SOFT_loopback is missing");
+  }
+
+  auto loopback_open_device = reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(
+    alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT"));
+  m_render_samples = reinterpret_cast<RenderSamplesFunc>(
+    alcGetProcAddress(nullptr, "alcRenderSamplesSOFT"));
+  if (loopback_open_device == nullptr || m_render_samples == nullptr) {
+    throw std::runtime_error("Couldn't look up the ALC_SOFT_loopback functions");
+  }
+
+  m_device = loopback_open_device(nullptr);
+  if (m_device == nullptr) {
+    throw std::runtime_error("Couldn't open loopback audio device.");
+  }
+
+  const ALCint attributes[] = {
+    ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+    ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+    ALC_FREQUENCY, LOOPBACK_RATE,
+    0
+  };
+  m_context = alcCreateContext(m_device, attributes);
 }
 
 ALenum
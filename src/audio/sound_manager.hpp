@@ -19,6 +19,7 @@
 
 #include <map>
 #include <memory>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include "math/vector.hpp"
 #include "util/currenton.hpp"
 
+class AudioStreamer;
 class SoundFile;
 class SoundSource;
 class StreamSoundSource;
@@ -38,6 +40,24 @@ class SoundManager final : public Currenton<SoundManager>
   friend class OpenALSoundSource;
   friend class StreamSoundSource;
 
+private:
+  /** Number of OpenAL sources allocated up front, less if the driver
+      doesn't have that many. The pool grows beyond it when sources
+      run out, until the driver refuses to create more. */
+  static const size_t SOURCE_POOL_SIZE = 64;
+
+  /** Sources play() leaves for music and sources created through
+      create_sound_source() */
+  static const size_t RESERVED_SOURCES = 8;
+
+  /** How often a single sound may play at the same time through play() */
+  static const int MAX_SOUND_INSTANCES = 4;
+
+  /** A sound gets decoded into a cached buffer once it has been played
+      often enough to have cost this many bytes per play, until then it
+      is streamed. Short sounds are therefore cached right away. */
+  static const size_t STREAM_THRESHOLD = 100000;
+
 private:
   static ALuint load_file_into_buffer(SoundFile& file);
   static ALenum get_sample_format(const SoundFile& file);
@@ -46,7 +66,24 @@ private:
   static void check_al_error(const char* message);
 
 public:
-  SoundManager();
+  enum Output {
+    /** Play through the default audio device */
+    OUTPUT_DEVICE,
+
+    /** Never touch the audio hardware and play nothing */
+    OUTPUT_NONE,
+
+    /** Mix in software into memory, only as render() asks for it, so
+        that tests and benchmarks get the same result on every run
+        and don't need a sound card. Needs OpenAL Soft. */
+    OUTPUT_LOOPBACK
+  };
+
+  /** Sample rate of OUTPUT_LOOPBACK, which renders 16 bit stereo */
+  static const int LOOPBACK_RATE = 44100;
+
+public:
+  SoundManager(Output output = OUTPUT_DEVICE);
   virtual ~SoundManager();
 
   void enable_sound(bool sound_enabled);
@@ -67,6 +104,10 @@ public:
   /** preloads a sound, so that you don't get a lag later when playing it */
   void preload(const std::string& name);
 
+  /** Limits the memory of decoded sounds kept around, the least
+      recently played ones get dropped first */
+  void set_cache_budget(size_t bytes);
+
   void set_listener_position(const Vector& position);
   void set_listener_velocity(const Vector& velocity);
   void set_listener_orientation(const Vector& at, const Vector& up);
@@ -87,13 +128,24 @@ public:
   bool is_sound_enabled() const { return m_sound_enabled; }
 
   bool is_audio_enabled() const { return m_device != nullptr && m_context != nullptr; }
+
+  /** Prints the use of the source pool and the sound cache to the log */
+  void print_stats() const;
+
   std::string get_current_music() const { return m_current_music; }
   void update();
 
-  /** Tell soundmanager to call update() for stream_sound_source. */
+  /** Mixes the next frames sample frames of OUTPUT_LOOPBACK into
+      samples, interleaved left and right. Streams are topped up
+      first, so frames shouldn't exceed a second or so. */
+  void render(int16_t* samples, size_t frames);
+
+  /** Hand stream_sound_source to the AudioStreamer, which keeps its
+      buffers filled. */
   void register_for_update(StreamSoundSource* sss);
 
-  /** Unsubscribe from updates for stream_sound_source. */
+  /** Take stream_sound_source back from the AudioStreamer, returns
+      once it is no longer touched from there. */
   void remove_from_update(StreamSoundSource* sss);
 
 private:
@@ -102,16 +154,87 @@ private:
 
   void check_alc_error(const char* message) const;
 
+  /** Sets up m_device and m_context for OUTPUT_LOOPBACK */
+  void open_loopback_device();
+
+  /** Takes a source out of the pool, creating one when it is empty,
+      throws when the driver has no more */
+  ALuint acquire_source();
+  void release_source(ALuint source);
+
+  /** Makes sure play() may take a source from the pool, stopping the
+      voice farthest away if it is further away than distance. Returns
+      false if the sound shouldn't be played. */
+  bool reserve_voice(float distance);
+
+  /** Whether a file of size bytes that is played for the plays-th
+      time should be decoded into a cached buffer instead of streamed */
+  bool worth_caching(size_t size, int plays) const;
+  ALuint cache_buffer(const std::string& filename, SoundFile& file);
+
+  /** Deletes least recently used buffers until needed more bytes fit
+      into the budget, buffers attached to a source are kept */
+  void evict_buffers(size_t needed);
+
 private:
+  typedef void (ALC_APIENTRY *RenderSamplesFunc)(ALCdevice* device, ALCvoid* buffer, ALCsizei samples);
+
+private:
+  Output m_output;
   ALCdevice* m_device;
   ALCcontext* m_context;
+  RenderSamplesFunc m_render_samples;
   bool m_sound_enabled;
   int m_sound_volume;
 
-  std::map<std::string, ALuint> m_buffers;
-  std::vector<std::unique_ptr<OpenALSoundSource> > m_sources;
-
-  std::vector<StreamSoundSource*> m_update_list;
+  struct CachedBuffer
+  {
+    ALuint buffer;
+    size_t size;
+    unsigned last_use;
+  };
+  std::map<std::string, CachedBuffer> m_buffers;
+
+  /** How often each sound was requested, cached or not */
+  std::map<std::string, int> m_play_counts;
+  unsigned m_buffer_use_counter;
+  size_t m_buffer_bytes;
+  size_t m_buffer_budget;
+  int m_cache_hits;
+  int m_cache_misses;
+  int m_cache_evictions;
+
+  struct Voice
+  {
+    std::unique_ptr<OpenALSoundSource> source;
+
+    /** Empty for sources handed over through manage_source() */
+    std::string filename;
+
+    /** Distance to the listener when started, 0 for relative sounds.
+        Voices further away get stopped first when the pool runs dry,
+        a negative distance means never. */
+    float distance;
+  };
+  std::vector<Voice> m_sources;
+
+  /** OpenAL sources that are free to use */
+  std::vector<ALuint> m_source_pool;
+
+  /** All sources of the pool, whether in use or not */
+  std::vector<ALuint> m_all_sources;
+  size_t m_sources_peak;
+  int m_plays_rejected;
+  int m_voices_stolen;
+
+  /** create_sound_source() calls that had to hand out a dummy,
+      only the first of a row gets logged */
+  int m_source_failures;
+  bool m_source_failing;
+
+  Vector m_listener_position;
+
+  std::unique_ptr<AudioStreamer> m_streamer;
 
   std::unique_ptr<StreamSoundSource> m_music_source;
 
@@ -20,12 +20,24 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
+#include <iterator>
+
 StreamSoundSource::StreamSoundSource() :
   m_file(),
+  m_free_buffers(),
+  m_fragment(new char[STREAMFRAGMENTSIZE]),
+  m_eof(false),
+  m_registered(false),
+  m_mutex(),
+  m_play_requested(false),
+  m_was_playing(false),
+  m_looping(false),
+  m_underruns(0),
+  m_underruns_reported(0),
+  m_error(),
   m_fade_state(NoFading),
   m_fade_start_time(),
-  m_fade_time(),
-  m_looping(false)
+  m_fade_time()
 {
   alGenBuffers(STREAMFRAGMENTS, m_buffers);
   try
@@ -36,16 +48,17 @@ StreamSoundSource::StreamSoundSource() :
   {
     log_warning << e.what() << std::endl;
   }
-  //add me to update list
-  SoundManager::current()->register_for_update( this );
+  m_free_buffers.assign(std::begin(m_buffers), std::end(m_buffers));
 }
 
 StreamSoundSource::~StreamSoundSource()
 {
   //don't update me any longer
-  SoundManager::current()->remove_from_update( this );
+  if (m_registered) {
+    SoundManager::current()->remove_from_update( this );
+  }
   m_file.reset();
-  stop();
+  OpenALSoundSource::stop();
   alDeleteBuffers(STREAMFRAGMENTS, m_buffers);
   try
   {
@@ -61,44 +74,68 @@ StreamSoundSource::~StreamSoundSource()
 void
 StreamSoundSource::set_sound_file(std::unique_ptr<SoundFile> newfile)
 {
+  // the AudioStreamer has to let go of the old file first
+  if (m_registered) {
+    SoundManager::current()->remove_from_update( this );
+  }
+
   m_file = std::move(newfile);
+  m_eof = false;
 
-  ALint queued;
-  alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
-  for (size_t i = 0; i < STREAMFRAGMENTS - queued; ++i) {
-    if (fillBufferAndQueue(m_buffers[i]) == false)
-      break;
-  }
+  //add me to update list, which also queues up the first fragments
+  SoundManager::current()->register_for_update( this );
+  m_registered = true;
 }
 
 void
-StreamSoundSource::update()
+StreamSoundSource::play()
 {
-  ALint processed = 0;
-  alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
-  for (ALint i = 0; i < processed; ++i) {
-    ALuint buffer;
-    alSourceUnqueueBuffers(m_source, 1, &buffer);
-    try
-    {
-      SoundManager::check_al_error("Couldn't unqueue audio buffer: ");
-    }
-    catch(std::exception& e)
-    {
-      log_warning << e.what() << std::endl;
-    }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_play_requested = true;
+  OpenALSoundSource::play();
+}
 
-    if (fillBufferAndQueue(buffer) == false)
-      break;
-  }
+void
+StreamSoundSource::stop()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_play_requested = false;
+  // unlike a rewind, stopping marks all queued buffers as processed,
+  // so refill() gets them back
+  alSourceStop(m_source);
+}
 
-  if (!playing()) {
-    if (processed == 0 || !m_looping)
-      return;
+bool
+StreamSoundSource::playing() const
+{
+  // the source itself might be waiting for its first fragments
+  return m_play_requested;
+}
 
-    // we might have to restart the source if we had a buffer underrun
+void
+StreamSoundSource::pause()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_play_requested = false;
+  OpenALSoundSource::pause();
+}
+
+void
+StreamSoundSource::update()
+{
+  const int underruns = m_underruns;
+  if (underruns != m_underruns_reported) {
     log_info << "Restarting audio source because of buffer underrun" << std::endl;
-    play();
+    m_underruns_reported = underruns;
+  }
+
+  std::string error;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::swap(error, m_error);
+  }
+  if (!error.empty()) {
+    log_warning << error << std::endl;
   }
 
   if (m_fade_state == FadingOn || m_fade_state == FadingResume) {
@@ -131,42 +168,107 @@ StreamSoundSource::set_fading(FadeState state, float fade_time_)
   m_fade_start_time = g_real_time;
 }
 
-bool
-StreamSoundSource::fillBufferAndQueue(ALuint buffer)
+void
+StreamSoundSource::refill()
 {
-  // fill buffer
-  std::unique_ptr<char[]> bufferdata(new char[STREAMFRAGMENTSIZE]);
-  size_t bytesread = 0;
-  do {
-    bytesread += m_file->read(bufferdata.get() + bytesread,
-                            STREAMFRAGMENTSIZE - bytesread);
-    // end of sound file
-    if (bytesread < STREAMFRAGMENTSIZE) {
-      if (m_looping)
-        m_file->reset();
-      else
-        break;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ALint processed = 0;
+    alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &processed);
+    for (ALint i = 0; i < processed; ++i) {
+      ALuint buffer;
+      alSourceUnqueueBuffers(m_source, 1, &buffer);
+      m_free_buffers.push_back(buffer);
     }
-  } while(bytesread < STREAMFRAGMENTSIZE);
 
-  if (bytesread > 0) {
-    ALenum format = SoundManager::get_sample_format(*m_file);
+    ALint state = AL_INITIAL;
+    alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+    if (!m_play_requested && state == AL_STOPPED) {
+      // stopped for good, no need to decode ahead
+      return;
+    }
+  }
+
+  while (!m_eof && !m_free_buffers.empty()) {
+    size_t bytesread = 0;
+    ALenum format = AL_NONE;
     try
     {
-      alBufferData(buffer, format, bufferdata.get(), static_cast<ALsizei>(bytesread), m_file->m_rate);
+      bytesread = decode_fragment();
+      format = SoundManager::get_sample_format(*m_file);
+    }
+    catch(std::exception& e)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_error = std::string("Couldn't decode audio stream: ") + e.what();
+      m_eof = true;
+      break;
+    }
+
+    if (bytesread == 0)
+      break;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const ALuint buffer = m_free_buffers.back();
+    try
+    {
+      alBufferData(buffer, format, m_fragment.get(), static_cast<ALsizei>(bytesread), m_file->m_rate);
       SoundManager::check_al_error("Couldn't refill audio buffer: ");
 
       alSourceQueueBuffers(m_source, 1, &buffer);
       SoundManager::check_al_error("Couldn't queue audio buffer: ");
+      m_free_buffers.pop_back();
     }
     catch(std::exception& e)
     {
-      log_warning << e.what() << std::endl;
+      m_error = e.what();
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  ALint state = AL_INITIAL;
+  alGetSourcei(m_source, AL_SOURCE_STATE, &state);
+  if (m_play_requested && state != AL_PLAYING) {
+    ALint queued = 0;
+    alGetSourcei(m_source, AL_BUFFERS_QUEUED, &queued);
+    if (queued > 0) {
+      // either play() came before the first fragments or we had a
+      // buffer underrun
+      if (m_was_playing && state == AL_STOPPED) {
+        ++m_underruns;
+      }
+      alSourcePlay(m_source);
+      state = AL_PLAYING;
+    } else if (m_eof) {
+      // played to the end
+      m_play_requested = false;
     }
   }
+  m_was_playing = (state == AL_PLAYING);
+}
+
+size_t
+StreamSoundSource::decode_fragment()
+{
+  size_t bytesread = 0;
+  do {
+    bytesread += m_file->read(m_fragment.get() + bytesread,
+                              STREAMFRAGMENTSIZE - bytesread);
+    // end of sound file
+    if (bytesread < STREAMFRAGMENTSIZE) {
+      if (m_looping) {
+        m_file->reset();
+      } else {
+        m_eof = true;
+        break;
+      }
+    }
+  } while(bytesread < STREAMFRAGMENTSIZE);
 
-  // return false if there aren't more buffers to fill
-  return bytesread >= STREAMFRAGMENTSIZE;
+  return bytesread;
 }
 
 /* EOF */
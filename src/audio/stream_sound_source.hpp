@@ -17,12 +17,22 @@
 #ifndef HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 #define HEADER_SUPERTUX_AUDIO_STREAM_SOUND_SOURCE_HPP
 
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "audio/openal_sound_source.hpp"
 
 class SoundFile;
 
+/** Plays a SoundFile that is too large to be decoded at once. Its
+    buffer queue is refilled by the AudioStreamer thread, everything
+    else happens on the game thread. */
 class StreamSoundSource final : public OpenALSoundSource
 {
+  friend class AudioStreamer;
+
 private:
   static const size_t STREAMBUFFERSIZE = 1024 * 500;
   static const size_t STREAMFRAGMENTS = 5;
@@ -35,6 +45,10 @@ public:
   StreamSoundSource();
   virtual ~StreamSoundSource();
 
+  virtual void play() override;
+  virtual void stop() override;
+  virtual bool playing() const override;
+  virtual void pause() override;
   virtual void update() override;
   virtual void set_looping(bool looping_) override { m_looping = looping_; }
 
@@ -45,16 +59,48 @@ public:
   bool get_looping() const { return m_looping; }
 
 private:
-  bool fillBufferAndQueue(ALuint buffer);
+  /** Called by the AudioStreamer thread to queue up freshly decoded
+      fragments and to restart the source after an underrun */
+  void refill();
+
+  /** Decodes the next fragment into m_fragment, returns its size */
+  size_t decode_fragment();
 
 private:
   std::unique_ptr<SoundFile> m_file;
   ALuint m_buffers[STREAMFRAGMENTS];
 
+  /** Buffers that aren't queued, only touched by the AudioStreamer */
+  std::vector<ALuint> m_free_buffers;
+
+  /** Allocated once, fragments get decoded into it before they are
+      handed to OpenAL */
+  std::unique_ptr<char[]> m_fragment;
+
+  /** Set when a non-looping file has been read to the end */
+  bool m_eof;
+
+  /** Whether the AudioStreamer refills this source */
+  bool m_registered;
+
+  /** Keeps play()/pause()/stop() from interleaving with the buffer
+      queue updates and restarts in refill() */
+  std::mutex m_mutex;
+
+  /** Set by play(), cleared by pause(), stop() or when the end of the
+      file has been played */
+  std::atomic<bool> m_play_requested;
+  bool m_was_playing;
+  std::atomic<bool> m_looping;
+
+  /** The AudioStreamer can't log, so update() reports for it */
+  std::atomic<int> m_underruns;
+  int m_underruns_reported;
+  std::string m_error;
+
   FadeState m_fade_state;
   float m_fade_start_time;
   float m_fade_time;
-  bool m_looping;
 
 private:
   StreamSoundSource(const StreamSoundSource&) = delete;
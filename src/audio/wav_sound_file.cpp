@@ -44,6 +44,53 @@ static inline uint16_t read16LE(PHYSFS_file* file)
   return result;
 }
 
+static inline void write32LE(std::ostream& out, uint32_t value)
+{
+  const char bytes[] = {
+    static_cast<char>(value & 0xff),
+    static_cast<char>((value >> 8) & 0xff),
+    static_cast<char>((value >> 16) & 0xff),
+    static_cast<char>((value >> 24) & 0xff)
+  };
+  out.write(bytes, sizeof(bytes));
+}
+
+static inline void write16LE(std::ostream& out, uint16_t value)
+{
+  const char bytes[] = {
+    static_cast<char>(value & 0xff),
+    static_cast<char>((value >> 8) & 0xff)
+  };
+  out.write(bytes, sizeof(bytes));
+}
+
+void
+WavSoundFile::write(std::ostream& out, const int16_t* samples, size_t frames,
+                    int channels, int rate)
+{
+  const uint16_t block_align = static_cast<uint16_t>(channels * 2);
+  const uint32_t data_size = static_cast<uint32_t>(frames * block_align);
+
+  out.write("RIFF", 4);
+  write32LE(out, 36 + data_size);
+  out.write("WAVE", 4);
+
+  out.write("fmt ", 4);
+  write32LE(out, 16);
+  write16LE(out, 1); // PCM
+  write16LE(out, static_cast<uint16_t>(channels));
+  write32LE(out, static_cast<uint32_t>(rate));
+  write32LE(out, static_cast<uint32_t>(rate) * block_align);
+  write16LE(out, block_align);
+  write16LE(out, 16);
+
+  out.write("data", 4);
+  write32LE(out, data_size);
+  for (size_t i = 0; i < frames * channels; ++i) {
+    write16LE(out, static_cast<uint16_t>(samples[i]));
+  }
+}
+
 WavSoundFile::WavSoundFile(PHYSFS_file* file_) :
   m_file(file_),
   m_datastart()
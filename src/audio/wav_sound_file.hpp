@@ -17,12 +17,20 @@
 #ifndef HEADER_SUPERTUX_AUDIO_WAV_SOUND_FILE_HPP
 #define HEADER_SUPERTUX_AUDIO_WAV_SOUND_FILE_HPP
 
+#include <ostream>
 #include <physfs.h>
+#include <stdint.h>
 
 #include "audio/sound_file.hpp"
 
 class WavSoundFile final : public SoundFile
 {
+public:
+  /** Writes frames of interleaved 16 bit samples to out as a
+      complete wav file */
+  static void write(std::ostream& out, const int16_t* samples, size_t frames,
+                    int channels, int rate);
+
 public:
   WavSoundFile(PHYSFS_file* file);
   ~WavSoundFile();
@@ -41,6 +41,20 @@ static const float BURN_TIME = 1;
 static const float X_OFFSCREEN_DISTANCE = 1280;
 static const float Y_OFFSCREEN_DISTANCE = 800;
 
+static const ActionHandle ACTION_GEAR_LEFT("gear-left");
+static const ActionHandle ACTION_GEAR_RIGHT("gear-right");
+static const ActionHandle ACTION_ICED_LEFT("iced-left");
+static const ActionHandle ACTION_ICED_RIGHT("iced-right");
+static const ActionHandle ACTION_GROUND_MELTING_LEFT("ground-melting-left");
+static const ActionHandle ACTION_GROUND_MELTING_RIGHT("ground-melting-right");
+static const ActionHandle ACTION_MELTING_LEFT("melting-left");
+static const ActionHandle ACTION_MELTING_RIGHT("melting-right");
+static const ActionHandle ACTION_BURNING_LEFT("burning-left");
+static const ActionHandle ACTION_BURNING_RIGHT("burning-right");
+static const ActionHandle ACTION_INSIDE_MELTING_LEFT("inside-melting-left");
+static const ActionHandle ACTION_INSIDE_MELTING_RIGHT("inside-melting-right");
+static const ActionHandle ACTION_ICED("iced");
+
 BadGuy::BadGuy(const Vector& pos, const std::string& sprite_name_, int layer_,
                const std::string& light_sprite_name) :
   BadGuy(pos, Direction::LEFT, sprite_name_, layer_, light_sprite_name)
@@ -228,7 +242,7 @@ BadGuy::update(float dt_sec)
       m_is_active_flag = false;
       m_col.m_movement = m_physic.get_movement(dt_sec);
       if ( on_ground() && m_sprite->animation_done() ) {
-        m_sprite->set_action(m_dir == Direction::LEFT ? "gear-left" : "gear-right", 1);
+        m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_GEAR_LEFT : ACTION_GEAR_RIGHT, 1);
         set_state(STATE_GEAR);
       }
       int pa = graphicsRandom.rand(0,3);
@@ -701,13 +715,13 @@ BadGuy::freeze()
   set_group(COLGROUP_MOVING_STATIC);
   m_frozen = true;
 
-  if (m_sprite->has_action("iced-left"))
-    m_sprite->set_action(m_dir == Direction::LEFT ? "iced-left" : "iced-right", 1);
+  if (m_sprite->has_action(ACTION_ICED_LEFT))
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_ICED_LEFT : ACTION_ICED_RIGHT, 1);
   // when the sprite doesn't have separate actions for left and right, it tries to use an universal one.
   else
   {
-    if (m_sprite->has_action("iced"))
-      m_sprite->set_action("iced", 1);
+    if (m_sprite->has_action(ACTION_ICED))
+      m_sprite->set_action(ACTION_ICED, 1);
       // when no iced action exists, default to shading badguy blue
     else
     {
@@ -724,7 +738,7 @@ BadGuy::unfreeze()
   m_frozen = false;
 
   // restore original color if needed
-  if ((!m_sprite->has_action("iced-left")) && (!m_sprite->has_action("iced")) )
+  if ((!m_sprite->has_action(ACTION_ICED_LEFT)) && (!m_sprite->has_action(ACTION_ICED)) )
   {
     m_sprite->set_color(Color(1.f, 1.f, 1.f));
     m_sprite->set_animation_loops();
@@ -763,32 +777,32 @@ BadGuy::ignite()
   m_sprite->stop_animation();
   m_ignited = true;
 
-  if (m_sprite->has_action("melting-left")) {
+  if (m_sprite->has_action(ACTION_MELTING_LEFT)) {
 
     // melt it!
-    if (m_sprite->has_action("ground-melting-left") && on_ground()) {
-      m_sprite->set_action(m_dir == Direction::LEFT ? "ground-melting-left" : "ground-melting-right", 1);
+    if (m_sprite->has_action(ACTION_GROUND_MELTING_LEFT) && on_ground()) {
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_GROUND_MELTING_LEFT : ACTION_GROUND_MELTING_RIGHT, 1);
       SoundManager::current()->play("sounds/splash.ogg", get_pos());
       set_state(STATE_GROUND_MELTING);
     } else {
-      m_sprite->set_action(m_dir == Direction::LEFT ? "melting-left" : "melting-right", 1);
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_MELTING_LEFT : ACTION_MELTING_RIGHT, 1);
       SoundManager::current()->play("sounds/sizzle.ogg", get_pos());
       set_state(STATE_MELTING);
     }
 
     run_dead_script();
 
-  } else if (m_sprite->has_action("burning-left")) {
+  } else if (m_sprite->has_action(ACTION_BURNING_LEFT)) {
     // burn it!
     m_glowing = true;
     SoundManager::current()->play("sounds/fire.ogg", get_pos());
-    m_sprite->set_action(m_dir == Direction::LEFT ? "burning-left" : "burning-right", 1);
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_BURNING_LEFT : ACTION_BURNING_RIGHT, 1);
     set_state(STATE_BURNING);
     run_dead_script();
-  } else if (m_sprite->has_action("inside-melting-left")) {
+  } else if (m_sprite->has_action(ACTION_INSIDE_MELTING_LEFT)) {
     // melt it inside!
     SoundManager::current()->play("sounds/splash.ogg", get_pos());
-    m_sprite->set_action(m_dir == Direction::LEFT ? "inside-melting-left" : "inside-melting-right", 1);
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_INSIDE_MELTING_LEFT : ACTION_INSIDE_MELTING_RIGHT, 1);
     set_state(STATE_INSIDE_MELTING);
     run_dead_script();
   } else {
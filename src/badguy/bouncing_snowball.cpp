@@ -23,6 +23,10 @@
 static const float JUMPSPEED = -450;
 static const float BSNOWBALL_WALKSPEED = 80;
 
+static const ActionHandle ACTION_LEFT("left");
+static const ActionHandle ACTION_RIGHT("right");
+static const ActionHandle ACTION_SQUISHED("squished");
+
 BouncingSnowball::BouncingSnowball(const ReaderMapping& reader)
   : BadGuy(reader, "images/creatures/bouncing_snowball/bouncing_snowball.sprite")
 {
@@ -32,13 +36,13 @@ void
 BouncingSnowball::initialize()
 {
   m_physic.set_velocity_x(m_dir == Direction::LEFT ? -BSNOWBALL_WALKSPEED : BSNOWBALL_WALKSPEED);
-  m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
 }
 
 bool
 BouncingSnowball::collision_squished(GameObject& object)
 {
-  m_sprite->set_action("squished");
+  m_sprite->set_action(ACTION_SQUISHED);
   kill_squished(object);
   return true;
 }
@@ -66,7 +70,7 @@ BouncingSnowball::collision_solid(const CollisionHit& hit)
   // The direction must correspond, else we got fake bounces on slopes.
   if ((hit.left && m_dir == Direction::LEFT) || (hit.right && m_dir == Direction::RIGHT)) {
     m_dir = m_dir == Direction::LEFT ? Direction::RIGHT : Direction::LEFT;
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
     m_physic.set_velocity_x(-m_physic.get_velocity_x());
   }
 
@@ -83,7 +87,7 @@ void
 BouncingSnowball::after_editor_set()
 {
   BadGuy::after_editor_set();
-  m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
 }
 
 /* EOF */
@@ -29,6 +29,11 @@ namespace {
 const float MUZZLE_Y = 25; /**< [px] muzzle y-offset from top */
 }
 
+static const ActionHandle ACTION_IDLE_LEFT("idle-left");
+static const ActionHandle ACTION_IDLE_RIGHT("idle-right");
+static const ActionHandle ACTION_LOADING_LEFT("loading-left");
+static const ActionHandle ACTION_LOADING_RIGHT("loading-right");
+
 DartTrap::DartTrap(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/darttrap/darttrap.sprite", LAYER_TILES-1),
   enabled(true),
@@ -56,7 +61,7 @@ DartTrap::DartTrap(const ReaderMapping& reader) :
 void
 DartTrap::initialize()
 {
-  m_sprite->set_action(m_dir == Direction::LEFT ? "idle-left" : "idle-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_IDLE_LEFT : ACTION_IDLE_RIGHT);
 }
 
 void
@@ -101,7 +106,7 @@ void
 DartTrap::load()
 {
   state = LOADING;
-  m_sprite->set_action(m_dir == Direction::LEFT ? "loading-left" : "loading-right", 1);
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LOADING_LEFT : ACTION_LOADING_RIGHT, 1);
 }
 
 void
@@ -115,7 +120,7 @@ DartTrap::fire()
   SoundManager::current()->play("sounds/dartfire.wav", get_pos());
   Sector::get().add<Dart>(Vector(px, py), m_dir, this);
   state = IDLE;
-  m_sprite->set_action(m_dir == Direction::LEFT ? "idle-left" : "idle-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_IDLE_LEFT : ACTION_IDLE_RIGHT);
 }
 
 ObjectSettings
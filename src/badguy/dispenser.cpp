@@ -26,6 +26,20 @@
 #include "supertux/sector.hpp"
 #include "util/reader_mapping.hpp"
 
+static const ActionHandle ACTION_WORKING_LEFT("working-left");
+static const ActionHandle ACTION_WORKING_RIGHT("working-right");
+static const ActionHandle ACTION_BROKEN_LEFT("broken-left");
+static const ActionHandle ACTION_BROKEN_RIGHT("broken-right");
+static const ActionHandle ACTION_SWIVEL_LEFT("swivel-left");
+static const ActionHandle ACTION_SWIVEL_RIGHT("swivel-right");
+static const ActionHandle ACTION_ICED_LEFT("iced-left");
+static const ActionHandle ACTION_ICED_RIGHT("iced-right");
+static const ActionHandle ACTION_DROPPER("dropper");
+static const ActionHandle ACTION_WORKING("working");
+static const ActionHandle ACTION_INVISIBLE("invisible");
+static const ActionHandle ACTION_ICED("iced");
+static const ActionHandle ACTION_DROPPER_ICED("dropper-iced");
+
 Dispenser::DispenserType
 Dispenser::DispenserType_from_string(const std::string& type_string)
 {
@@ -113,11 +127,11 @@ Dispenser::Dispenser(const ReaderMapping& reader) :
   switch (m_type)
   {
     case DispenserType::DROPPER:
-      m_sprite->set_action("dropper");
+      m_sprite->set_action(ACTION_DROPPER);
       break;
 
     case DispenserType::ROCKETLAUNCHER:
-      m_sprite->set_action(m_dir == Direction::LEFT ? "working-left" : "working-right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_WORKING_LEFT : ACTION_WORKING_RIGHT);
       set_colgroup_active(COLGROUP_MOVING); //if this were COLGROUP_MOVING_STATIC MrRocket would explode on launch.
 
       if (m_start_dir == Direction::AUTO) {
@@ -126,11 +140,11 @@ Dispenser::Dispenser(const ReaderMapping& reader) :
       break;
 
     case DispenserType::CANNON:
-      m_sprite->set_action("working");
+      m_sprite->set_action(ACTION_WORKING);
       break;
 
     case DispenserType::POINT:
-      m_sprite->set_action("invisible");
+      m_sprite->set_action(ACTION_INVISIBLE);
       set_colgroup_active(COLGROUP_DISABLED);
       break;
 
@@ -138,7 +152,7 @@ Dispenser::Dispenser(const ReaderMapping& reader) :
       break;
   }
 
-  m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
   m_countMe = false;
 }
 
@@ -160,7 +174,7 @@ Dispenser::activate()
     auto* player = get_nearest_player();
     if (player) {
       m_dir = (player->get_pos().x > get_pos().x) ? Direction::RIGHT : Direction::LEFT;
-      m_sprite->set_action(m_dir == Direction::LEFT ? "working-left" : "working-right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_WORKING_LEFT : ACTION_WORKING_RIGHT);
     }
   }
   m_dispense_timer.start(m_cycle, true);
@@ -187,7 +201,7 @@ Dispenser::collision_squished(GameObject& object)
     unfreeze();
   }
 
-  m_sprite->set_action(m_dir == Direction::LEFT ? "broken-left" : "broken-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_BROKEN_LEFT : ACTION_BROKEN_RIGHT);
   m_dispense_timer.start(0);
   set_colgroup_active(COLGROUP_MOVING_STATIC); // Tux can stand on broken cannon.
   auto player = dynamic_cast<Player*>(&object);
@@ -230,7 +244,7 @@ Dispenser::active_update(float )
     // auto always shoots in Tux's direction
     if (m_autotarget) {
       if ( m_sprite->animation_done()) {
-        m_sprite->set_action(m_dir == Direction::LEFT ? "working-left" : "working-right");
+        m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_WORKING_LEFT : ACTION_WORKING_RIGHT);
         m_swivel = false;
       }
 
@@ -240,7 +254,7 @@ Dispenser::active_update(float )
         if ( m_dir != targetdir ){ // no target: swivel cannon
           m_swivel = true;
           m_dir = targetdir;
-          m_sprite->set_action(m_dir == Direction::LEFT ? "swivel-left" : "swivel-right", 1);
+          m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SWIVEL_LEFT : ACTION_SWIVEL_RIGHT, 1);
         } else { // tux in sight: shoot
           launch_badguy();
         }
@@ -359,20 +373,20 @@ Dispenser::freeze()
   set_group(COLGROUP_MOVING_STATIC);
   m_frozen = true;
 
-    if (m_type == DispenserType::ROCKETLAUNCHER && m_sprite->has_action("iced-left"))
+    if (m_type == DispenserType::ROCKETLAUNCHER && m_sprite->has_action(ACTION_ICED_LEFT))
     // Only swivel dispensers can use their left/right iced actions.
-    m_sprite->set_action(m_dir == Direction::LEFT ? "iced-left" : "iced-right", 1);
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_ICED_LEFT : ACTION_ICED_RIGHT, 1);
     // when the sprite doesn't have separate actions for left and right or isn't a rocketlauncher,
     // it tries to use an universal one.
   else
   {
-    if (m_type == DispenserType::CANNON && m_sprite->has_action("iced"))
-      m_sprite->set_action("iced", 1);
+    if (m_type == DispenserType::CANNON && m_sprite->has_action(ACTION_ICED))
+      m_sprite->set_action(ACTION_ICED, 1);
       // When is the dispenser a cannon, it uses the "iced" action.
     else
     {
-      if (m_sprite->has_action("dropper-iced"))
-        m_sprite->set_action("dropper-iced", 1);
+      if (m_sprite->has_action(ACTION_DROPPER_ICED))
+        m_sprite->set_action(ACTION_DROPPER_ICED, 1);
         // When is the dispenser a dropper, it uses the "dropper-iced".
       else
       {
@@ -415,16 +429,16 @@ Dispenser::set_correct_action()
 {
   switch (m_type) {
     case DispenserType::DROPPER:
-      m_sprite->set_action("dropper");
+      m_sprite->set_action(ACTION_DROPPER);
       break;
     case DispenserType::ROCKETLAUNCHER:
-      m_sprite->set_action(m_dir == Direction::LEFT ? "working-left" : "working-right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_WORKING_LEFT : ACTION_WORKING_RIGHT);
       break;
     case DispenserType::CANNON:
-      m_sprite->set_action("working");
+      m_sprite->set_action(ACTION_WORKING);
       break;
     case DispenserType::POINT:
-      m_sprite->set_action("invisible");
+      m_sprite->set_action(ACTION_INVISIBLE);
       break;
     default:
       break;
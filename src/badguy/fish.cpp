@@ -22,6 +22,9 @@
 static const float FISH_JUMP_POWER = -600;
 static const float FISH_WAIT_TIME = 1;
 
+static const ActionHandle ACTION_NORMAL("normal");
+static const ActionHandle ACTION_DOWN("down");
+
 Fish::Fish(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/fish/fish.sprite", LAYER_TILES-1),
   waiting(),
@@ -94,7 +97,7 @@ Fish::active_update(float dt_sec)
 
   // set sprite
   if (!m_frozen)
-    m_sprite->set_action(m_physic.get_velocity_y() < 0 ? "normal" : "down");
+    m_sprite->set_action(m_physic.get_velocity_y() < 0 ? ACTION_NORMAL : ACTION_DOWN);
 
   // we can't afford flying out of the tilemap, 'cause the engine would remove us.
   if ((get_pos().y - 31.8f) < 0) // too high, let us fall
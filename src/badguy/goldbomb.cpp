@@ -27,6 +27,11 @@
 #include "supertux/sector.hpp"
 #include "util/reader_mapping.hpp"
 
+static const ActionHandle ACTION_TICKING_LEFT("ticking-left");
+static const ActionHandle ACTION_TICKING_RIGHT("ticking-right");
+static const ActionHandle ACTION_ICED_LEFT("iced-left");
+static const ActionHandle ACTION_ICED_RIGHT("iced-right");
+
 GoldBomb::GoldBomb(const ReaderMapping& reader) :
   WalkingBadguy(reader, "images/creatures/gold_bomb/gold_bomb.sprite", "left", "right"),
   tstate(STATE_NORMAL),
@@ -115,7 +120,7 @@ GoldBomb::collision_squished(GameObject& object)
   if (is_valid() && tstate == STATE_NORMAL) {
     tstate = STATE_TICKING;
     m_frozen = false;
-    set_action(m_dir == Direction::LEFT ? "ticking-left" : "ticking-right", 1);
+    set_action(m_dir == Direction::LEFT ? ACTION_TICKING_LEFT : ACTION_TICKING_RIGHT, 1);
     m_physic.set_velocity_x(0);
 
     if (player)
@@ -190,7 +195,7 @@ GoldBomb::grab(MovingObject& object, const Vector& pos, Direction dir_)
 
     // We actually face the opposite direction of Tux here to make the fuse more
     // visible instead of hiding it behind Tux
-    m_sprite->set_action_continued(m_dir == Direction::LEFT ? "ticking-right" : "ticking-left");
+    m_sprite->set_action_continued(m_dir == Direction::LEFT ? ACTION_TICKING_RIGHT : ACTION_TICKING_LEFT);
     set_colgroup_active(COLGROUP_DISABLED);
     grabbed = true;
     grabber = &object;
@@ -198,7 +203,7 @@ GoldBomb::grab(MovingObject& object, const Vector& pos, Direction dir_)
   else if (m_frozen){
     m_col.m_movement = pos - get_pos();
     m_dir = dir_;
-    m_sprite->set_action(dir_ == Direction::LEFT ? "iced-left" : "iced-right");
+    m_sprite->set_action(dir_ == Direction::LEFT ? ACTION_ICED_LEFT : ACTION_ICED_RIGHT);
     set_colgroup_active(COLGROUP_DISABLED);
     grabbed = true;
   }
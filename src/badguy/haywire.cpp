@@ -179,8 +179,8 @@ void
 Haywire::start_exploding()
 {
   set_action ((m_dir == Direction::LEFT) ? "ticking-left" : "ticking-right", /* loops = */ -1);
-  walk_left_action = "ticking-left";
-  walk_right_action = "ticking-right";
+  walk_left_action = ActionHandle("ticking-left");
+  walk_right_action = ActionHandle("ticking-right");
   set_walk_speed (EXPLODING_WALK_SPEED);
   time_until_explosion = TIME_EXPLOSION;
   is_exploding = true;
@@ -200,8 +200,8 @@ Haywire::start_exploding()
 void
 Haywire::stop_exploding()
 {
-  walk_left_action = "left";
-  walk_right_action = "right";
+  walk_left_action = ActionHandle("left");
+  walk_right_action = ActionHandle("right");
   set_walk_speed(NORMAL_WALK_SPEED);
   time_until_explosion = 0.0f;
   is_exploding = false;
@@ -25,12 +25,19 @@ static const float JUMPYSPEED=-600;
 static const float JUMPY_MID_TOLERANCE=4;
 static const float JUMPY_LOW_TOLERANCE=2;
 
+static const ActionHandle ACTION_LEFT_UP("left-up");
+static const ActionHandle ACTION_LEFT_MIDDLE("left-middle");
+static const ActionHandle ACTION_LEFT_DOWN("left-down");
+static const ActionHandle ACTION_RIGHT_UP("right-up");
+static const ActionHandle ACTION_RIGHT_MIDDLE("right-middle");
+static const ActionHandle ACTION_RIGHT_DOWN("right-down");
+
 Jumpy::Jumpy(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/snowjumpy/snowjumpy.sprite"),
   pos_groundhit(),
   groundhit_pos_set(false)
 {
-  m_sprite->set_action("left-middle");
+  m_sprite->set_action(ACTION_LEFT_MIDDLE);
   // TODO create a nice sound for this...
   //SoundManager::current()->preload("sounds/skid.wav");
 }
@@ -84,17 +91,17 @@ Jumpy::active_update(float dt_sec)
 
   if (!groundhit_pos_set)
   {
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left-middle" : "right-middle");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT_MIDDLE : ACTION_RIGHT_MIDDLE);
     return;
   }
 
   if ( get_pos().y < (pos_groundhit.y - JUMPY_MID_TOLERANCE ) )
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left-up" : "right-up");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT_UP : ACTION_RIGHT_UP);
   else if ( get_pos().y >= (pos_groundhit.y - JUMPY_MID_TOLERANCE) &&
             get_pos().y < (pos_groundhit.y - JUMPY_LOW_TOLERANCE) )
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left-middle" : "right-middle");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT_MIDDLE : ACTION_RIGHT_MIDDLE);
   else
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left-down" : "right-down");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT_DOWN : ACTION_RIGHT_DOWN);
 }
 
 void
@@ -24,13 +24,20 @@ namespace{
   static const float KAMIKAZE_SPEED = 200;
   static const float LEAFSHOT_SPEED = 400;
   const std::string SPLAT_SOUND = "sounds/splat.wav";
+
+  const ActionHandle ACTION_LEFT("left");
+  const ActionHandle ACTION_RIGHT("right");
+  const ActionHandle ACTION_SQUISHED_LEFT("squished-left");
+  const ActionHandle ACTION_SQUISHED_RIGHT("squished-right");
+  const ActionHandle ACTION_COLLISION_LEFT("collision-left");
+  const ActionHandle ACTION_COLLISION_RIGHT("collision-right");
 }
 
 KamikazeSnowball::KamikazeSnowball(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/snowball/kamikaze-snowball.sprite")
 {
   SoundManager::current()->preload(SPLAT_SOUND);
-  set_action (m_dir == Direction::LEFT ? "left" : "right", /* loops = */ -1);
+  set_action (m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT, /* loops = */ -1);
 }
 
 void
@@ -38,13 +45,13 @@ KamikazeSnowball::initialize()
 {
   m_physic.set_velocity_x(m_dir == Direction::LEFT ? -KAMIKAZE_SPEED : KAMIKAZE_SPEED);
   m_physic.enable_gravity(false);
-  m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
 }
 
 bool
 KamikazeSnowball::collision_squished(GameObject& object)
 {
-  m_sprite->set_action(m_dir == Direction::LEFT ? "squished-left" : "squished-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SQUISHED_LEFT : ACTION_SQUISHED_RIGHT);
   kill_squished(object);
   return true;
 }
@@ -63,7 +70,7 @@ KamikazeSnowball::collision_solid(const CollisionHit& hit)
 void
 KamikazeSnowball::kill_collision()
 {
-  m_sprite->set_action(m_dir == Direction::LEFT ? "collision-left" : "collision-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_COLLISION_LEFT : ACTION_COLLISION_RIGHT);
   SoundManager::current()->play(SPLAT_SOUND, get_pos());
   m_physic.set_velocity_x(0);
   m_physic.set_velocity_y(0);
@@ -96,7 +103,7 @@ LeafShot::initialize()
 {
   m_physic.set_velocity_x(m_dir == Direction::LEFT ? -LEAFSHOT_SPEED : LEAFSHOT_SPEED);
   m_physic.enable_gravity(false);
-  m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
 }
 
 bool
@@ -108,7 +115,7 @@ LeafShot::is_freezable() const
 bool
 LeafShot::collision_squished(GameObject& object)
 {
-  m_sprite->set_action(m_dir == Direction::LEFT ? "squished-left" : "squished-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SQUISHED_LEFT : ACTION_SQUISHED_RIGHT);
   // Spawn death particles
   spawn_explosion_sprites(3, "images/objects/particles/leafshot.sprite");
   kill_squished(object);
@@ -22,6 +22,15 @@
 static const float PLANT_SPEED = 80;
 static const float WAKE_TIME = .5;
 
+static const ActionHandle ACTION_SLEEPING_LEFT("sleeping-left");
+static const ActionHandle ACTION_SLEEPING_RIGHT("sleeping-right");
+static const ActionHandle ACTION_LEFT("left");
+static const ActionHandle ACTION_RIGHT("right");
+static const ActionHandle ACTION_WAKING_LEFT("waking-left");
+static const ActionHandle ACTION_WAKING_RIGHT("waking-right");
+static const ActionHandle ACTION_SLEEPING_BURNING_LEFT("sleeping-burning-left");
+static const ActionHandle ACTION_SLEEPING_BURNING_RIGHT("sleeping-burning-right");
+
 Plant::Plant(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/plant/plant.sprite"),
   timer(),
@@ -37,7 +46,7 @@ Plant::initialize()
 
   state = PLANT_SLEEPING;
   m_physic.set_velocity_x(0);
-  m_sprite->set_action(m_dir == Direction::LEFT ? "sleeping-left" : "sleeping-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SLEEPING_LEFT : ACTION_SLEEPING_RIGHT);
 }
 
 void
@@ -47,7 +56,7 @@ Plant::collision_solid(const CollisionHit& hit)
     m_physic.set_velocity_y(0);
   } else if (hit.left || hit.right) {
     m_dir = m_dir == Direction::LEFT ? Direction::RIGHT : Direction::LEFT;
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
     m_physic.set_velocity_x(-m_physic.get_velocity_x());
   }
 }
@@ -59,7 +68,7 @@ Plant::collision_badguy(BadGuy& , const CollisionHit& hit)
 
   if (hit.left || hit.right) {
     m_dir = m_dir == Direction::LEFT ? Direction::RIGHT : Direction::LEFT;
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
     m_physic.set_velocity_x(-m_physic.get_velocity_x());
   }
 
@@ -83,7 +92,7 @@ Plant::active_update(float dt_sec) {
 
       if (inReach_left && inReach_right && inReach_top && inReach_bottom) {
         // wake up
-        m_sprite->set_action(m_dir == Direction::LEFT ? "waking-left" : "waking-right");
+        m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_WAKING_LEFT : ACTION_WAKING_RIGHT);
         if (!timer.started()) timer.start(WAKE_TIME);
         state = PLANT_WAKING;
       }
@@ -93,7 +102,7 @@ Plant::active_update(float dt_sec) {
   if (state == PLANT_WAKING) {
     if (timer.check()) {
       // start walking
-      m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
       m_physic.set_velocity_x(m_dir == Direction::LEFT ? -PLANT_SPEED : PLANT_SPEED);
       state = PLANT_WALKING;
     }
@@ -105,8 +114,8 @@ void
 Plant::ignite()
 {
   BadGuy::ignite();
-  if (state == PLANT_SLEEPING && m_sprite->has_action("sleeping-burning-left")) {
-    m_sprite->set_action(m_dir == Direction::LEFT ? "sleeping-burning-left" : "sleeping-burning-right", 1);
+  if (state == PLANT_SLEEPING && m_sprite->has_action(ACTION_SLEEPING_BURNING_LEFT)) {
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SLEEPING_BURNING_LEFT : ACTION_SLEEPING_BURNING_RIGHT, 1);
   }
 }
 /* EOF */
@@ -28,6 +28,9 @@ const int MAX_SNAIL_SQUISHES = 10;
 const float SNAIL_KICK_SPEED_Y = -500; /**< y-velocity gained when kicked */
 }
 
+static const ActionHandle ACTION_FLAT_LEFT("flat-left");
+static const ActionHandle ACTION_FLAT_RIGHT("flat-right");
+
 Snail::Snail(const ReaderMapping& reader) :
   WalkingBadguy(reader, "images/creatures/snail/snail.sprite", "left", "right"),
   state(STATE_NORMAL),
@@ -61,7 +64,7 @@ void
 Snail::be_flat()
 {
   state = STATE_FLAT;
-  m_sprite->set_action(m_dir == Direction::LEFT ? "flat-left" : "flat-right", 1);
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_FLAT_LEFT : ACTION_FLAT_RIGHT, 1);
 
   m_physic.set_velocity_x(0);
   m_physic.set_velocity_y(0);
@@ -70,14 +73,14 @@ Snail::be_flat()
 void Snail::be_grabbed()
 {
   state = STATE_GRABBED;
-  m_sprite->set_action(m_dir == Direction::LEFT ? "flat-left" : "flat-right", 1);
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_FLAT_LEFT : ACTION_FLAT_RIGHT, 1);
 }
 
 void
 Snail::be_kicked()
 {
   state = STATE_KICKED_DELAY;
-  m_sprite->set_action(m_dir == Direction::LEFT ? "flat-left" : "flat-right", 1);
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_FLAT_LEFT : ACTION_FLAT_RIGHT, 1);
 
   m_physic.set_velocity_x(m_dir == Direction::LEFT ? -SNAIL_KICK_SPEED : SNAIL_KICK_SPEED);
   m_physic.set_velocity_y(0);
@@ -165,7 +168,7 @@ Snail::collision_solid(const CollisionHit& hit)
 
         if ( ( m_dir == Direction::LEFT && hit.left ) || ( m_dir == Direction::RIGHT && hit.right) ){
           m_dir = (m_dir == Direction::LEFT) ? Direction::RIGHT : Direction::LEFT;
-          m_sprite->set_action(m_dir == Direction::LEFT ? "flat-left" : "flat-right");
+          m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_FLAT_LEFT : ACTION_FLAT_RIGHT);
 
           m_physic.set_velocity_x(-m_physic.get_velocity_x());
         }
@@ -287,7 +290,7 @@ Snail::grab(MovingObject&, const Vector& pos, Direction dir_)
 {
   m_col.m_movement = pos - get_pos();
   m_dir = dir_;
-  set_action(dir_ == Direction::LEFT ? "flat-left" : "flat-right", /* loops = */ -1);
+  set_action(dir_ == Direction::LEFT ? ACTION_FLAT_LEFT : ACTION_FLAT_RIGHT, /* loops = */ -1);
   be_grabbed();
   set_colgroup_active(COLGROUP_DISABLED);
 }
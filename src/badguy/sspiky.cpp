@@ -19,6 +19,11 @@
 #include "object/player.hpp"
 #include "sprite/sprite.hpp"
 
+static const ActionHandle ACTION_SLEEPING_LEFT("sleeping-left");
+static const ActionHandle ACTION_SLEEPING_RIGHT("sleeping-right");
+static const ActionHandle ACTION_WAKING_LEFT("waking-left");
+static const ActionHandle ACTION_WAKING_RIGHT("waking-right");
+
 SSpiky::SSpiky(const ReaderMapping& reader) :
   WalkingBadguy(reader, "images/creatures/spiky/sleepingspiky.sprite", "left", "right"), state(SSPIKY_SLEEPING)
 {
@@ -31,7 +36,7 @@ SSpiky::initialize()
 {
   state = SSPIKY_SLEEPING;
   m_physic.set_velocity_x(0);
-  m_sprite->set_action(m_dir == Direction::LEFT ? "sleeping-left" : "sleeping-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SLEEPING_LEFT : ACTION_SLEEPING_RIGHT);
 }
 
 void
@@ -74,7 +79,7 @@ SSpiky::active_update(float dt_sec) {
 
       if (inReach_left && inReach_right && inReach_top && inReach_bottom) {
         // wake up
-        m_sprite->set_action(m_dir == Direction::LEFT ? "waking-left" : "waking-right", 1);
+        m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_WAKING_LEFT : ACTION_WAKING_RIGHT, 1);
         state = SSPIKY_WAKING;
       }
     }
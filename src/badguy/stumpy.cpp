@@ -57,7 +57,7 @@ Stumpy::initialize()
   switch (mystate) {
     case STATE_INVINCIBLE:
       m_sprite->set_action(m_dir == Direction::LEFT ? "dizzy-left" : "dizzy-right");
-      m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+      m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
       m_physic.set_velocity_x(0);
       break;
     case STATE_NORMAL:
@@ -27,6 +27,13 @@ const float TOAD_RECOVER_TIME = 0.5; /**< time to stand still before starting a
 static const std::string HOP_SOUND = "sounds/hop.ogg";
 }
 
+static const ActionHandle ACTION_JUMPING_LEFT("jumping-left");
+static const ActionHandle ACTION_JUMPING_RIGHT("jumping-right");
+static const ActionHandle ACTION_IDLE_LEFT("idle-left");
+static const ActionHandle ACTION_IDLE_RIGHT("idle-right");
+static const ActionHandle ACTION_SQUISHED_LEFT("squished-left");
+static const ActionHandle ACTION_SQUISHED_RIGHT("squished-right");
+
 Toad::Toad(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/toad/toad.sprite"),
   recover_timer(),
@@ -40,7 +47,7 @@ Toad::initialize()
 {
   // initial state is JUMPING, because we might start airborne
   state = JUMPING;
-  m_sprite->set_action(m_dir == Direction::LEFT ? "jumping-left" : "jumping-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_JUMPING_LEFT : ACTION_JUMPING_RIGHT);
 }
 
 void
@@ -50,12 +57,12 @@ Toad::set_state(ToadState newState)
     m_physic.set_velocity_x(0);
     m_physic.set_velocity_y(0);
     if (!m_frozen)
-      m_sprite->set_action(m_dir == Direction::LEFT ? "idle-left" : "idle-right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_IDLE_LEFT : ACTION_IDLE_RIGHT);
 
     recover_timer.start(TOAD_RECOVER_TIME);
   } else
     if (newState == JUMPING) {
-      m_sprite->set_action(m_dir == Direction::LEFT ? "jumping-left" : "jumping-right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_JUMPING_LEFT : ACTION_JUMPING_RIGHT);
       m_physic.set_velocity_x(m_dir == Direction::LEFT ? -HORIZONTAL_SPEED : HORIZONTAL_SPEED);
       m_physic.set_velocity_y(VERTICAL_SPEED);
       SoundManager::current()->play( HOP_SOUND, get_pos());
@@ -65,7 +72,7 @@ Toad::set_state(ToadState newState)
         // face player
         if (player && (player->get_bbox().get_right() < m_col.m_bbox.get_left()) && (m_dir == Direction::RIGHT)) m_dir = Direction::LEFT;
         if (player && (player->get_bbox().get_left() > m_col.m_bbox.get_right()) && (m_dir == Direction::LEFT)) m_dir = Direction::RIGHT;
-        m_sprite->set_action(m_dir == Direction::LEFT ? "idle-left" : "idle-right");
+        m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_IDLE_LEFT : ACTION_IDLE_RIGHT);
       }
 
   state = newState;
@@ -74,7 +81,7 @@ Toad::set_state(ToadState newState)
 bool
 Toad::collision_squished(GameObject& object)
 {
-  m_sprite->set_action(m_dir == Direction::LEFT ? "squished-left" : "squished-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SQUISHED_LEFT : ACTION_SQUISHED_RIGHT);
   kill_squished(object);
   return true;
 }
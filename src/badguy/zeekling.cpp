@@ -23,6 +23,13 @@
 #include "object/player.hpp"
 #include "sprite/sprite.hpp"
 
+static const ActionHandle ACTION_LEFT("left");
+static const ActionHandle ACTION_RIGHT("right");
+static const ActionHandle ACTION_SQUISHED_LEFT("squished-left");
+static const ActionHandle ACTION_SQUISHED_RIGHT("squished-right");
+static const ActionHandle ACTION_DIVING_LEFT("diving-left");
+static const ActionHandle ACTION_DIVING_RIGHT("diving-right");
+
 Zeekling::Zeekling(const ReaderMapping& reader) :
   BadGuy(reader, "images/creatures/zeekling/zeekling.sprite"),
   speed(gameRandom.randf(130.0f, 171.0f)),
@@ -39,13 +46,13 @@ void
 Zeekling::initialize()
 {
   m_physic.set_velocity_x(m_dir == Direction::LEFT ? -speed : speed);
-  m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
 }
 
 bool
 Zeekling::collision_squished(GameObject& object)
 {
-  m_sprite->set_action(m_dir == Direction::LEFT ? "squished-left" : "squished-right");
+  m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_SQUISHED_LEFT : ACTION_SQUISHED_RIGHT);
   kill_squished(object);
   return true;
 }
@@ -60,19 +67,19 @@ Zeekling::onBumpHorizontal()
   }
   if (state == FLYING) {
     m_dir = (m_dir == Direction::LEFT ? Direction::RIGHT : Direction::LEFT);
-    m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+    m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
     m_physic.set_velocity_x(m_dir == Direction::LEFT ? -speed : speed);
   } else
     if (state == DIVING) {
       m_dir = (m_dir == Direction::LEFT ? Direction::RIGHT : Direction::LEFT);
       state = FLYING;
-      m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
       m_physic.set_velocity_x(m_dir == Direction::LEFT ? -speed : speed);
       m_physic.set_velocity_y(0);
     } else
       if (state == CLIMBING) {
         m_dir = (m_dir == Direction::LEFT ? Direction::RIGHT : Direction::LEFT);
-        m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+        m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
         m_physic.set_velocity_x(m_dir == Direction::LEFT ? -speed : speed);
       } else {
         assert(false);
@@ -94,7 +101,7 @@ Zeekling::onBumpVertical()
     if (state == DIVING) {
       state = CLIMBING;
       m_physic.set_velocity_y(-speed);
-      m_sprite->set_action(m_dir == Direction::LEFT ? "left" : "right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_LEFT : ACTION_RIGHT);
     } else
       if (state == CLIMBING) {
         state = FLYING;
@@ -177,7 +184,7 @@ Zeekling::active_update(float dt_sec) {
     if (should_we_dive()) {
       state = DIVING;
       m_physic.set_velocity_y(2*fabsf(m_physic.get_velocity_x()));
-      m_sprite->set_action(m_dir == Direction::LEFT ? "diving-left" : "diving-right");
+      m_sprite->set_action(m_dir == Direction::LEFT ? ACTION_DIVING_LEFT : ACTION_DIVING_RIGHT);
     }
     BadGuy::active_update(dt_sec);
     return;
@@ -45,18 +45,11 @@ inline void makePlane(const Vector& p1, const Vector& p2, Vector& n, float& c)
   c /= nval;
 }
 
-}
-
-bool rectangle_aatriangle(Constraints* constraints, const Rectf& rect,
-                          const AATriangle& triangle, const Vector& addl_ground_movement)
+/** Calculates the part of the triangle's bbox that is deformed and
+    the plane along the slope, points p inside the triangle satisfy
+    normal * p + c <= 0 */
+void get_aatriangle_plane(const AATriangle& triangle, Rectf& area, Vector& normal, float& c)
 {
-  if (!intersects(rect, triangle.bbox))
-    return false;
-
-  Vector normal;
-  float c = 0.0;
-  Vector p1;
-  Rectf area;
   switch (triangle.dir & AATriangle::DEFORM_MASK) {
     case 0:
       area.set_p1(triangle.bbox.p1());
@@ -84,26 +77,54 @@ bool rectangle_aatriangle(Constraints* constraints, const Rectf& rect,
 
   switch (triangle.dir & AATriangle::DIRECTION_MASK) {
     case AATriangle::SOUTHWEST:
-      p1 = Vector(rect.get_left(), rect.get_bottom());
       makePlane(area.p1(), area.p2(), normal, c);
       break;
     case AATriangle::NORTHEAST:
-      p1 = Vector(rect.get_right(), rect.get_top());
       makePlane(area.p2(), area.p1(), normal, c);
       break;
     case AATriangle::SOUTHEAST:
-      p1 = rect.p2();
       makePlane(Vector(area.get_left(), area.get_bottom()),
                 Vector(area.get_right(), area.get_top()), normal, c);
       break;
     case AATriangle::NORTHWEST:
-      p1 = rect.p1();
       makePlane(Vector(area.get_right(), area.get_top()),
                 Vector(area.get_left(), area.get_bottom()), normal, c);
       break;
     default:
       assert(false);
   }
+}
+
+}
+
+bool rectangle_aatriangle(Constraints* constraints, const Rectf& rect,
+                          const AATriangle& triangle, const Vector& addl_ground_movement)
+{
+  if (!intersects(rect, triangle.bbox))
+    return false;
+
+  Vector normal;
+  float c = 0.0;
+  Vector p1;
+  Rectf area;
+  get_aatriangle_plane(triangle, area, normal, c);
+
+  switch (triangle.dir & AATriangle::DIRECTION_MASK) {
+    case AATriangle::SOUTHWEST:
+      p1 = Vector(rect.get_left(), rect.get_bottom());
+      break;
+    case AATriangle::NORTHEAST:
+      p1 = Vector(rect.get_right(), rect.get_top());
+      break;
+    case AATriangle::SOUTHEAST:
+      p1 = rect.p2();
+      break;
+    case AATriangle::NORTHWEST:
+      p1 = rect.p1();
+      break;
+    default:
+      assert(false);
+  }
 
   float n_p1 = -(normal * p1);
   float depth = n_p1 - c;
@@ -224,6 +245,54 @@ bool intersects_line(const Rectf& r, const Vector& line_start, const Vector& lin
   return false;
 }
 
+bool clip_line(const Rectf& r, const Vector& line_start, const Vector& line_end,
+               float& t_enter, float& t_exit)
+{
+  // Liang-Barsky, clip the parameter range against each of the four sides
+  const Vector d = line_end - line_start;
+  const float p[4] = { -d.x, d.x, -d.y, d.y };
+  const float q[4] = { line_start.x - r.get_left(), r.get_right() - line_start.x,
+                       line_start.y - r.get_top(), r.get_bottom() - line_start.y };
+
+  t_enter = 0.0f;
+  t_exit = 1.0f;
+  for (int i = 0; i < 4; ++i) {
+    if (p[i] == 0.0f) {
+      if (q[i] < 0.0f)
+        return false;
+    } else {
+      const float t = q[i] / p[i];
+      if (p[i] < 0.0f) {
+        t_enter = std::max(t_enter, t);
+      } else {
+        t_exit = std::min(t_exit, t);
+      }
+    }
+  }
+
+  return t_enter <= t_exit;
+}
+
+bool intersects_line(const AATriangle& triangle, const Vector& line_start, const Vector& line_end)
+{
+  float t_enter;
+  float t_exit;
+  if (!clip_line(triangle.bbox, line_start, line_end, t_enter, t_exit))
+    return false;
+
+  Rectf area;
+  Vector normal;
+  float c = 0.0f;
+  get_aatriangle_plane(triangle, area, normal, c);
+
+  // the solid part of the tile is the bbox cut by the slope plane, the
+  // clipped line hits it if one of its ends is on the solid side
+  const Vector d = line_end - line_start;
+  const Vector p1 = line_start + d * t_enter;
+  const Vector p2 = line_start + d * t_exit;
+  return (normal * p1 + c <= 0.0f || normal * p2 + c <= 0.0f);
+}
+
 }
 
 /* EOF */
@@ -135,6 +135,16 @@ void set_rectangle_rectangle_constraints(Constraints* constraints,
 bool line_intersects_line(const Vector& line1_start, const Vector& line1_end, const Vector& line2_start, const Vector& line2_end);
 bool intersects_line(const Rectf& r, const Vector& line_start, const Vector& line_end);
 
+/** Clips the line against rectangle r. Returns false if they don't
+    touch, otherwise t_enter and t_exit are set to the part of the
+    line inside r, as fractions of the way from line_start to
+    line_end. */
+bool clip_line(const Rectf& r, const Vector& line_start, const Vector& line_end,
+               float& t_enter, float& t_exit);
+
+/** checks if the line touches the solid part of a slope tile */
+bool intersects_line(const AATriangle& triangle, const Vector& line_start, const Vector& line_end);
+
 } // namespace collision
 
 #endif
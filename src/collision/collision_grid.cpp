@@ -0,0 +1,194 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/collision_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "math/rectf.hpp"
+
+namespace {
+
+/** Size of a grid cell in pixel, four tiles */
+const float CELL_SIZE = 128.0f;
+
+/** Objects or queries covering more cells than this bypass the grid */
+const int MAX_CELLS = 64;
+
+/** Cell coordinates are clamped to this, far away objects share the
+    border cells */
+const int MAX_CELL_COORD = 1 << 20;
+
+int to_cell(float v)
+{
+  const float cell = std::floor(v / CELL_SIZE);
+  if (cell < static_cast<float>(-MAX_CELL_COORD)) {
+    return -MAX_CELL_COORD;
+  } else if (cell > static_cast<float>(MAX_CELL_COORD)) {
+    return MAX_CELL_COORD;
+  } else {
+    return static_cast<int>(cell);
+  }
+}
+
+uint64_t cell_key(int x, int y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+bool is_finite(const Rectf& rect)
+{
+  return (std::isfinite(rect.get_left()) && std::isfinite(rect.get_right()) &&
+          std::isfinite(rect.get_top()) && std::isfinite(rect.get_bottom()));
+}
+
+bool compare_seq(const CollisionObject* lhs, const CollisionObject* rhs)
+{
+  return lhs->get_seq() < rhs->get_seq();
+}
+
+} // namespace
+
+CollisionGrid::CollisionGrid() :
+  m_cells(),
+  m_object_cells(),
+  m_oversized(),
+  m_revision(0)
+{
+}
+
+void
+CollisionGrid::clear()
+{
+  m_cells.clear();
+  m_object_cells.clear();
+  m_oversized.clear();
+  m_revision += 1;
+}
+
+Rect
+CollisionGrid::get_cells(const Rectf& rect) const
+{
+  if (!is_finite(rect))
+    return Rect();
+
+  // use min/max so that inverted rectangles are handled like
+  // collision::intersects() does
+  const Rect cells(to_cell(std::min(rect.get_left(), rect.get_right())),
+                   to_cell(std::min(rect.get_top(), rect.get_bottom())),
+                   to_cell(std::max(rect.get_left(), rect.get_right())) + 1,
+                   to_cell(std::max(rect.get_top(), rect.get_bottom())) + 1);
+
+  if ((cells.right - cells.left) * (cells.bottom - cells.top) > MAX_CELLS)
+    return Rect();
+
+  return cells;
+}
+
+void
+CollisionGrid::update(CollisionObject& object, const Rectf& rect)
+{
+  const Rect cells = get_cells(rect);
+
+  auto it = m_object_cells.find(&object);
+  if (it != m_object_cells.end())
+  {
+    if (it->second == cells)
+      return;
+
+    remove(object);
+  }
+
+  m_object_cells[&object] = cells;
+  m_revision += 1;
+
+  if (cells.left == cells.right)
+  {
+    m_oversized.push_back(&object);
+  }
+  else
+  {
+    for (int y = cells.top; y < cells.bottom; ++y) {
+      for (int x = cells.left; x < cells.right; ++x) {
+        m_cells[cell_key(x, y)].push_back(&object);
+      }
+    }
+  }
+}
+
+void
+CollisionGrid::remove(CollisionObject& object)
+{
+  auto it = m_object_cells.find(&object);
+  if (it == m_object_cells.end())
+    return;
+
+  const Rect cells = it->second;
+  m_object_cells.erase(it);
+  m_revision += 1;
+
+  if (cells.left == cells.right)
+  {
+    m_oversized.erase(std::find(m_oversized.begin(), m_oversized.end(), &object));
+  }
+  else
+  {
+    for (int y = cells.top; y < cells.bottom; ++y) {
+      for (int x = cells.left; x < cells.right; ++x) {
+        auto cell = m_cells.find(cell_key(x, y));
+        auto& objects = cell->second;
+        objects.erase(std::find(objects.begin(), objects.end(), &object));
+        if (objects.empty()) {
+          m_cells.erase(cell);
+        }
+      }
+    }
+  }
+}
+
+void
+CollisionGrid::query(const Rectf& rect, std::vector<CollisionObject*>& result) const
+{
+  result.clear();
+
+  const Rect cells = get_cells(rect);
+  if (cells.left == cells.right)
+  {
+    // query too large for the grid, return everything
+    result.reserve(m_object_cells.size());
+    for (const auto& it : m_object_cells) {
+      result.push_back(const_cast<CollisionObject*>(it.first));
+    }
+  }
+  else
+  {
+    result = m_oversized;
+    for (int y = cells.top; y < cells.bottom; ++y) {
+      for (int x = cells.left; x < cells.right; ++x) {
+        auto cell = m_cells.find(cell_key(x, y));
+        if (cell != m_cells.end()) {
+          result.insert(result.end(), cell->second.begin(), cell->second.end());
+        }
+      }
+    }
+  }
+
+  std::sort(result.begin(), result.end(), compare_seq);
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+/* EOF */
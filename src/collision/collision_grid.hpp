@@ -0,0 +1,112 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_COLLISION_COLLISION_GRID_HPP
+#define HEADER_SUPERTUX_COLLISION_COLLISION_GRID_HPP
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "collision/collision_object.hpp"
+#include "math/rect.hpp"
+
+class Rectf;
+
+/** Uniform grid broadphase used by the CollisionSystem. Objects are
+    filed under every cell their rectangle overlaps, area queries then
+    only have to look at the objects in the cells they touch instead
+    of every object in the sector. The grid is conservative: it
+    returns candidates, the exact test is left to the caller. */
+class CollisionGrid final
+{
+public:
+  CollisionGrid();
+
+  /** Remove all objects from the grid */
+  void clear();
+
+  /** Files the object under the cells overlapped by rect, moving it
+      if it has been inserted before */
+  void update(CollisionObject& object, const Rectf& rect);
+
+  void remove(CollisionObject& object);
+
+  /** Fills result with all objects that might overlap rect, without
+      duplicates and in the order they were added to the
+      CollisionSystem */
+  void query(const Rectf& rect, std::vector<CollisionObject*>& result) const;
+
+  /** Calls func for all objects that might overlap rect, in the order
+      they were added to the CollisionSystem, skipping objects added
+      before or at sequence number first. If the grid changes while
+      iterating, e.g. because a collision response moved an object,
+      the remaining candidates are looked up again with the current
+      value of rect. */
+  template<typename F>
+  void for_each(const Rectf& rect, F func, uint64_t first = 0) const
+  {
+    std::vector<CollisionObject*> candidates;
+    uint64_t last = first;
+    uint32_t revision = m_revision;
+
+    query(rect, candidates);
+    size_t i = 0;
+    while (i < candidates.size())
+    {
+      CollisionObject& object = *candidates[i];
+      ++i;
+
+      if (object.get_seq() <= last)
+        continue;
+      last = object.get_seq();
+
+      func(object);
+
+      if (m_revision != revision)
+      {
+        revision = m_revision;
+        query(rect, candidates);
+        i = 0;
+      }
+    }
+  }
+
+private:
+  Rect get_cells(const Rectf& rect) const;
+
+private:
+  std::unordered_map<uint64_t, std::vector<CollisionObject*> > m_cells;
+
+  /** Cell range each object is filed under, an empty range marks
+      objects in m_oversized */
+  std::unordered_map<const CollisionObject*, Rect> m_object_cells;
+
+  /** Objects that are too large or not finite, these are returned by
+      every query */
+  std::vector<CollisionObject*> m_oversized;
+
+  /** Incremented whenever an object changes cells */
+  uint32_t m_revision;
+
+private:
+  CollisionGrid(const CollisionGrid&) = delete;
+  CollisionGrid& operator=(const CollisionGrid&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -18,6 +18,7 @@
 #include "collision/collision_object.hpp"
 
 #include "collision/collision_listener.hpp"
+#include "collision/collision_system.hpp"
 #include "supertux/game_object.hpp"
 
 CollisionObject::CollisionObject(CollisionGroup group, CollisionListener& listener) :
@@ -25,10 +26,55 @@ CollisionObject::CollisionObject(CollisionGroup group, CollisionListener& listen
   m_bbox(),
   m_movement(),
   m_group(group),
-  m_dest()
+  m_dest(),
+  m_system(nullptr),
+  m_seq(0),
+  m_bucket(-1)
 {
 }
 
+void
+CollisionObject::set_pos(const Vector& pos)
+{
+  m_dest.move(pos - get_pos());
+  m_bbox.set_pos(pos);
+
+  if (m_system)
+    m_system->object_moved(*this);
+}
+
+void
+CollisionObject::set_width(float w)
+{
+  m_dest.set_width(w);
+  m_bbox.set_width(w);
+
+  if (m_system)
+    m_system->object_moved(*this);
+}
+
+void
+CollisionObject::set_size(float w, float h)
+{
+  m_dest.set_size(w, h);
+  m_bbox.set_size(w, h);
+
+  if (m_system)
+    m_system->object_moved(*this);
+}
+
+void
+CollisionObject::set_group(CollisionGroup group)
+{
+  if (m_group == group)
+    return;
+
+  m_group = group;
+
+  if (m_system)
+    m_system->object_regrouped(*this);
+}
+
 void
 CollisionObject::collision_solid(const CollisionHit& hit)
 {
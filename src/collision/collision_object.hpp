@@ -25,6 +25,7 @@
 #include "math/rectf.hpp"
 
 class CollisionListener;
+class CollisionSystem;
 class GameObject;
 
 class CollisionObject
@@ -62,11 +63,7 @@ public:
   /** places the moving object at a specific position. Be careful when
       using this function. There are no collision detection checks
       performed here so bad things could happen. */
-  void set_pos(const Vector& pos)
-  {
-    m_dest.move(pos - get_pos());
-    m_bbox.set_pos(pos);
-  }
+  void set_pos(const Vector& pos);
 
   Vector get_pos() const
   {
@@ -84,28 +81,26 @@ public:
   /** sets the moving object's bbox to a specific width. Be careful
       when using this function. There are no collision detection
       checks performed here so bad things could happen. */
-  void set_width(float w)
-  {
-    m_dest.set_width(w);
-    m_bbox.set_width(w);
-  }
+  void set_width(float w);
 
   /** sets the moving object's bbox to a specific size. Be careful
       when using this function. There are no collision detection
       checks performed here so bad things could happen. */
-  void set_size(float w, float h)
-  {
-    m_dest.set_size(w, h);
-    m_bbox.set_size(w, h);
-  }
+  void set_size(float w, float h);
 
   CollisionGroup get_group() const
   {
     return m_group;
   }
 
+  void set_group(CollisionGroup group);
+
   bool is_valid() const;
 
+  /** Sequence number given when the object was added to the
+      CollisionSystem, collisions are handled in this order */
+  uint64_t get_seq() const { return m_seq; }
+
   CollisionListener& get_listener()
   {
     return m_listener;
@@ -122,10 +117,10 @@ public:
   /** The movement that will happen till next frame */
   Vector m_movement;
 
+private:
   /** The collision group */
   CollisionGroup m_group;
 
-private:
   /** this is only here for internal collision detection use (don't touch this
       from outside collision detection code)
 
@@ -133,6 +128,16 @@ private:
       during collision detection */
   Rectf m_dest;
 
+  /** The CollisionSystem the object is part of, notified when the
+      object is moved outside of the collision detection */
+  CollisionSystem* m_system;
+
+  uint64_t m_seq;
+
+  /** The group bucket the object is filed under in the
+      CollisionSystem, -1 while a group change is pending */
+  int m_bucket;
+
 private:
   CollisionObject(const CollisionObject&) = delete;
   CollisionObject& operator=(const CollisionObject&) = delete;
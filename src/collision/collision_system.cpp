@@ -17,10 +17,16 @@
 
 #include "collision/collision_system.hpp"
 
+#include <algorithm>
+#include <assert.h>
+#include <limits>
+
 #include "collision/collision.hpp"
+#include "collision/tile_collision_layer.hpp"
 #include "editor/editor.hpp"
 #include "math/aatriangle.hpp"
 #include "math/rect.hpp"
+#include "math/util.hpp"
 #include "object/player.hpp"
 #include "object/tilemap.hpp"
 #include "supertux/constants.hpp"
@@ -40,22 +46,213 @@ const float DELTA = .002f;
 
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
-  m_objects()
+  m_buckets(),
+  m_regrouped(),
+  m_bbox_grid(),
+  m_dest_grid(),
+  m_dest_grid_valid(false),
+  m_next_seq(0),
+  m_tile_layers(),
+  m_merged_tilemaps(),
+  m_tile_layers_valid(false),
+  m_tile_layers_revision(0)
+{
+}
+
+CollisionSystem::~CollisionSystem()
+{
+}
+
+void
+CollisionSystem::rebuild_tile_layers() const
+{
+  m_tile_layers.clear();
+  m_merged_tilemaps.clear();
+
+  for (const auto& tilemap : m_sector.get_solid_tilemaps())
+  {
+    auto layer = std::find_if(m_tile_layers.begin(), m_tile_layers.end(),
+                              [tilemap](const std::unique_ptr<TileCollisionLayer>& candidate) {
+                                return candidate->can_merge(*tilemap);
+                              });
+    if (layer != m_tile_layers.end()) {
+      (*layer)->merge(*tilemap);
+    } else {
+      m_tile_layers.push_back(std::make_unique<TileCollisionLayer>(*tilemap));
+    }
+  }
+
+  for (const auto& layer : m_tile_layers)
+  {
+    if (layer->is_merged()) {
+      for (const auto& tilemap : layer->get_tilemaps()) {
+        m_merged_tilemaps[tilemap] = layer.get();
+      }
+    }
+  }
+
+  // only merged tilemaps have a copy of their cells that needs to be
+  // kept up to date, the others are read directly
+  for (const auto& tilemap : m_sector.get_solid_tilemaps())
+  {
+    if (m_merged_tilemaps.count(tilemap)) {
+      tilemap->set_collision_system(const_cast<CollisionSystem*>(this));
+    } else {
+      tilemap->set_collision_system(nullptr);
+    }
+  }
+
+  m_tile_layers_valid = true;
+  m_tile_layers_revision = m_sector.get_solid_tilemaps_revision();
+}
+
+const std::vector<std::unique_ptr<TileCollisionLayer> >&
+CollisionSystem::get_tile_layers() const
+{
+  if (!m_tile_layers_valid ||
+      m_tile_layers_revision != m_sector.get_solid_tilemaps_revision())
+  {
+    rebuild_tile_layers();
+  }
+
+  return m_tile_layers;
+}
+
+void
+CollisionSystem::tilemap_changed(TileMap&)
+{
+  m_tile_layers_valid = false;
+}
+
+void
+CollisionSystem::tile_changed(TileMap& tilemap, int x, int y)
 {
+  if (!m_tile_layers_valid)
+    return;
+
+  auto it = m_merged_tilemaps.find(&tilemap);
+  if (it != m_merged_tilemaps.end() && !it->second->update_cell(x, y)) {
+    m_tile_layers_valid = false;
+  }
 }
 
 void
 CollisionSystem::add(CollisionObject* object)
 {
-  m_objects.push_back(object);
+  object->m_system = this;
+  object->m_seq = ++m_next_seq;
+  add_to_bucket(*object);
+  m_bbox_grid.update(*object, object->m_bbox);
 }
 
 void
 CollisionSystem::remove(CollisionObject* object)
 {
-  m_objects.erase(
-    std::find(m_objects.begin(), m_objects.end(),
-              object));
+  m_bbox_grid.remove(*object);
+  m_dest_grid.remove(*object);
+  object->m_system = nullptr;
+
+  if (object->m_bucket < 0) {
+    m_regrouped.erase(std::find(m_regrouped.begin(), m_regrouped.end(), object));
+  } else {
+    remove_from_bucket(*object);
+  }
+}
+
+void
+CollisionSystem::object_moved(CollisionObject& object)
+{
+  m_bbox_grid.update(object, object.m_bbox);
+  if (m_dest_grid_valid) {
+    m_dest_grid.update(object, object.m_dest);
+  }
+}
+
+void
+CollisionSystem::object_regrouped(CollisionObject& object)
+{
+  if (object.m_bucket < 0)
+    return;
+
+  remove_from_bucket(object);
+  m_regrouped.push_back(&object);
+}
+
+void
+CollisionSystem::add_to_bucket(CollisionObject& object)
+{
+  auto& entries = m_buckets[object.m_group].entries;
+  const BucketEntry entry = { object.m_seq, &object };
+
+  // new objects have the highest sequence number and go to the end,
+  // only regrouped objects need to be sorted in
+  auto it = std::upper_bound(entries.begin(), entries.end(), entry,
+                             [](const BucketEntry& lhs, const BucketEntry& rhs) {
+                               return lhs.seq < rhs.seq;
+                             });
+  entries.insert(it, entry);
+
+  object.m_bucket = object.m_group;
+}
+
+void
+CollisionSystem::remove_from_bucket(CollisionObject& object)
+{
+  auto& bucket = m_buckets[object.m_bucket];
+  const BucketEntry entry = { object.m_seq, &object };
+
+  auto it = std::lower_bound(bucket.entries.begin(), bucket.entries.end(), entry,
+                             [](const BucketEntry& lhs, const BucketEntry& rhs) {
+                               return lhs.seq < rhs.seq;
+                             });
+  assert(it != bucket.entries.end() && it->object == &object);
+
+  // leave a hole, so that loops over the bucket stay valid
+  it->object = nullptr;
+  bucket.holes += 1;
+
+  object.m_bucket = -1;
+}
+
+void
+CollisionSystem::sync_buckets()
+{
+  for (auto& bucket : m_buckets) {
+    if (bucket.holes > 0) {
+      bucket.entries.erase(std::remove_if(bucket.entries.begin(), bucket.entries.end(),
+                                          [](const BucketEntry& entry) {
+                                            return entry.object == nullptr;
+                                          }),
+                           bucket.entries.end());
+      bucket.holes = 0;
+    }
+  }
+
+  for (const auto& object : m_regrouped) {
+    add_to_bucket(*object);
+  }
+  m_regrouped.clear();
+}
+
+void
+CollisionSystem::gather(std::vector<CollisionObject*>& result,
+                        std::initializer_list<CollisionGroup> groups) const
+{
+  result.clear();
+  for (const auto& group : groups) {
+    for (const auto& entry : m_buckets[group].entries) {
+      if (entry.object) {
+        result.push_back(entry.object);
+      }
+    }
+  }
+
+  if (groups.size() > 1) {
+    std::sort(result.begin(), result.end(),
+              [](const CollisionObject* lhs, const CollisionObject* rhs) {
+                return lhs->get_seq() < rhs->get_seq();
+              });
+  }
 }
 
 void
@@ -63,11 +260,11 @@ CollisionSystem::draw(DrawingContext& context)
 {
   const Color color(1.0f, 0.0f, 0.0f, 0.75f);
 
-  for (auto& object : m_objects) {
-    const Rectf& rect = object->get_bbox();
+  for_each_object([&context, &color](const CollisionObject& object) {
+    const Rectf& rect = object.get_bbox();
 
     context.color().draw_filled_rect(rect, color, LAYER_FOREGROUND1 + 10);
-  }
+  });
 }
 
 namespace {
@@ -158,37 +355,43 @@ CollisionSystem::collision_tilemap(collision::Constraints* constraints,
   const float y1 = dest.get_top();
   const float y2 = dest.get_bottom();
 
-  for (const auto& solids : m_sector.get_solid_tilemaps())
+  for (const auto& layer : get_tile_layers())
   {
+    const TileMap* solids = &layer->get_tilemap();
+
     // test with all tiles in this rectangle
     const Rect test_tiles = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2));
 
     for (int x = test_tiles.left; x < test_tiles.right; ++x)
     {
-      for (int y = test_tiles.top; y < test_tiles.bottom; ++y)
+      // skip the empty parts of the column
+      const auto& span = layer->get_collision_span(x);
+      const int y_end = std::min(test_tiles.bottom, span.second);
+
+      for (int y = std::max(test_tiles.top, span.first); y < y_end; ++y)
       {
-        const Tile& tile = solids->get_tile(x, y);
+        const TileMap::CollisionCell& cell = layer->get_collision_cell(x, y);
 
         // skip non-solid tiles
-        if (!tile.is_solid ())
+        if (!(cell.attributes & Tile::SOLID))
           continue;
         Rectf tile_bbox = solids->get_tile_bbox(x, y);
 
-        /* If the tile is a unisolid tile, the "is_solid()" function above
+        /* If the tile is a unisolid tile, the SOLID check above
          * didn't do a thorough check. Calculate the position and (relative)
          * movement of the object and determine whether or not the tile is
          * solid with regard to those parameters. */
-        if (tile.is_unisolid ()) {
+        if (cell.attributes & Tile::UNISOLID) {
           Vector relative_movement = movement
             - solids->get_movement(/* actual = */ true);
 
-          if (!tile.is_solid (tile_bbox, object.get_bbox(), relative_movement))
+          if (!layer->get_tile(x, y).is_solid (tile_bbox, object.get_bbox(), relative_movement))
             continue;
         }
 
-        if (tile.is_slope ()) { // slope tile
+        if (cell.attributes & Tile::SLOPE) { // slope tile
           AATriangle triangle;
-          int slope_data = tile.get_data();
+          int slope_data = cell.data;
           if (solids->get_flip() & VERTICAL_FLIP)
             slope_data = AATriangle::vertical_flip(slope_data);
           triangle = AATriangle(tile_bbox, slope_data);
@@ -213,8 +416,10 @@ CollisionSystem::collision_tile_attributes(const Rectf& dest, const Vector& mov)
   const float y2 = dest.get_bottom();
 
   uint32_t result = 0;
-  for (auto& solids: m_sector.get_solid_tilemaps())
+  for (const auto& layer : get_tile_layers())
   {
+    const TileMap* solids = &layer->get_tilemap();
+
     // test with all tiles in this rectangle
     const Rect test_tiles = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2));
 
@@ -222,18 +427,30 @@ CollisionSystem::collision_tile_attributes(const Rectf& dest, const Vector& mov)
     const Rect test_tiles_ice = solids->get_tiles_overlapping(Rectf(x1, y1, x2, y2 + SHIFT_DELTA));
 
     for (int x = test_tiles.left; x < test_tiles.right; ++x) {
+      // tiles without attributes can't change the result, skip them
+      const auto& span = layer->get_collision_span(x);
+      const int y_end = std::min(test_tiles.bottom, span.second);
+      const int y_ice_end = std::min(test_tiles_ice.bottom, span.second);
+
       int y;
-      for (y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
+      for (y = std::max(test_tiles.top, span.first); y < y_end; ++y) {
+        const TileMap::CollisionCell& cell = layer->get_collision_cell(x, y);
+        if (!cell.attributes)
+          continue;
 
-        if ( tile.is_collisionful( solids->get_tile_bbox(x, y), dest, mov) ) {
-          result |= tile.get_attributes();
+        if (!(cell.attributes & Tile::UNISOLID) ||
+            layer->get_tile(x, y).is_collisionful(solids->get_tile_bbox(x, y), dest, mov)) {
+          result |= cell.attributes;
         }
       }
-      for (; y < test_tiles_ice.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
-        if ( tile.is_collisionful( solids->get_tile_bbox(x, y), dest, mov) ) {
-          result |= (tile.get_attributes() & Tile::ICE);
+      for (y = std::max(y, test_tiles.bottom); y < y_ice_end; ++y) {
+        const TileMap::CollisionCell& cell = layer->get_collision_cell(x, y);
+        if (!(cell.attributes & Tile::ICE))
+          continue;
+
+        if (!(cell.attributes & Tile::UNISOLID) ||
+            layer->get_tile(x, y).is_collisionful(solids->get_tile_bbox(x, y), dest, mov)) {
+          result |= Tile::ICE;
         }
       }
     }
@@ -321,19 +538,19 @@ CollisionSystem::collision_static(collision::Constraints* constraints,
   collision_tilemap(constraints, movement, dest, object);
 
   // collision with other (static) objects
-  for (auto& static_object : m_objects)
+  m_bbox_grid.for_each(dest, [&constraints, &movement, &dest, &object](CollisionObject& static_object)
   {
-    if (static_object->get_group() != COLGROUP_STATIC &&
-        static_object->get_group() != COLGROUP_MOVING_STATIC)
-      continue;
-    if (!static_object->is_valid())
-      continue;
+    if (static_object.get_group() != COLGROUP_STATIC &&
+        static_object.get_group() != COLGROUP_MOVING_STATIC)
+      return;
+    if (!static_object.is_valid())
+      return;
 
-    if (static_object != &object) {
-      check_collisions(constraints, movement, dest, static_object->m_bbox,
-                       &object, static_object);
+    if (&static_object != &object) {
+      check_collisions(constraints, movement, dest, static_object.m_bbox,
+                       &object, &static_object);
     }
-  }
+  });
 }
 
 void
@@ -465,23 +682,34 @@ CollisionSystem::update()
 
   using namespace collision;
 
+  sync_buckets();
+
   // calculate destination positions of the objects
-  for (const auto& object : m_objects)
+  for_each_object([this](CollisionObject& object)
   {
-    const Vector mov = object->get_movement();
+    const Vector mov = object.get_movement();
 
     // make sure movement is never faster than MAX_SPEED. Norm is pretty fat, so two addl. checks are done before.
     if (((mov.x > MAX_SPEED * static_cast<float>(M_SQRT1_2)) || (mov.y > MAX_SPEED * static_cast<float>(M_SQRT1_2))) && (mov.norm() > MAX_SPEED)) {
-      object->m_movement = mov.unit() * MAX_SPEED;
+      object.m_movement = mov.unit() * MAX_SPEED;
       //log_debug << "Temporarily reduced object's speed of " << mov.norm() << " to " << object->movement.norm() << "." << std::endl;
     }
 
-    object->m_dest = object->get_bbox();
-    object->m_dest.move(object->get_movement());
-  }
+    object.m_dest = object.get_bbox();
+    object.m_dest.move(object.get_movement());
+
+    // catch objects whose bbox was changed without going through
+    // CollisionObject, e.g. by writing to m_bbox directly
+    m_bbox_grid.update(object, object.m_bbox);
+  });
+
+  // the loops below still check the group, as collision responses
+  // can change it, bucket changes only take effect after sync_buckets()
+  std::vector<CollisionObject*> objects;
 
   // part1: COLGROUP_MOVING vs COLGROUP_STATIC and tilemap
-  for (const auto& object : m_objects) {
+  gather(objects, { COLGROUP_MOVING, COLGROUP_MOVING_STATIC, COLGROUP_MOVING_ONLY_STATIC });
+  for (const auto& object : objects) {
     if ((object->get_group() != COLGROUP_MOVING
         && object->get_group() != COLGROUP_MOVING_STATIC
         && object->get_group() != COLGROUP_MOVING_ONLY_STATIC)
@@ -492,7 +720,9 @@ CollisionSystem::update()
   }
 
   // part2: COLGROUP_MOVING vs tile attributes
-  for (const auto& object : m_objects) {
+  sync_buckets();
+  gather(objects, { COLGROUP_MOVING, COLGROUP_MOVING_STATIC, COLGROUP_MOVING_ONLY_STATIC });
+  for (const auto& object : objects) {
     if ((object->get_group() != COLGROUP_MOVING
         && object->get_group() != COLGROUP_MOVING_STATIC
         && object->get_group() != COLGROUP_MOVING_ONLY_STATIC)
@@ -505,61 +735,82 @@ CollisionSystem::update()
     }
   }
 
+  // the destinations are final for the static phases, file them in
+  // the broadphase for the object vs object phases
+  m_dest_grid.clear();
+  for_each_object([this](CollisionObject& object) {
+    m_dest_grid.update(object, object.m_dest);
+  });
+  m_dest_grid_valid = true;
+
   // part2.5: COLGROUP_MOVING vs COLGROUP_TOUCHABLE
-  for (const auto& object : m_objects)
+  sync_buckets();
+  gather(objects, { COLGROUP_MOVING, COLGROUP_MOVING_STATIC });
+  for (const auto& object : objects)
   {
     if ((object->get_group() != COLGROUP_MOVING
         && object->get_group() != COLGROUP_MOVING_STATIC)
        || !object->is_valid())
       continue;
 
-    for (auto& object_2 : m_objects) {
-      if (object_2->get_group() != COLGROUP_TOUCHABLE
-         || !object_2->is_valid())
-        continue;
+    m_dest_grid.for_each(object->m_dest, [object](CollisionObject& object_2)
+    {
+      if (object_2.get_group() != COLGROUP_TOUCHABLE
+         || !object_2.is_valid())
+        return;
 
-      if (intersects(object->m_dest, object_2->m_dest)) {
+      if (intersects(object->m_dest, object_2.m_dest)) {
         Vector normal;
         CollisionHit hit;
-        get_hit_normal(object->m_dest, object_2->m_dest,
+        get_hit_normal(object->m_dest, object_2.m_dest,
                        hit, normal);
-        if (!object->collides(*object_2, hit))
-          continue;
-        if (!object_2->collides(*object, hit))
-          continue;
+        if (!object->collides(object_2, hit))
+          return;
+        if (!object_2.collides(*object, hit))
+          return;
 
-        object->collision(*object_2, hit);
-        object_2->collision(*object, hit);
+        object->collision(object_2, hit);
+        object_2.collision(*object, hit);
       }
-    }
+    });
   }
 
   // part3: COLGROUP_MOVING vs COLGROUP_MOVING
-  for (auto i = m_objects.begin(); i != m_objects.end(); ++i)
+  sync_buckets();
+  gather(objects, { COLGROUP_MOVING, COLGROUP_MOVING_STATIC });
+  for (const auto& object : objects)
   {
-    auto object = *i;
-
     if ((object->get_group() != COLGROUP_MOVING
         && object->get_group() != COLGROUP_MOVING_STATIC)
        || !object->is_valid())
       continue;
 
-    for (auto i2 = i+1; i2 != m_objects.end(); ++i2) {
-      auto object_2 = *i2;
-      if ((object_2->get_group() != COLGROUP_MOVING
-          && object_2->get_group() != COLGROUP_MOVING_STATIC)
-         || !object_2->is_valid())
-        continue;
+    // only look at objects added after this one, each pair is handled once
+    m_dest_grid.for_each(object->m_dest, [this, object](CollisionObject& object_2)
+    {
+      if ((object_2.get_group() != COLGROUP_MOVING
+          && object_2.get_group() != COLGROUP_MOVING_STATIC)
+         || !object_2.is_valid())
+        return;
 
-      collision_object(object, object_2);
-    }
+      collision_object(object, &object_2);
+
+      // collision response might have pushed the objects apart
+      m_dest_grid.update(*object, object->m_dest);
+      m_dest_grid.update(object_2, object_2.m_dest);
+    }, object->get_seq());
   }
 
+  m_dest_grid_valid = false;
+  m_dest_grid.clear();
+
   // apply object movement
-  for (const auto& object : m_objects) {
-    object->m_bbox = object->m_dest;
-    object->m_movement = Vector(0, 0);
-  }
+  sync_buckets();
+  for_each_object([this](CollisionObject& object) {
+    object.m_bbox = object.m_dest;
+    object.m_movement = Vector(0, 0);
+    m_bbox_grid.update(object, object.m_bbox);
+  });
 }
 
 bool
@@ -567,22 +818,27 @@ CollisionSystem::is_free_of_tiles(const Rectf& rect, const bool ignoreUnisolid)
 {
   using namespace collision;
 
-  for (const auto& solids : m_sector.get_solid_tilemaps()) {
+  for (const auto& layer : get_tile_layers()) {
+    const TileMap* solids = &layer->get_tilemap();
+
     // test with all tiles in this rectangle
     const Rect test_tiles = solids->get_tiles_overlapping(rect);
 
     for (int x = test_tiles.left; x < test_tiles.right; ++x) {
-      for (int y = test_tiles.top; y < test_tiles.bottom; ++y) {
-        const Tile& tile = solids->get_tile(x, y);
+      const auto& span = layer->get_collision_span(x);
+      const int y_end = std::min(test_tiles.bottom, span.second);
+
+      for (int y = std::max(test_tiles.top, span.first); y < y_end; ++y) {
+        const TileMap::CollisionCell& cell = layer->get_collision_cell(x, y);
 
-        if (!(tile.get_attributes() & Tile::SOLID))
+        if (!(cell.attributes & Tile::SOLID))
           continue;
-        if (tile.is_unisolid () && ignoreUnisolid)
+        if ((cell.attributes & Tile::UNISOLID) && ignoreUnisolid)
           continue;
-        if (tile.is_slope ()) {
+        if (cell.attributes & Tile::SLOPE) {
           AATriangle triangle;
           const Rectf tbbox = solids->get_tile_bbox(x, y);
-          triangle = AATriangle(tbbox, tile.get_data());
+          triangle = AATriangle(tbbox, cell.data);
           Constraints constraints;
           if (!collision::rectangle_aatriangle(&constraints, rect, triangle))
             continue;
@@ -603,7 +859,9 @@ CollisionSystem::is_free_of_statics(const Rectf& rect, const CollisionObject* ig
 
   if (!is_free_of_tiles(rect, ignoreUnisolid)) return false;
 
-  for (const auto& object : m_objects) {
+  std::vector<CollisionObject*> candidates;
+  m_bbox_grid.query(rect, candidates);
+  for (const auto& object : candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if (object->get_group() == COLGROUP_STATIC) {
@@ -621,7 +879,9 @@ CollisionSystem::is_free_of_movingstatics(const Rectf& rect, const CollisionObje
 
   if (!is_free_of_tiles(rect)) return false;
 
-  for (const auto& object : m_objects) {
+  std::vector<CollisionObject*> candidates;
+  m_bbox_grid.query(rect, candidates);
+  for (const auto& object : candidates) {
     if (object == ignore_object) continue;
     if (!object->is_valid()) continue;
     if ((object->get_group() == COLGROUP_MOVING)
@@ -636,33 +896,130 @@ CollisionSystem::is_free_of_movingstatics(const Rectf& rect, const CollisionObje
 
 bool
 CollisionSystem::free_line_of_sight(const Vector& line_start, const Vector& line_end, const CollisionObject* ignore_object) const
+{
+  return any_free_line_of_sight({ std::make_pair(line_start, line_end) }, ignore_object);
+}
+
+bool
+CollisionSystem::any_free_line_of_sight(const std::vector<std::pair<Vector, Vector> >& lines,
+                                        const CollisionObject* ignore_object) const
 {
   using namespace collision;
 
-  // check if no tile is in the way
-  const float lsx = std::min(line_start.x, line_end.x);
-  const float lex = std::max(line_start.x, line_end.x);
-  const float lsy = std::min(line_start.y, line_end.y);
-  const float ley = std::max(line_start.y, line_end.y);
-
-  for (float test_x = lsx; test_x <= lex; test_x += 16) { // NOLINT
-    for (float test_y = lsy; test_y <= ley; test_y += 16) { // NOLINT
-      for (const auto& solids : m_sector.get_solid_tilemaps()) {
-        const Tile& tile = solids->get_tile_at(Vector(test_x, test_y));
-        // FIXME: check collision with slope tiles
-        if ((tile.get_attributes() & Tile::SOLID)) return false;
-      }
-    }
+  if (lines.empty())
+    return false;
+
+  // look up the objects around all lines at once
+  Rectf area(lines.front().first, lines.front().first);
+  for (const auto& line : lines) {
+    area.set_left(std::min(area.get_left(), std::min(line.first.x, line.second.x)));
+    area.set_right(std::max(area.get_right(), std::max(line.first.x, line.second.x)));
+    area.set_top(std::min(area.get_top(), std::min(line.first.y, line.second.y)));
+    area.set_bottom(std::max(area.get_bottom(), std::max(line.first.y, line.second.y)));
   }
 
-  // check if no object is in the way
-  for (const auto& object : m_objects) {
-    if (object == ignore_object) continue;
-    if (!object->is_valid()) continue;
-    if ((object->get_group() == COLGROUP_MOVING)
-        || (object->get_group() == COLGROUP_MOVING_STATIC)
-        || (object->get_group() == COLGROUP_STATIC)) {
-      if (intersects_line(object->get_bbox(), line_start, line_end)) return false;
+  std::vector<CollisionObject*> candidates;
+  m_bbox_grid.query(area, candidates);
+  candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                  [ignore_object](const CollisionObject* object) {
+                                    return (object == ignore_object ||
+                                            !object->is_valid() ||
+                                            (object->get_group() != COLGROUP_MOVING &&
+                                             object->get_group() != COLGROUP_MOVING_STATIC &&
+                                             object->get_group() != COLGROUP_STATIC));
+                                  }),
+                   candidates.end());
+
+  for (const auto& line : lines)
+  {
+    // check if no tile is in the way
+    if (!is_line_free_of_tiles(line.first, line.second))
+      continue;
+
+    // check if no object is in the way
+    const Rectf line_bbox(Vector(std::min(line.first.x, line.second.x), std::min(line.first.y, line.second.y)),
+                          Vector(std::max(line.first.x, line.second.x), std::max(line.first.y, line.second.y)));
+    const bool blocked = std::any_of(candidates.begin(), candidates.end(),
+                                     [&line, &line_bbox](const CollisionObject* object) {
+                                       return (intersects(object->get_bbox(), line_bbox) &&
+                                               intersects_line(object->get_bbox(), line.first, line.second));
+                                     });
+    if (!blocked)
+      return true;
+  }
+
+  return false;
+}
+
+bool
+CollisionSystem::is_line_free_of_tiles(const Vector& line_start, const Vector& line_end) const
+{
+  for (const auto& layer : get_tile_layers())
+  {
+    const TileMap& solids = layer->get_tilemap();
+
+    // work in tile coordinates, clipped to the tilemap
+    const Vector start = (line_start - solids.get_offset()) / 32;
+    const Vector end = (line_end - solids.get_offset()) / 32;
+    const Rectf bounds(0.0f, 0.0f,
+                       static_cast<float>(solids.get_width()),
+                       static_cast<float>(solids.get_height()));
+
+    float t_enter;
+    float t_exit;
+    if (!collision::clip_line(bounds, start, end, t_enter, t_exit))
+      continue;
+
+    const Vector dir = end - start;
+    const Vector p1 = start + dir * t_enter;
+    const Vector p2 = start + dir * t_exit;
+
+    // walk all tiles touched by the line (Amanatides & Woo), the
+    // clamping keeps points on the right or bottom border in range
+    int x = math::clamp(static_cast<int>(floorf(p1.x)), 0, solids.get_width() - 1);
+    int y = math::clamp(static_cast<int>(floorf(p1.y)), 0, solids.get_height() - 1);
+    const int end_x = math::clamp(static_cast<int>(floorf(p2.x)), 0, solids.get_width() - 1);
+    const int end_y = math::clamp(static_cast<int>(floorf(p2.y)), 0, solids.get_height() - 1);
+
+    const int step_x = (dir.x > 0.0f) ? 1 : ((dir.x < 0.0f) ? -1 : 0);
+    const int step_y = (dir.y > 0.0f) ? 1 : ((dir.y < 0.0f) ? -1 : 0);
+
+    const float inf = std::numeric_limits<float>::infinity();
+    const float t_delta_x = step_x ? 1.0f / fabsf(dir.x) : inf;
+    const float t_delta_y = step_y ? 1.0f / fabsf(dir.y) : inf;
+    float t_max_x = (step_x > 0) ? (static_cast<float>(x + 1) - start.x) / dir.x :
+                    (step_x < 0) ? (static_cast<float>(x) - start.x) / dir.x : inf;
+    float t_max_y = (step_y > 0) ? (static_cast<float>(y + 1) - start.y) / dir.y :
+                    (step_y < 0) ? (static_cast<float>(y) - start.y) / dir.y : inf;
+
+    int steps = abs(end_x - x) + abs(end_y - y);
+    while (true)
+    {
+      const TileMap::CollisionCell& cell = layer->get_collision_cell(x, y);
+      if (cell.attributes & Tile::SOLID)
+      {
+        if (!(cell.attributes & Tile::SLOPE))
+          return false;
+
+        int slope_data = cell.data;
+        if (solids.get_flip() & VERTICAL_FLIP)
+          slope_data = AATriangle::vertical_flip(slope_data);
+        const AATriangle triangle(solids.get_tile_bbox(x, y), slope_data);
+        if (collision::intersects_line(triangle, line_start, line_end))
+          return false;
+      }
+
+      if (steps <= 0)
+        break;
+      steps -= 1;
+
+      if (t_max_x < t_max_y) {
+        x += step_x;
+        t_max_x += t_delta_x;
+      } else {
+        y += step_y;
+        t_max_y += t_delta_y;
+      }
     }
   }
 
@@ -674,7 +1031,17 @@ CollisionSystem::get_nearby_objects (const Vector& center, float max_distance) c
 {
   std::vector<CollisionObject*> ret;
 
-  for (const auto& object : m_objects) {
+  if (!(max_distance >= 0.0f))
+    return ret;
+
+  // the distance is measured to the middle of the bbox, so a square
+  // around center catches everything, with a bit of slack for rounding
+  const float range = max_distance + 1.0f;
+  std::vector<CollisionObject*> candidates;
+  m_bbox_grid.query(Rectf(center - Vector(range, range),
+                          Sizef(2.0f * range, 2.0f * range)),
+                    candidates);
+  for (const auto& object : candidates) {
     float distance = object->get_bbox().distance(center);
     if (distance <= max_distance)
       ret.push_back(object);
@@ -18,25 +18,74 @@
 #ifndef HEADER_SUPERTUX_COLLISION_COLLISION_SYSTEM_HPP
 #define HEADER_SUPERTUX_COLLISION_COLLISION_SYSTEM_HPP
 
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <stdint.h>
 
 #include "collision/collision.hpp"
+#include "collision/collision_grid.hpp"
+#include "collision/collision_group.hpp"
+#include "math/vector.hpp"
 
 class CollisionObject;
 class DrawingContext;
 class Rectf;
 class Sector;
-class Vector;
+class TileCollisionLayer;
+class TileMap;
 
 class CollisionSystem final
 {
+private:
+  /** Slot in a group bucket, object is nullptr for objects that have
+      been removed or changed their group since the last compaction */
+  struct BucketEntry
+  {
+    uint64_t seq;
+    CollisionObject* object;
+  };
+
+  /** Objects of a single CollisionGroup, sorted by sequence number */
+  struct Bucket
+  {
+    std::vector<BucketEntry> entries;
+    size_t holes;
+  };
+
+  static const int NUM_BUCKETS = COLGROUP_TOUCHABLE + 1;
+
 public:
   CollisionSystem(Sector& sector);
+  ~CollisionSystem();
 
   void add(CollisionObject* object);
   void remove(CollisionObject* object);
 
+  /** Called by CollisionObject when it got moved or resized, keeps
+      the broadphase in sync */
+  void object_moved(CollisionObject& object);
+
+  /** Called by CollisionObject when its group changed, the object is
+      moved to its new bucket on the next sync_buckets() */
+  void object_regrouped(CollisionObject& object);
+
+  /** Groups the solid tilemaps of the sector into collision layers,
+      merging those that share their geometry. Called once the sector
+      is constructed, afterwards the layers are rebuilt on demand
+      whenever the solid tilemaps change. */
+  void rebuild_tile_layers() const;
+
+  /** Called by a merged TileMap when its geometry, solidity or all
+      of its tiles changed */
+  void tilemap_changed(TileMap& tilemap);
+
+  /** Called by a merged TileMap when a single tile got changed */
+  void tile_changed(TileMap& tilemap, int x, int y);
+
   /** Draw collision shapes for debugging */
   void draw(DrawingContext& context);
 
@@ -50,6 +99,15 @@ public:
   bool is_free_of_movingstatics(const Rectf& rect, const CollisionObject* ignore_object) const;
   bool free_line_of_sight(const Vector& line_start, const Vector& line_end, const CollisionObject* ignore_object) const;
 
+  /** Returns true if at least one of the lines is free, objects near
+      the lines are only looked up once for the whole batch */
+  bool any_free_line_of_sight(const std::vector<std::pair<Vector, Vector> >& lines,
+                              const CollisionObject* ignore_object) const;
+
+  /** Walks the tiles along the line, slopes only block it where the
+      line touches their solid part */
+  bool is_line_free_of_tiles(const Vector& line_start, const Vector& line_end) const;
+
   std::vector<CollisionObject*> get_nearby_objects(const Vector& center, float max_distance) const;
 
 private:
@@ -75,9 +133,64 @@ private:
 
   void collision_static_constrains(CollisionObject& object);
 
+  /** Returns the tile layers, rebuilding them first if needed */
+  const std::vector<std::unique_ptr<TileCollisionLayer> >& get_tile_layers() const;
+
+  void add_to_bucket(CollisionObject& object);
+  void remove_from_bucket(CollisionObject& object);
+
+  /** Files objects with pending group changes into their new bucket
+      and compacts buckets with holes */
+  void sync_buckets();
+
+  /** Fills result with the objects in the given groups, in the order
+      they were added to the CollisionSystem */
+  void gather(std::vector<CollisionObject*>& result,
+              std::initializer_list<CollisionGroup> groups) const;
+
+  template<typename F>
+  void for_each_object(F func) const
+  {
+    for (const auto& bucket : m_buckets) {
+      for (const auto& entry : bucket.entries) {
+        if (entry.object) {
+          func(*entry.object);
+        }
+      }
+    }
+    for (const auto& object : m_regrouped) {
+      func(*object);
+    }
+  }
+
 private:
   Sector& m_sector;
-  std::vector<CollisionObject*>  m_objects;
+
+  /** Objects filed by their collision group */
+  std::array<Bucket, NUM_BUCKETS> m_buckets;
+
+  /** Objects that changed their group and wait to be filed */
+  std::vector<CollisionObject*> m_regrouped;
+
+  /** Broadphase over the current bounding boxes of all objects */
+  CollisionGrid m_bbox_grid;
+
+  /** Broadphase over the anticipated destinations of all objects,
+      only valid during the object vs object phases of update() */
+  CollisionGrid m_dest_grid;
+  bool m_dest_grid_valid;
+
+  uint64_t m_next_seq;
+
+  /** Solid tilemaps, merged where possible, see rebuild_tile_layers().
+      These are caches that are refreshed from const queries. */
+  mutable std::vector<std::unique_ptr<TileCollisionLayer> > m_tile_layers;
+  mutable std::unordered_map<const TileMap*, TileCollisionLayer*> m_merged_tilemaps;
+  mutable bool m_tile_layers_valid;
+
+  /** Value of Sector::get_solid_tilemaps_revision() the layers were
+      built for */
+  mutable uint32_t m_tile_layers_revision;
 
 private:
   CollisionSystem(const CollisionSystem&) = delete;
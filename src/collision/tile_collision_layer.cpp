@@ -0,0 +1,178 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "collision/tile_collision_layer.hpp"
+
+#include <assert.h>
+
+#include "supertux/tile.hpp"
+
+namespace {
+
+/** Upper limit for m_owners */
+const size_t MAX_TILEMAPS = 256;
+
+bool is_static(const TileMap& tilemap)
+{
+  return !tilemap.get_walker() && !tilemap.is_fading();
+}
+
+/** Two cells can share a tile position if at most one of them is
+    used, or if they are the same tile. Unisolid tiles depend on the
+    tile itself, so they are never shared. */
+bool conflicts(const TileMap::CollisionCell& lhs, const TileMap::CollisionCell& rhs)
+{
+  if (!lhs.attributes || !rhs.attributes)
+    return false;
+
+  return (lhs.attributes != rhs.attributes ||
+          lhs.data != rhs.data ||
+          (lhs.attributes & Tile::UNISOLID));
+}
+
+} // namespace
+
+TileCollisionLayer::TileCollisionLayer(const TileMap& tilemap) :
+  m_tilemaps({ &tilemap }),
+  m_width(tilemap.get_width()),
+  m_height(tilemap.get_height()),
+  m_cells(),
+  m_owners(),
+  m_spans()
+{
+}
+
+bool
+TileCollisionLayer::can_merge(const TileMap& tilemap) const
+{
+  const TileMap& base = get_tilemap();
+
+  if (!is_static(base) || !is_static(tilemap))
+    return false;
+
+  if (m_tilemaps.size() >= MAX_TILEMAPS)
+    return false;
+
+  if (tilemap.get_width() != m_width ||
+      tilemap.get_height() != m_height ||
+      tilemap.get_offset() != base.get_offset() ||
+      tilemap.get_flip() != base.get_flip())
+    return false;
+
+  for (int x = 0; x < m_width; ++x) {
+    const auto& span = tilemap.get_collision_span(x);
+    for (int y = span.first; y < span.second; ++y) {
+      if (conflicts(get_collision_cell(x, y), tilemap.get_collision_cell(x, y)))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+void
+TileCollisionLayer::merge(const TileMap& tilemap)
+{
+  assert(can_merge(tilemap));
+
+  if (m_cells.empty())
+  {
+    const TileMap& base = get_tilemap();
+
+    m_cells.reserve(m_width * m_height);
+    for (int y = 0; y < m_height; ++y) {
+      for (int x = 0; x < m_width; ++x) {
+        m_cells.push_back(base.get_collision_cell(x, y));
+      }
+    }
+    m_owners.resize(m_cells.size(), 0);
+
+    m_spans.reserve(m_width);
+    for (int x = 0; x < m_width; ++x) {
+      m_spans.push_back(base.get_collision_span(x));
+    }
+  }
+
+  const uint8_t owner = static_cast<uint8_t>(m_tilemaps.size());
+  m_tilemaps.push_back(&tilemap);
+
+  for (int x = 0; x < m_width; ++x) {
+    const auto& span = tilemap.get_collision_span(x);
+    if (span.first == span.second)
+      continue;
+
+    for (int y = span.first; y < span.second; ++y) {
+      auto& cell = m_cells[y * m_width + x];
+      if (!cell.attributes) {
+        cell = tilemap.get_collision_cell(x, y);
+        m_owners[y * m_width + x] = owner;
+      }
+    }
+    update_span(x);
+  }
+}
+
+bool
+TileCollisionLayer::update_cell(int x, int y)
+{
+  if (m_cells.empty())
+    return true;
+
+  TileMap::CollisionCell result = { 0, 0 };
+  uint8_t owner = 0;
+  for (size_t i = 0; i < m_tilemaps.size(); ++i) {
+    const auto& cell = m_tilemaps[i]->get_collision_cell(x, y);
+    if (conflicts(result, cell))
+      return false;
+
+    if (!result.attributes && cell.attributes) {
+      result = cell;
+      owner = static_cast<uint8_t>(i);
+    }
+  }
+
+  m_cells[y * m_width + x] = result;
+  m_owners[y * m_width + x] = owner;
+  update_span(x);
+  return true;
+}
+
+const Tile&
+TileCollisionLayer::get_tile(int x, int y) const
+{
+  if (m_owners.empty())
+    return m_tilemaps.front()->get_tile(x, y);
+  else
+    return m_tilemaps[m_owners[y * m_width + x]]->get_tile(x, y);
+}
+
+void
+TileCollisionLayer::update_span(int x)
+{
+  int top = 0;
+  while (top < m_height && m_cells[top * m_width + x].attributes == 0) {
+    ++top;
+  }
+
+  int bottom = m_height;
+  while (bottom > top && m_cells[(bottom - 1) * m_width + x].attributes == 0) {
+    --bottom;
+  }
+
+  m_spans[x] = std::make_pair(top, bottom);
+}
+
+/* EOF */
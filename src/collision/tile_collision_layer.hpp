@@ -0,0 +1,100 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_COLLISION_TILE_COLLISION_LAYER_HPP
+#define HEADER_SUPERTUX_COLLISION_TILE_COLLISION_LAYER_HPP
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "object/tilemap.hpp"
+
+class Tile;
+
+/** The tiles the CollisionSystem tests against. Solid tilemaps that
+    don't move and share their geometry are merged into a single
+    layer, so that a collision query only has to scan each tile
+    position once instead of once per tilemap. Tilemaps that can't be
+    merged get a layer of their own, which reads their collision
+    cells directly. */
+class TileCollisionLayer final
+{
+public:
+  TileCollisionLayer(const TileMap& tilemap);
+
+  /** Returns true if tilemap can be merged into this layer: neither
+      of them moves or fades, their geometry is identical and no tile
+      position is used by both with different tiles */
+  bool can_merge(const TileMap& tilemap) const;
+  void merge(const TileMap& tilemap);
+
+  /** Recalculates cell (x, y) after a tile in one of the merged
+      tilemaps got changed. Returns false if the tilemaps now
+      disagree about that cell and the layer has to be rebuilt. */
+  bool update_cell(int x, int y);
+
+  bool is_merged() const { return m_tilemaps.size() > 1; }
+  const std::vector<const TileMap*>& get_tilemaps() const { return m_tilemaps; }
+
+  /** The tilemap that provides offset, size, flip and movement of
+      the layer */
+  const TileMap& get_tilemap() const { return *m_tilemaps.front(); }
+
+  const TileMap::CollisionCell& get_collision_cell(int x, int y) const
+  {
+    if (m_cells.empty())
+      return m_tilemaps.front()->get_collision_cell(x, y);
+    else
+      return m_cells[y * m_width + x];
+  }
+
+  const std::pair<int, int>& get_collision_span(int x) const
+  {
+    if (m_spans.empty())
+      return m_tilemaps.front()->get_collision_span(x);
+    else
+      return m_spans[x];
+  }
+
+  /** Returns the tile at (x, y) from the tilemap that provided the
+      cell, used for unisolid tiles */
+  const Tile& get_tile(int x, int y) const;
+
+private:
+  void update_span(int x);
+
+private:
+  std::vector<const TileMap*> m_tilemaps;
+  int m_width;
+  int m_height;
+
+  /** Merged cells, empty as long as the layer holds a single tilemap */
+  std::vector<TileMap::CollisionCell> m_cells;
+
+  /** Index into m_tilemaps of the tilemap each cell came from */
+  std::vector<uint8_t> m_owners;
+
+  std::vector<std::pair<int, int> > m_spans;
+
+private:
+  TileCollisionLayer(const TileCollisionLayer&) = delete;
+  TileCollisionLayer& operator=(const TileCollisionLayer&) = delete;
+};
+
+#endif
+
+/* EOF */
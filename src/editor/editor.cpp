@@ -137,7 +137,7 @@ Editor::~Editor()
 }
 
 void
-Editor::draw(Compositor& compositor)
+Editor::draw(Compositor& compositor, float alpha)
 {
   auto& context = compositor.make_context();
 
@@ -55,7 +55,7 @@ public:
   Editor();
   ~Editor();
 
-  virtual void draw(Compositor&) override;
+  virtual void draw(Compositor&, float) override;
   virtual void update(float dt_sec, const Controller& controller) override;
 
   virtual void setup() override;
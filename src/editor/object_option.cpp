@@ -459,7 +459,7 @@ TilesObjectOption::save(Writer& write) const
 {
   write.write("width", m_tilemap->get_width());
   write.write("height", m_tilemap->get_height());
-  write.write("tiles", m_tilemap->get_tiles(), m_tilemap->get_width());
+  write.write_tiles("tiles", m_tilemap->get_tiles(), m_tilemap->get_width());
 }
 
 std::string
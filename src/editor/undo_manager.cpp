@@ -36,8 +36,10 @@ UndoManager::UndoManager() :
 void
 UndoManager::try_snapshot(Level& level)
 {
+  // snapshots never leave this process, so they can use the compact
+  // tile format to take less memory
   std::ostringstream out;
-  level.save(out);
+  level.save(out, true);
   std::string level_snapshot = out.str();
 
   if (m_undo_stack.empty())
@@ -52,8 +52,8 @@ Bullet::Bullet(const Vector& pos, float xm, Direction dir, BonusType type_) :
     sprite = SpriteManager::current()->create("images/objects/bullets/firebullet.sprite");
   }
 
-  m_col.m_bbox.set_pos(pos);
-  m_col.m_bbox.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+  m_col.set_pos(pos);
+  m_col.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 }
 
 void
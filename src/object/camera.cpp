@@ -21,6 +21,7 @@
 
 #include "math/util.hpp"
 #include "object/player.hpp"
+#include "supertux/constants.hpp"
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
 #include "util/reader_document.hpp"
@@ -124,6 +125,7 @@ Camera::Camera(const std::string& name) :
   m_defaultmode(Mode::NORMAL),
   m_screen_size(SCREEN_WIDTH, SCREEN_HEIGHT),
   m_translation(),
+  m_previous_translation(),
   m_lookahead_mode(LookaheadMode::NONE),
   m_changetime(),
   m_lookahead_pos(),
@@ -149,6 +151,7 @@ Camera::Camera(const ReaderMapping& reader) :
   m_defaultmode(Mode::NORMAL),
   m_screen_size(SCREEN_WIDTH, SCREEN_HEIGHT),
   m_translation(),
+  m_previous_translation(),
   m_lookahead_mode(LookaheadMode::NONE),
   m_changetime(),
   m_lookahead_pos(),
@@ -238,6 +241,16 @@ Camera::get_translation() const
   return m_translation;
 }
 
+Vector
+Camera::get_interpolated_translation(float alpha) const
+{
+  const Vector delta = m_translation - m_previous_translation;
+  if (delta.norm() > MAX_INTERPOLATION_DISTANCE) {
+    return m_translation;
+  }
+  return m_previous_translation + delta * alpha;
+}
+
 void
 Camera::reset(const Vector& tuxpos)
 {
@@ -249,6 +262,7 @@ Camera::reset(const Vector& tuxpos)
   keep_in_bounds(m_translation);
 
   m_cached_translation = m_translation;
+  m_previous_translation = m_translation;
 }
 
 void
@@ -284,6 +298,8 @@ Camera::draw(DrawingContext& context)
 void
 Camera::update(float dt_sec)
 {
+  m_previous_translation = m_translation;
+
   switch (m_mode) {
     case Mode::NORMAL:
       update_scroll_normal(dt_sec);
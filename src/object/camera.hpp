@@ -82,6 +82,10 @@ public:
   const Vector& get_translation() const;
   void set_translation(const Vector& translation) { m_translation = translation; }
 
+  /** return camera position alpha (0.0 to 1.0) of the way from the
+      start of the last update() to its end */
+  Vector get_interpolated_translation(float alpha) const;
+
   /** shake camera in a direction 1 time */
   void shake(float duration, float x, float y);
 
@@ -114,6 +118,9 @@ private:
 
   Vector m_translation;
 
+  /** m_translation at the start of the last update() */
+  Vector m_previous_translation;
+
   // normal mode
   LookaheadMode m_lookahead_mode;
   float m_changetime;
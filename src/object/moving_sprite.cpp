@@ -35,8 +35,8 @@ MovingSprite::MovingSprite(const Vector& pos, const std::string& sprite_name_,
   m_sprite(SpriteManager::current()->create(m_sprite_name)),
   m_layer(layer_)
 {
-  m_col.m_bbox.set_pos(pos);
-  m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+  m_col.set_pos(pos);
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
   set_group(collision_group);
 }
 
@@ -47,13 +47,13 @@ MovingSprite::MovingSprite(const ReaderMapping& reader, const Vector& pos, int l
   m_sprite(),
   m_layer(layer_)
 {
-  m_col.m_bbox.set_pos(pos);
+  m_col.set_pos(pos);
   if (!reader.get("sprite", m_sprite_name))
     throw std::runtime_error("no sprite name set");
 
   //m_default_sprite_name = m_sprite_name;
   m_sprite = SpriteManager::current()->create(m_sprite_name);
-  m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
   set_group(collision_group);
 }
 
@@ -75,7 +75,7 @@ MovingSprite::MovingSprite(const ReaderMapping& reader, const std::string& sprit
     m_sprite = SpriteManager::current()->create(m_sprite_name);
   }
 
-  m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
   set_group(collision_group);
 }
 
@@ -93,7 +93,7 @@ MovingSprite::MovingSprite(const ReaderMapping& reader, int layer_, CollisionGro
 
   //m_default_sprite_name = m_sprite_name;
   m_sprite = SpriteManager::current()->create(m_sprite_name);
-  m_col.m_bbox.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
   set_group(collision_group);
 }
 
@@ -121,6 +121,13 @@ MovingSprite::set_action(const std::string& action, int loops)
   m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
 }
 
+void
+MovingSprite::set_action(const ActionHandle& action, int loops)
+{
+  m_sprite->set_action(action, loops);
+  m_col.set_size(m_sprite->get_current_hitbox_width(), m_sprite->get_current_hitbox_height());
+}
+
 void
 MovingSprite::set_action_centered(const std::string& action, int loops)
 {
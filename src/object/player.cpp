@@ -68,13 +68,85 @@ const unsigned int IDLE_STAGE_COUNT = 5;
  * animation
  */
 const int IDLE_TIME[] = { 5000, 0, 2500, 0, 2500 };
+
+/** Poses Tux has an action for, with every bonus in either direction */
+enum TuxPose
+{
+  POSE_CLIMBING,
+  POSE_BACKFLIP,
+  POSE_DUCK,
+  POSE_SKID,
+  POSE_KICK,
+  POSE_BUTTJUMP,
+  POSE_JUMP,
+  POSE_STAND,
+  POSE_IDLE,
+  POSE_RUN,
+  POSE_WALK,
+  POSE_COUNT
+};
+
+const char* const POSE_NAMES[POSE_COUNT] =
+{ "climbing", "backflip", "duck", "skid", "kick", "buttjump", "jump",
+  "stand", "idle", "run", "walk" };
+
+/** The looks of Tux, the action name prefixes of the bonuses */
+enum TuxLook
+{
+  LOOK_SMALL,
+  LOOK_BIG,
+  LOOK_FIRE,
+  LOOK_SANTA,
+  LOOK_ICE,
+  LOOK_AIR,
+  LOOK_EARTH,
+  LOOK_COUNT
+};
+
+const char* const LOOK_NAMES[LOOK_COUNT] =
+{ "small", "big", "fire", "santa", "ice", "air", "earth" };
+
+/** Handles of all "<look>-<pose>-<direction>" actions, so that draw()
+    doesn't build their names every frame */
+class TuxActions final
+{
+public:
+  TuxActions() :
+    m_handles()
+  {
+    for (int look = 0; look < LOOK_COUNT; ++look)
+    {
+      for (int pose = 0; pose < POSE_COUNT; ++pose)
+      {
+        const std::string name = std::string(LOOK_NAMES[look]) + "-" + POSE_NAMES[pose];
+        m_handles[look][pose][0] = ActionHandle(name + "-left");
+        m_handles[look][pose][1] = ActionHandle(name + "-right");
+      }
+    }
+  }
+
+  const ActionHandle& get(TuxLook look, TuxPose pose, Direction dir) const
+  {
+    return m_handles[look][pose][dir == Direction::LEFT ? 0 : 1];
+  }
+
+private:
+  ActionHandle m_handles[LOOK_COUNT][POSE_COUNT][2];
+};
+
+const TuxActions TUX_ACTIONS;
+
+const ActionHandle ACTION_GROW_LEFT("grow-left");
+const ActionHandle ACTION_GROW_RIGHT("grow-right");
+const ActionHandle ACTION_GAMEOVER("gameover");
+
 /** idle stages */
-const std::string IDLE_STAGES[] =
-{ "stand",
-  "idle",
-  "stand",
-  "idle",
-  "stand" };
+const TuxPose IDLE_STAGES[] =
+{ POSE_STAND,
+  POSE_IDLE,
+  POSE_STAND,
+  POSE_IDLE,
+  POSE_STAND };
 
 /** acceleration in horizontal direction when walking
  * (all accelerations are in  pixel/s^2) */
@@ -1205,36 +1277,34 @@ Player::draw(DrawingContext& context)
     context.color().draw_surface(jumparrow, Vector(px, py), LAYER_HUD - 1);
   }
 
-  std::string sa_prefix = "";
-  std::string sa_postfix = "";
+  TuxLook look;
 
   if (m_player_status.bonus == GROWUP_BONUS)
-    sa_prefix = "big";
+    look = LOOK_BIG;
   else if (m_player_status.bonus == FIRE_BONUS)
     if (g_config->christmas_mode)
-      sa_prefix = "santa";
+      look = LOOK_SANTA;
     else
-      sa_prefix = "fire";
+      look = LOOK_FIRE;
   else if (m_player_status.bonus == ICE_BONUS)
-    sa_prefix = "ice";
+    look = LOOK_ICE;
   else if (m_player_status.bonus == AIR_BONUS)
-    sa_prefix = "air";
+    look = LOOK_AIR;
   else if (m_player_status.bonus == EARTH_BONUS)
-    sa_prefix = "earth";
+    look = LOOK_EARTH;
   else
-    sa_prefix = "small";
+    look = LOOK_SMALL;
 
-  if (m_dir == Direction::LEFT)
-    sa_postfix = "-left";
-  else
-    sa_postfix = "-right";
+  const auto action = [this, look](TuxPose pose) -> const ActionHandle& {
+    return TUX_ACTIONS.get(look, pose, m_dir);
+  };
 
   /* Set Tux sprite action */
   if (m_dying) {
-    m_sprite->set_action("gameover");
+    m_sprite->set_action(ACTION_GAMEOVER);
   }
   else if (m_growing) {
-    m_sprite->set_action_continued("grow"+sa_postfix);
+    m_sprite->set_action_continued(m_dir == Direction::LEFT ? ACTION_GROW_LEFT : ACTION_GROW_RIGHT);
     // while growing, do not change action
     // do_duck() will take care of cancelling growing manually
     // update() will take care of cancelling when growing completed
@@ -1243,26 +1313,26 @@ Player::draw(DrawingContext& context)
     m_sprite->set_action(m_sprite->get_action()+"-stone");
   }
   else if (m_climbing) {
-    m_sprite->set_action(sa_prefix+"-climbing"+sa_postfix);
+    m_sprite->set_action(action(POSE_CLIMBING));
   }
   else if (m_backflipping) {
-    m_sprite->set_action(sa_prefix+"-backflip"+sa_postfix);
+    m_sprite->set_action(action(POSE_BACKFLIP));
   }
   else if (m_duck && is_big()) {
-    m_sprite->set_action(sa_prefix+"-duck"+sa_postfix);
+    m_sprite->set_action(action(POSE_DUCK));
   }
   else if (m_skidding_timer.started() && !m_skidding_timer.check()) {
-    m_sprite->set_action(sa_prefix+"-skid"+sa_postfix);
+    m_sprite->set_action(action(POSE_SKID));
   }
   else if (m_kick_timer.started() && !m_kick_timer.check()) {
-    m_sprite->set_action(sa_prefix+"-kick"+sa_postfix);
+    m_sprite->set_action(action(POSE_KICK));
   }
   else if ((m_wants_buttjump || m_does_buttjump) && is_big()) {
-    m_sprite->set_action(sa_prefix+"-buttjump"+sa_postfix, 1);
+    m_sprite->set_action(action(POSE_BUTTJUMP), 1);
   }
   else if (!on_ground() || m_fall_mode != ON_GROUND) {
     if (m_physic.get_velocity_x() != 0 || m_fall_mode != ON_GROUND) {
-        m_sprite->set_action(sa_prefix+"-jump"+sa_postfix);
+        m_sprite->set_action(action(POSE_JUMP));
     }
   }
   else {
@@ -1272,7 +1342,7 @@ Player::draw(DrawingContext& context)
         m_idle_stage = 0;
         m_idle_timer.start(static_cast<float>(IDLE_TIME[m_idle_stage]) / 1000.0f);
 
-        m_sprite->set_action_continued(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+        m_sprite->set_action_continued(action(IDLE_STAGES[m_idle_stage]));
       }
       else if (m_idle_timer.check() || (IDLE_TIME[m_idle_stage] == 0 && m_sprite->animation_done())) {
         m_idle_stage++;
@@ -1282,31 +1352,31 @@ Player::draw(DrawingContext& context)
         m_idle_timer.start(static_cast<float>(IDLE_TIME[m_idle_stage]) / 1000.0f);
 
         if (IDLE_TIME[m_idle_stage] == 0)
-          m_sprite->set_action(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix, 1);
+          m_sprite->set_action(action(IDLE_STAGES[m_idle_stage]), 1);
         else
-          m_sprite->set_action(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+          m_sprite->set_action(action(IDLE_STAGES[m_idle_stage]));
       }
       else {
-        m_sprite->set_action_continued(sa_prefix+("-" + IDLE_STAGES[m_idle_stage])+sa_postfix);
+        m_sprite->set_action_continued(action(IDLE_STAGES[m_idle_stage]));
       }
     }
     else {
       if (fabsf(m_physic.get_velocity_x()) > MAX_WALK_XM && !is_big()) {
-        m_sprite->set_action(sa_prefix+"-run"+sa_postfix);
+        m_sprite->set_action(action(POSE_RUN));
       } else {
-        m_sprite->set_action(sa_prefix+"-walk"+sa_postfix);
+        m_sprite->set_action(action(POSE_WALK));
       }
     }
   }
 
   /* Set Tux powerup sprite action */
   if (m_player_status.bonus == EARTH_BONUS) {
-    m_powersprite->set_action(m_sprite->get_action());
-    m_lightsprite->set_action(m_sprite->get_action());
+    m_powersprite->set_action(m_sprite->get_action_handle());
+    m_lightsprite->set_action(m_sprite->get_action_handle());
   } else if (m_player_status.bonus == AIR_BONUS) {
-    m_powersprite->set_action(m_sprite->get_action());
+    m_powersprite->set_action(m_sprite->get_action_handle());
   } else if (m_player_status.bonus == FIRE_BONUS && g_config->christmas_mode) {
-    m_powersprite->set_action(m_sprite->get_action());
+    m_powersprite->set_action(m_sprite->get_action_handle());
   }
 
   /*
@@ -16,9 +16,11 @@
 
 #include "object/tilemap.hpp"
 
-#include <tuple>
+#include <algorithm>
 
+#include "collision/collision_system.hpp"
 #include "editor/editor.hpp"
+#include "supertux/constants.hpp"
 #include "supertux/debug.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/sector.hpp"
@@ -31,12 +33,42 @@
 #include "video/layer.hpp"
 #include "video/surface.hpp"
 
+const int TileMap::CHUNK_SIZE;
+
+namespace {
+
+/** Tiles can go into the same batch if their surfaces only differ in
+    the region of the texture they show, like the tiles cut from one
+    tileset image or packed into one atlas page */
+bool same_texture(const Surface& lhs, const Surface& rhs)
+{
+  return (lhs.get_texture() == rhs.get_texture() &&
+          lhs.get_displacement_texture() == rhs.get_displacement_texture() &&
+          lhs.get_flip() == rhs.get_flip());
+}
+
+/** Quads of animated tiles collected for a single frame */
+struct FrameBatch
+{
+  SurfacePtr surface;
+  std::vector<Rectf> srcrects;
+  std::vector<Rectf> dstrects;
+};
+
+} // namespace
+
 TileMap::TileMap(const TileSet *new_tileset) :
   ExposedObject<TileMap, scripting::TileMap>(this),
   PathObject(),
   m_editor_active(true),
   m_tileset(new_tileset),
   m_tiles(),
+  m_collision_cells(),
+  m_collision_spans(),
+  m_collision_system(nullptr),
+  m_chunks(),
+  m_chunks_width(0),
+  m_chunks_height(0),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -45,6 +77,7 @@ TileMap::TileMap(const TileSet *new_tileset) :
   m_height(0),
   m_z_pos(0),
   m_offset(Vector(0,0)),
+  m_previous_offset(0.0f, 0.0f),
   m_movement(0,0),
   m_flip(NO_FLIP),
   m_alpha(1.0),
@@ -70,6 +103,12 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_editor_active(true),
   m_tileset(tileset_),
   m_tiles(),
+  m_collision_cells(),
+  m_collision_spans(),
+  m_collision_system(nullptr),
+  m_chunks(),
+  m_chunks_width(0),
+  m_chunks_height(0),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -78,6 +117,7 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_height(-1),
   m_z_pos(0),
   m_offset(Vector(0,0)),
+  m_previous_offset(0.0f, 0.0f),
   m_movement(Vector(0,0)),
   m_flip(NO_FLIP),
   m_alpha(1.0),
@@ -177,6 +217,8 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   {
     log_info << "Tilemap '" << get_name() << "', z-pos '" << m_z_pos << "' is empty." << std::endl;
   }
+
+  update_collision_cells();
 }
 
 void
@@ -186,6 +228,7 @@ TileMap::finish_construction()
     Vector v = get_path()->get_base();
     set_offset(v);
   }
+  m_previous_offset = m_offset;
 
   m_add_path = get_walker() && get_path() && get_path()->is_valid();
 }
@@ -272,6 +315,8 @@ TileMap::after_editor_set()
 
   m_current_tint = m_tint;
   m_current_alpha = m_alpha;
+
+  collision_changed();
 }
 
 void
@@ -282,6 +327,7 @@ TileMap::update(float dt_sec)
     m_remaining_fade_time = std::max(0.0f, m_remaining_fade_time - dt_sec);
     if (m_remaining_fade_time == 0.0f) {
       m_current_alpha = m_alpha;
+      collision_changed();
     } else {
       float_channel(m_alpha, m_current_alpha, m_remaining_fade_time, dt_sec);
     }
@@ -356,48 +402,77 @@ TileMap::draw(DrawingContext& context)
 
   Rectf draw_rect = context.get_cliprect();
   Rect t_draw_rect = get_tiles_overlapping(draw_rect);
-  Vector start = get_tile_position(t_draw_rect.left, t_draw_rect.top);
 
-  Vector pos;
-  int tx, ty;
+  Canvas& canvas = context.get_canvas(m_draw_target);
+  const bool editor = Editor::is_active();
 
-  std::unordered_map<SurfacePtr,
-                     std::tuple<std::vector<Rectf>,
-                                std::vector<Rectf>>> batches;
+  if (m_chunks.empty())
+  {
+    m_chunks_width = (m_width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunks_height = (m_height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunks.resize(m_chunks_width * m_chunks_height);
+  }
 
-  for (pos.x = start.x, tx = t_draw_rect.left; tx < t_draw_rect.right; pos.x += 32, ++tx) {
-    for (pos.y = start.y, ty = t_draw_rect.top; ty < t_draw_rect.bottom; pos.y += 32, ++ty) {
-      int index = ty*m_width + tx;
-      assert (index >= 0);
-      assert (index < (m_width * m_height));
+  std::vector<FrameBatch> batches;
 
-      if (m_tiles[index] == 0) continue;
-      const Tile& tile = m_tileset->get(m_tiles[index]);
+  if (t_draw_rect.left < t_draw_rect.right && t_draw_rect.top < t_draw_rect.bottom)
+  {
+    const int cx_begin = t_draw_rect.left / CHUNK_SIZE;
+    const int cx_end = (t_draw_rect.right + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int cy_begin = t_draw_rect.top / CHUNK_SIZE;
+    const int cy_end = (t_draw_rect.bottom + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    for (int cy = cy_begin; cy < cy_end; ++cy) {
+      for (int cx = cx_begin; cx < cx_end; ++cx) {
+        Chunk& chunk = m_chunks[cy * m_chunks_width + cx];
+        if (chunk.dirty || chunk.editor != editor) {
+          update_chunk(chunk, cx, cy, editor);
+        }
 
-      if (g_debug.show_collision_rects) {
-        tile.draw_debug(context.color(), pos, LAYER_FOREGROUND1);
-      }
+        for (const auto& chunk_batch : chunk.batches) {
+          canvas.draw_static_batch(chunk_batch->surface, chunk_batch->batch,
+                                   0, chunk_batch->batch.size(), m_offset,
+                                   m_current_tint, m_z_pos);
+        }
 
-      const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
-      if (surface) {
-        std::get<0>(batches[surface]).emplace_back(surface->get_region());
-        std::get<1>(batches[surface]).emplace_back(pos,
-                                                   Sizef(static_cast<float>(surface->get_width()),
-                                                         static_cast<float>(surface->get_height())));
+        // animated tiles change their surface over time, so they are
+        // batched anew every frame
+        for (const auto& index : chunk.animated_tiles) {
+          const Tile& tile = m_tileset->get(m_tiles[index]);
+          const SurfacePtr& surface = editor ? tile.get_current_editor_surface() : tile.get_current_surface();
+          if (!surface) continue;
+
+          auto it = std::find_if(batches.begin(), batches.end(),
+                                 [&surface](const FrameBatch& b) {
+                                   return same_texture(*b.surface, *surface);
+                                 });
+          if (it == batches.end()) {
+            batches.push_back(FrameBatch{surface, {}, {}});
+            it = batches.end() - 1;
+          }
+          it->srcrects.emplace_back(surface->get_region());
+          it->dstrects.emplace_back(get_tile_position(index % m_width, index / m_width),
+                                    Sizef(static_cast<float>(surface->get_width()),
+                                          static_cast<float>(surface->get_height())));
+        }
       }
     }
   }
 
-  Canvas& canvas = context.get_canvas(m_draw_target);
-
-  for (auto& it : batches)
+  for (const auto& batch : batches)
   {
-    const SurfacePtr& surface = it.first;
-    if (surface) {
-      canvas.draw_surface_batch(surface,
-                                std::move(std::get<0>(it.second)),
-                                std::move(std::get<1>(it.second)),
-                                m_current_tint, m_z_pos);
+    canvas.draw_surface_batch(batch.surface, batch.srcrects, batch.dstrects,
+                              m_current_tint, m_z_pos);
+  }
+
+  if (g_debug.show_collision_rects) {
+    for (int tx = t_draw_rect.left; tx < t_draw_rect.right; ++tx) {
+      for (int ty = t_draw_rect.top; ty < t_draw_rect.bottom; ++ty) {
+        const uint32_t id = m_tiles[ty * m_width + tx];
+        if (id != 0) {
+          m_tileset->get(id).draw_debug(context.color(), get_tile_position(tx, ty), LAYER_FOREGROUND1);
+        }
+      }
     }
   }
 
@@ -448,6 +523,8 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
   // make sure all tiles are loaded
   for (const auto& tile : m_tiles)
     m_tileset->get(tile);
+
+  update_collision_cells();
 }
 
 void
@@ -497,6 +574,8 @@ TileMap::resize(int new_width, int new_height, int fill_id,
       }
     }
   }
+
+  update_collision_cells();
 }
 
 void TileMap::resize(const Size& newsize, const Size& resize_offset) {
@@ -560,6 +639,15 @@ TileMap::change(int x, int y, uint32_t newtile)
 {
   assert(x >= 0 && x < m_width && y >= 0 && y < m_height);
   m_tiles[y*m_width + x] = newtile;
+  if (!m_chunks.empty())
+    m_chunks[(y / CHUNK_SIZE) * m_chunks_width + x / CHUNK_SIZE].dirty = true;
+
+  const Tile& tile = m_tileset->get(newtile);
+  m_collision_cells[y*m_width + x] = { tile.get_attributes(), tile.get_data() };
+  update_collision_span(x);
+
+  if (m_collision_system)
+    m_collision_system->tile_changed(*this, x, y);
 }
 
 void
@@ -587,6 +675,7 @@ TileMap::fade(float alpha_, float seconds)
 {
   m_alpha = alpha_;
   m_remaining_fade_time = seconds;
+  collision_changed();
 }
 
 void
@@ -603,6 +692,7 @@ TileMap::set_alpha(float alpha_)
   m_current_alpha = m_alpha;
   m_remaining_fade_time = 0;
   update_effective_solid ();
+  collision_changed();
 }
 
 float
@@ -620,6 +710,33 @@ TileMap::move_by(const Vector& shift)
   }
   get_path()->move_by(shift);
   m_offset += shift;
+  collision_changed();
+}
+
+void
+TileMap::set_offset(const Vector &offset_)
+{
+  if (offset_ != m_offset) {
+    m_offset = offset_;
+    collision_changed();
+  }
+}
+
+Vector
+TileMap::get_draw_offset(float alpha) const
+{
+  const Vector delta = m_offset - m_previous_offset;
+  if (delta.norm() > MAX_INTERPOLATION_DISTANCE) {
+    return m_offset;
+  }
+  return m_previous_offset + delta * alpha;
+}
+
+void
+TileMap::set_flip(Flip flip)
+{
+  m_flip = flip;
+  collision_changed();
 }
 
 void
@@ -637,6 +754,118 @@ void
 TileMap::set_tileset(const TileSet* new_tileset)
 {
   m_tileset = new_tileset;
+  update_collision_cells();
+}
+
+void
+TileMap::reset_chunks()
+{
+  m_chunks.clear();
+  m_chunks_width = 0;
+  m_chunks_height = 0;
+}
+
+void
+TileMap::update_chunk(Chunk& chunk, int cx, int cy, bool editor)
+{
+  // batches are reused, so that a renderer can update its copy
+  // instead of creating a new one
+  for (auto& chunk_batch : chunk.batches) {
+    chunk_batch->batch.clear();
+  }
+  chunk.animated_tiles.clear();
+
+  const int x_end = std::min(m_width, (cx + 1) * CHUNK_SIZE);
+  const int y_end = std::min(m_height, (cy + 1) * CHUNK_SIZE);
+
+  ChunkBatch* chunk_batch = nullptr;
+  for (int y = cy * CHUNK_SIZE; y < y_end; ++y) {
+    for (int x = cx * CHUNK_SIZE; x < x_end; ++x) {
+      const int index = y * m_width + x;
+      if (m_tiles[index] == 0) continue;
+
+      const Tile& tile = m_tileset->get(m_tiles[index]);
+      if (editor ? tile.is_editor_animated() : tile.is_animated()) {
+        chunk.animated_tiles.push_back(index);
+        continue;
+      }
+
+      const SurfacePtr surface = editor ? tile.get_current_editor_surface() : tile.get_current_surface();
+      if (!surface) continue;
+
+      // every tile has a surface of its own, but most of them share
+      // the texture with their neighbors and only differ in the region
+      if (!chunk_batch || !same_texture(*chunk_batch->surface, *surface)) {
+        auto it = std::find_if(chunk.batches.begin(), chunk.batches.end(),
+                               [&surface](const std::unique_ptr<ChunkBatch>& b) {
+                                 return same_texture(*b->surface, *surface);
+                               });
+        if (it == chunk.batches.end()) {
+          chunk.batches.emplace_back(new ChunkBatch(surface));
+          chunk_batch = chunk.batches.back().get();
+        } else {
+          chunk_batch = it->get();
+        }
+      }
+
+      chunk_batch->batch.add(surface->get_region(),
+                             Rectf(Vector(static_cast<float>(x), static_cast<float>(y)) * 32.0f,
+                                   Sizef(static_cast<float>(surface->get_width()),
+                                         static_cast<float>(surface->get_height()))));
+    }
+  }
+
+  chunk.batches.erase(std::remove_if(chunk.batches.begin(), chunk.batches.end(),
+                                     [](const std::unique_ptr<ChunkBatch>& b) {
+                                       return b->batch.empty();
+                                     }),
+                      chunk.batches.end());
+
+  chunk.dirty = false;
+  chunk.editor = editor;
+}
+
+void
+TileMap::update_collision_cells()
+{
+  // every change of m_tiles other than change() ends up here
+  reset_chunks();
+
+  m_collision_cells.resize(m_tiles.size());
+  for (size_t i = 0; i < m_tiles.size(); ++i) {
+    const Tile& tile = m_tileset->get(m_tiles[i]);
+    m_collision_cells[i] = { tile.get_attributes(), tile.get_data() };
+  }
+
+  m_collision_spans.resize(std::max(0, m_width));
+  for (int x = 0; x < m_width; ++x) {
+    update_collision_span(x);
+  }
+
+  collision_changed();
+}
+
+void
+TileMap::update_collision_span(int x)
+{
+  int top = 0;
+  while (top < m_height && m_collision_cells[top * m_width + x].attributes == 0) {
+    ++top;
+  }
+
+  int bottom = m_height;
+  while (bottom > top && m_collision_cells[(bottom - 1) * m_width + x].attributes == 0) {
+    --bottom;
+  }
+
+  m_collision_spans[x] = std::make_pair(top, bottom);
+}
+
+void
+TileMap::collision_changed()
+{
+  if (m_collision_system)
+    m_collision_system->tilemap_changed(*this);
 }
 
 /* EOF */
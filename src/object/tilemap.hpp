@@ -18,6 +18,9 @@
 #define HEADER_SUPERTUX_OBJECT_TILEMAP_HPP
 
 #include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "math/rect.hpp"
 #include "math/rectf.hpp"
@@ -30,7 +33,10 @@
 #include "video/color.hpp"
 #include "video/flip.hpp"
 #include "video/drawing_target.hpp"
+#include "video/static_batch.hpp"
+#include "video/surface_ptr.hpp"
 
+class CollisionSystem;
 class DrawingContext;
 class Tile;
 class TileSet;
@@ -41,6 +47,16 @@ class TileMap final :
   public ExposedObject<TileMap, scripting::TileMap>,
   public PathObject
 {
+public:
+  /** Collision relevant part of a Tile, kept for every cell so that
+      the collision code can scan a tilemap without going through the
+      TileSet for each tile */
+  struct CollisionCell
+  {
+    uint32_t attributes;
+    int data;
+  };
+
 public:
   TileMap(const TileSet *tileset);
   TileMap(const TileSet *tileset, const ReaderMapping& reader);
@@ -58,6 +74,9 @@ public:
   virtual void update(float dt_sec) override;
   virtual void draw(DrawingContext& context) override;
 
+  virtual void save_previous_state() override { m_previous_offset = m_offset; }
+  virtual Vector get_draw_shift(float alpha) const override { return get_draw_offset(alpha) - m_offset; }
+
   virtual void editor_update() override;
 
   /** Move tilemap until at given node, then stop */
@@ -82,9 +101,13 @@ public:
   int get_height() const { return m_height; }
   Size get_size() const { return Size(m_width, m_height); }
 
-  void set_offset(const Vector &offset_) { m_offset = offset_; }
+  void set_offset(const Vector &offset_);
   Vector get_offset() const { return m_offset; }
 
+  /** Offset alpha (0.0 to 1.0) of the way from the one before the
+      last update() to the current one */
+  Vector get_draw_offset(float alpha) const;
+
   void move_by(const Vector& pos);
 
   /** Get the movement of this tilemap. The collision detection code
@@ -130,6 +153,23 @@ public:
 
   const Tile& get_tile(int x, int y) const;
   const Tile& get_tile_at(const Vector& pos) const;
+
+  /** Returns the attributes and data of tile (x, y), which must be
+      inside the tilemap */
+  const CollisionCell& get_collision_cell(int x, int y) const
+  { return m_collision_cells[y * m_width + x]; }
+
+  /** Returns the half-open range of rows in column x that contain
+      tiles with attributes, everything outside of it can be skipped
+      by the collision code. The range is empty for empty columns. */
+  const std::pair<int, int>& get_collision_span(int x) const
+  { return m_collision_spans[x]; }
+
+  /** Set by the CollisionSystem when it merges this tilemap with
+      others, changes to the tiles or the geometry are then reported
+      back to it */
+  void set_collision_system(CollisionSystem* collision_system) { m_collision_system = collision_system; }
+
   uint32_t get_tile_id(int x, int y) const;
   uint32_t get_tile_id_at(const Vector& pos) const;
 
@@ -140,15 +180,7 @@ public:
   /** changes all tiles with the given ID */
   void change_all(uint32_t oldtile, uint32_t newtile);
 
-  void draw_rects_update_enabled(bool enabled)
-  {
-      draw_rects_update = enabled;
-      if (enabled) {
-          calculateDrawRects(true);
-      }
-  }
-
-  void set_flip(Flip flip) { m_flip = flip; }
+  void set_flip(Flip flip);
   Flip get_flip() const { return m_flip; }
 
   /** Start fading the tilemap to opacity given by @c alpha.
@@ -156,6 +188,9 @@ public:
       Also influences solidity. */
   void fade(float alpha, float seconds = 0);
 
+  /** Returns true while the opacity is still changing */
+  bool is_fading() const { return m_current_alpha != m_alpha; }
+
   /** Start fading the tilemap to tint given by RGBA.
       Destination opacity will be reached after @c seconds seconds. Doesn't influence solidity. */
   void tint_fade(const Color& new_tint, float seconds = 0);
@@ -175,8 +210,22 @@ public:
 private:
   void update_effective_solid();
   void float_channel(float target, float &current, float remaining_time, float dt_sec);
-  void calculateDrawRects(bool useCache = false);
-  void calculateDrawRects(uint32_t oldtile, uint32_t newtile);
+
+  /** Rebuilds m_collision_cells and m_collision_spans from m_tiles */
+  void update_collision_cells();
+  void update_collision_span(int x);
+
+  /** Tells the CollisionSystem that a merged copy of the collision
+      cells is out of date */
+  void collision_changed();
+
+  struct Chunk;
+
+  /** Throws away all chunks, they get recreated on the next draw() */
+  void reset_chunks();
+
+  /** Rebuilds the batches of the dirty chunk at (cx, cy) */
+  void update_chunk(Chunk& chunk, int cx, int cy, bool editor);
 
 public:
   bool m_editor_active;
@@ -185,11 +234,60 @@ private:
   const TileSet* m_tileset;
 
   typedef std::vector<uint32_t> Tiles;
-  typedef std::vector<unsigned char> TilesDrawRects;
-
   Tiles m_tiles;
-  TilesDrawRects tiles_draw_rects; /**< Tiles draw cache, with adjacent tiles merged into big rectangles */
-  bool draw_rects_update;
+
+  /** Attributes of the tiles in m_tiles, same layout */
+  std::vector<CollisionCell> m_collision_cells;
+
+  /** Rows with attributes per column, see get_collision_span() */
+  std::vector<std::pair<int, int> > m_collision_spans;
+
+  CollisionSystem* m_collision_system;
+
+  /** Side length of a chunk in tiles */
+  static const int CHUNK_SIZE = 16;
+
+  /** Quads of the non-animated tiles of a chunk that share a texture,
+      each quad shows the region of its own tile */
+  struct ChunkBatch
+  {
+    ChunkBatch(const SurfacePtr& surface_) :
+      surface(surface_),
+      batch()
+    {}
+
+    /** The first tile surface of the batch, it provides the texture */
+    SurfacePtr surface;
+    StaticBatch batch;
+  };
+
+  /** Prebuilt draw data of CHUNK_SIZE x CHUNK_SIZE tiles, only the
+      chunks that are visible get drawn and only dirty ones rebuilt */
+  struct Chunk
+  {
+    Chunk() :
+      batches(),
+      animated_tiles(),
+      dirty(true),
+      editor(false)
+    {}
+
+    std::vector<std::unique_ptr<ChunkBatch> > batches;
+
+    /** Indices into m_tiles of the animated tiles, they get drawn
+        every frame */
+    std::vector<int> animated_tiles;
+
+    bool dirty;
+
+    /** True if built from the editor surfaces of the tiles */
+    bool editor;
+  };
+
+  /** Row major, empty until the next draw() after reset_chunks() */
+  std::vector<Chunk> m_chunks;
+  int m_chunks_width;
+  int m_chunks_height;
 
   /* read solid: In *general*, is this a solid layer? effective solid:
      is the layer *currently* solid? A generally solid layer may be
@@ -203,6 +301,7 @@ private:
   int m_height;
   int m_z_pos;
   Vector m_offset;
+  Vector m_previous_offset; /**< m_offset before the last update(), see get_draw_offset() */
   Vector m_movement; /**< The movement that happened last frame */
 
   Flip m_flip;
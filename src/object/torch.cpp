@@ -39,8 +39,8 @@ Torch::Torch(const ReaderMapping& reader) :
   reader.get("burning", m_burning, true);
 
   m_torch = SpriteManager::current()->create(sprite_name);
-  m_col.m_bbox.set_size(static_cast<float>(m_torch->get_width()),
-                static_cast<float>(m_torch->get_height()));
+  m_col.set_size(static_cast<float>(m_torch->get_width()),
+                 static_cast<float>(m_torch->get_height()));
   m_flame_glow->set_blend(Blend::ADD);
   m_flame_light->set_blend(Blend::ADD);
   set_group(COLGROUP_TOUCHABLE);
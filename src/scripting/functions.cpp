@@ -181,6 +181,11 @@ void debug_show_fps(bool enable)
   g_config->show_fps = enable;
 }
 
+void debug_show_texture_memory(bool enable)
+{
+  g_debug.show_texture_memory = enable;
+}
+
 void debug_draw_solids_only(bool enable)
 {
   ::Sector::s_draw_solids_only = enable;
@@ -287,6 +292,11 @@ void whereami()
   log_info << "You are at x " << (static_cast<int>(tux.get_pos().x)) << ", y " << (static_cast<int>(tux.get_pos().y)) << std::endl;
 }
 
+void sound_stats()
+{
+  SoundManager::current()->print_stats();
+}
+
 void gotoend()
 {
   if (!validate_sector_player()) return;
@@ -83,6 +83,9 @@ void debug_collrects(bool enable);
 /** enable/disable drawing of fps */
 void debug_show_fps(bool enable);
 
+/** enable/disable drawing of texture memory usage */
+void debug_show_texture_memory(bool enable);
+
 /** enable/disable drawing of non-solid layers */
 void debug_draw_solids_only(bool enable);
 
@@ -119,6 +122,9 @@ void restart();
 /** print Tux's current coordinates in a level */
 void whereami();
 
+/** print how many audio sources are in use and how many sounds got dropped */
+void sound_stats();
+
 /** move Tux near the end of the level */
 void gotoend();
 
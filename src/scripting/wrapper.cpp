@@ -5819,6 +5819,29 @@ static SQInteger debug_show_fps_wrapper(HSQUIRRELVM vm)
 
 }
 
+static SQInteger debug_show_texture_memory_wrapper(HSQUIRRELVM vm)
+{
+  SQBool arg0;
+  if(SQ_FAILED(sq_getbool(vm, 2, &arg0))) {
+    sq_throwerror(vm, _SC("Argument 1 not a bool"));
+    return SQ_ERROR;
+  }
+
+  try {
+    scripting::debug_show_texture_memory(arg0 == SQTrue);
+
+    return 0;
+
+  } catch(std::exception& e) {
+    sq_throwerror(vm, e.what());
+    return SQ_ERROR;
+  } catch(...) {
+    sq_throwerror(vm, _SC("Unexpected exception while executing function 'debug_show_texture_memory'"));
+    return SQ_ERROR;
+  }
+
+}
+
 static SQInteger debug_draw_solids_only_wrapper(HSQUIRRELVM vm)
 {
   SQBool arg0;
@@ -6071,6 +6094,25 @@ static SQInteger whereami_wrapper(HSQUIRRELVM vm)
 
 }
 
+static SQInteger sound_stats_wrapper(HSQUIRRELVM vm)
+{
+  (void) vm;
+
+  try {
+    scripting::sound_stats();
+
+    return 0;
+
+  } catch(std::exception& e) {
+    sq_throwerror(vm, e.what());
+    return SQ_ERROR;
+  } catch(...) {
+    sq_throwerror(vm, _SC("Unexpected exception while executing function 'sound_stats'"));
+    return SQ_ERROR;
+  }
+
+}
+
 static SQInteger gotoend_wrapper(HSQUIRRELVM vm)
 {
   (void) vm;
@@ -7127,6 +7169,13 @@ void register_supertux_wrapper(HSQUIRRELVM v)
     throw SquirrelError(v, "Couldn't register function 'debug_show_fps'");
   }
 
+  sq_pushstring(v, "debug_show_texture_memory", -1);
+  sq_newclosure(v, &debug_show_texture_memory_wrapper, 0);
+  sq_setparamscheck(v, SQ_MATCHTYPEMASKSTRING, "x|tb");
+  if(SQ_FAILED(sq_createslot(v, -3))) {
+    throw SquirrelError(v, "Couldn't register function 'debug_show_texture_memory'");
+  }
+
   sq_pushstring(v, "debug_draw_solids_only", -1);
   sq_newclosure(v, &debug_draw_solids_only_wrapper, 0);
   sq_setparamscheck(v, SQ_MATCHTYPEMASKSTRING, "x|tb");
@@ -7211,6 +7260,13 @@ void register_supertux_wrapper(HSQUIRRELVM v)
     throw SquirrelError(v, "Couldn't register function 'whereami'");
   }
 
+  sq_pushstring(v, "sound_stats", -1);
+  sq_newclosure(v, &sound_stats_wrapper, 0);
+  sq_setparamscheck(v, SQ_MATCHTYPEMASKSTRING, "x|t");
+  if(SQ_FAILED(sq_createslot(v, -3))) {
+    throw SquirrelError(v, "Couldn't register function 'sound_stats'");
+  }
+
   sq_pushstring(v, "gotoend", -1);
   sq_newclosure(v, &gotoend_wrapper, 0);
   sq_setparamscheck(v, SQ_MATCHTYPEMASKSTRING, "x|t");
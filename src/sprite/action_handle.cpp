@@ -0,0 +1,70 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "sprite/action_handle.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+struct ActionNames
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, int> ids;
+
+  /** Indexed by id, a deque keeps references handed out by
+      get_name() valid while new names get added */
+  std::deque<std::string> names;
+};
+
+ActionNames& get_action_names()
+{
+  static ActionNames action_names;
+  return action_names;
+}
+
+} // namespace
+
+ActionHandle::ActionHandle(const std::string& name) :
+  m_id()
+{
+  auto& action_names = get_action_names();
+  std::lock_guard<std::mutex> lock(action_names.mutex);
+
+  auto it = action_names.ids.find(name);
+  if (it == action_names.ids.end())
+  {
+    it = action_names.ids.emplace(name, static_cast<int>(action_names.names.size())).first;
+    action_names.names.push_back(name);
+  }
+  m_id = it->second;
+}
+
+const std::string&
+ActionHandle::get_name() const
+{
+  static const std::string invalid;
+  if (m_id < 0)
+    return invalid;
+
+  auto& action_names = get_action_names();
+  std::lock_guard<std::mutex> lock(action_names.mutex);
+  return action_names.names[m_id];
+}
+
+/* EOF */
@@ -0,0 +1,47 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SPRITE_ACTION_HANDLE_HPP
+#define HEADER_SUPERTUX_SPRITE_ACTION_HANDLE_HPP
+
+#include <string>
+
+/** Interned name of a sprite action. The ids are shared by all
+    sprites, so a handle selects the equally named action of whatever
+    sprite it is passed to. Objects create their handles once and hand
+    them to Sprite::set_action() instead of building strings in their
+    update loops. */
+class ActionHandle final
+{
+public:
+  /** An invalid handle that matches no action */
+  ActionHandle() : m_id(-1) {}
+  explicit ActionHandle(const std::string& name);
+
+  bool is_valid() const { return m_id >= 0; }
+  int get_id() const { return m_id; }
+  const std::string& get_name() const;
+
+  bool operator==(const ActionHandle& other) const { return m_id == other.m_id; }
+  bool operator!=(const ActionHandle& other) const { return m_id != other.m_id; }
+
+private:
+  int m_id;
+};
+
+#endif
+
+/* EOF */
@@ -61,9 +61,31 @@ Sprite::clone() const
   return SpritePtr(new Sprite(*this));
 }
 
+void
+Sprite::set_action(const ActionHandle& action, int loops)
+{
+  if (m_action && m_action->handle == action)
+    return;
+
+  const SpriteData::Action* newaction = m_data.get_action(action);
+  if (!newaction) {
+    log_debug << "Action '" << action.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  m_action = newaction;
+  // If the new action has a loops property,
+  // we prefer that over the parameter.
+  m_animation_loops = newaction->has_custom_loops ? newaction->loops : loops;
+  m_frame = 0;
+  m_frameidx = 0;
+}
+
 void
 Sprite::set_action(const std::string& name, int loops)
 {
+  // compare and look up by name, interning it here would lock the
+  // global name table on every call
   if (m_action && m_action->name == name)
     return;
 
@@ -74,13 +96,27 @@ Sprite::set_action(const std::string& name, int loops)
   }
 
   m_action = newaction;
-  // If the new action has a loops property,
-  // we prefer that over the parameter.
   m_animation_loops = newaction->has_custom_loops ? newaction->loops : loops;
   m_frame = 0;
   m_frameidx = 0;
 }
 
+void
+Sprite::set_action_continued(const ActionHandle& action)
+{
+  if (m_action && m_action->handle == action)
+    return;
+
+  const SpriteData::Action* newaction = m_data.get_action(action);
+  if (!newaction) {
+    log_debug << "Action '" << action.get_name() << "' not found." << std::endl;
+    return;
+  }
+
+  m_action = newaction;
+  update();
+}
+
 void
 Sprite::set_action_continued(const std::string& name)
 {
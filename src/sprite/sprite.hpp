@@ -35,9 +35,11 @@ public:
             Flip flip = NO_FLIP);
 
   /** Set action (or state) */
+  void set_action(const ActionHandle& action, int loops = -1);
   void set_action(const std::string& name, int loops = -1);
 
   /** Set action (or state), but keep current frame number, loop counter, etc. */
+  void set_action_continued(const ActionHandle& action);
   void set_action_continued(const std::string& name);
 
   /** Set number of animation cycles until animation stops */
@@ -60,6 +62,7 @@ public:
 
   /** Get current action name */
   const std::string& get_action() const { return m_action->name; }
+  const ActionHandle& get_action_handle() const { return m_action->handle; }
 
   int get_width() const;
   int get_height() const;
@@ -88,6 +91,7 @@ public:
   Blend get_blend() const;
 
   bool has_action (const std::string& name) const { return (m_data.get_action(name) != nullptr); }
+  bool has_action (const ActionHandle& action) const { return (m_data.get_action(action) != nullptr); }
 
 private:
   void update();
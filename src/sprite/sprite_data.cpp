@@ -27,9 +27,11 @@
 #include "util/reader_mapping.hpp"
 #include "util/reader_object.hpp"
 #include "video/surface.hpp"
+#include "video/texture_manager.hpp"
 
 SpriteData::Action::Action() :
   name(),
+  handle(),
   x_offset(0),
   y_offset(0),
   hitbox_w(0),
@@ -43,8 +45,21 @@ SpriteData::Action::Action() :
 
 SpriteData::SpriteData(const ReaderMapping& mapping) :
   actions(),
+  action_index(),
   name()
 {
+  // let the frames of all actions decode in parallel
+  auto prefetch_iter = mapping.get_iter();
+  while (prefetch_iter.next()) {
+    std::vector<std::string> images;
+    if (prefetch_iter.get_key() == "action" &&
+        prefetch_iter.as_mapping().get("images", images)) {
+      for (const auto& image : images) {
+        TextureManager::current()->prefetch(FileSystem::join(mapping.get_doc().get_directory(), image));
+      }
+    }
+  }
+
   auto iter = mapping.get_iter();
   while (iter.next()) {
     if (iter.get_key() == "name") {
@@ -178,6 +193,18 @@ SpriteData::parse_action(const ReaderMapping& mapping)
       throw std::runtime_error(msg.str());
     }
   }
+  action->handle = ActionHandle(action->name);
+
+  const int id = action->handle.get_id();
+  auto it = std::lower_bound(action_index.begin(), action_index.end(), id,
+                             [](const std::pair<int, const Action*>& entry, int key) {
+                               return entry.first < key;
+                             });
+  if (it != action_index.end() && it->first == id)
+    it->second = action.get();
+  else
+    action_index.insert(it, std::make_pair(id, action.get()));
+
   actions[action->name] = std::move(action);
 }
 
@@ -191,4 +218,18 @@ SpriteData::get_action(const std::string& act) const
   return i->second.get();
 }
 
+const SpriteData::Action*
+SpriteData::get_action(const ActionHandle& handle) const
+{
+  const int id = handle.get_id();
+  auto it = std::lower_bound(action_index.begin(), action_index.end(), id,
+                             [](const std::pair<int, const Action*>& entry, int key) {
+                               return entry.first < key;
+                             });
+  if (it == action_index.end() || it->first != id) {
+    return nullptr;
+  }
+  return it->second;
+}
+
 /* EOF */
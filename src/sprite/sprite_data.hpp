@@ -19,8 +19,10 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "sprite/action_handle.hpp"
 #include "video/surface_ptr.hpp"
 
 class ReaderMapping;
@@ -44,6 +46,7 @@ private:
     Action();
 
     std::string name;
+    ActionHandle handle;
 
     /** Position correction */
     float x_offset;
@@ -73,8 +76,14 @@ private:
   void parse_action(const ReaderMapping& mapping);
   /** Get an action */
   const Action* get_action(const std::string& act) const;
+  const Action* get_action(const ActionHandle& handle) const;
 
   Actions actions;
+
+  /** This sprite's actions sorted by the id of their ActionHandle,
+      only as large as the sprite's own action list */
+  std::vector<std::pair<int, const Action*> > action_index;
+
   std::string name;
 };
 
@@ -17,6 +17,7 @@
 #include "sprite/sprite_manager.hpp"
 
 #include "sprite/sprite.hpp"
+#include "supertux/level_manifest.hpp"
 #include "util/file_system.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
@@ -35,6 +36,10 @@ SpriteManager::create(const std::string& name)
   Sprites::iterator i = sprites.find(name);
   SpriteData* data;
   if (i == sprites.end()) {
+    if (LevelManifest::current()) {
+      LevelManifest::current()->report_load(name);
+    }
+
     // try loading the spritefile
     data = load(name);
     if (data == nullptr) {
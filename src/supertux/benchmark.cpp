@@ -0,0 +1,280 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/benchmark.hpp"
+
+#include <boost/format.hpp>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <physfs.h>
+#include <sexp/value.hpp>
+#include <stdexcept>
+
+#include "audio/openal_sound_source.hpp"
+#include "audio/sound_manager.hpp"
+#include "audio/wav_sound_file.hpp"
+#include "control/controller.hpp"
+#include "physfs/util.hpp"
+#include "supertux/game_session.hpp"
+#include "supertux/globals.hpp"
+#include "supertux/screen_manager.hpp"
+#include "util/file_system.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+
+namespace {
+
+void find_documents(const std::string& path, std::vector<std::string>& filenames)
+{
+  if (!physfsutil::is_directory(path))
+  {
+    filenames.push_back(path);
+    return;
+  }
+
+  std::unique_ptr<char*, decltype(&PHYSFS_freeList)>
+    files(PHYSFS_enumerateFiles(path.c_str()),
+          PHYSFS_freeList);
+  for (char** i = files.get(); *i != nullptr; ++i)
+  {
+    const std::string filename = FileSystem::join(path, *i);
+    if (physfsutil::is_directory(filename) ||
+        StringUtil::has_suffix(filename, ".stl") ||
+        StringUtil::has_suffix(filename, ".stwm"))
+    {
+      find_documents(filename, filenames);
+    }
+  }
+}
+
+struct MappingEntry
+{
+  const ReaderDocument* doc;
+  const sexp::Value* sx;
+  std::vector<std::string> keys;
+};
+
+/** Collects every (name (key value)...) list below sx */
+void find_mappings(const ReaderDocument& doc, const sexp::Value& sx, std::vector<MappingEntry>& mappings)
+{
+  if (!sx.is_array())
+  {
+    return;
+  }
+
+  const auto& arr = sx.as_array();
+  if (arr.size() >= 2 && arr[0].is_symbol())
+  {
+    std::vector<std::string> keys;
+    for (size_t i = 1; i < arr.size(); ++i)
+    {
+      if (!arr[i].is_array() || arr[i].as_array().empty() || !arr[i].as_array()[0].is_symbol())
+      {
+        keys.clear();
+        break;
+      }
+      keys.push_back(arr[i].as_array()[0].as_string());
+    }
+
+    if (!keys.empty())
+    {
+      mappings.push_back(MappingEntry{&doc, &sx, std::move(keys)});
+    }
+  }
+
+  for (const auto& item : arr)
+  {
+    find_mappings(doc, item, mappings);
+  }
+}
+
+} // namespace
+
+void
+Benchmark::run_reader(const std::vector<std::string>& paths, int passes, std::ostream& out)
+{
+  std::vector<std::string> filenames;
+  for (const auto& path : paths)
+  {
+    find_documents(path, filenames);
+  }
+
+  std::vector<std::unique_ptr<ReaderDocument> > docs;
+  std::vector<MappingEntry> mappings;
+  for (const auto& filename : filenames)
+  {
+    docs.push_back(std::make_unique<ReaderDocument>(ReaderDocument::from_file(filename)));
+    find_mappings(*docs.back(), docs.back()->get_sexp(), mappings);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+
+  size_t lookups = 0;
+  size_t found = 0;
+  for (int pass = 0; pass < passes; ++pass)
+  {
+    for (const auto& entry : mappings)
+    {
+      // a fresh mapping each time, like a newly constructed object
+      ReaderMapping mapping(*entry.doc, *entry.sx);
+      boost::optional<ReaderMapping> value;
+      for (const auto& key : entry.keys)
+      {
+        found += mapping.get(key.c_str(), value);
+      }
+      found += mapping.get("no-such-key", value);
+      lookups += entry.keys.size() + 1;
+    }
+  }
+
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  out << boost::format("files:      %d\n") % filenames.size();
+  out << boost::format("mappings:   %d\n") % mappings.size();
+  out << boost::format("lookups:    %d in %.3f s, %.1f ns/lookup\n")
+    % lookups % seconds % (lookups ? seconds * 1.0e9 / static_cast<double>(lookups) : 0.0);
+  out << boost::format("found:      %d\n") % found;
+  out << std::flush;
+}
+
+void
+Benchmark::run_audio(const std::vector<std::string>& filenames, int voices,
+                     const std::string& wav_filename, std::ostream& out)
+{
+  SoundManager sound_manager(SoundManager::OUTPUT_LOOPBACK);
+  if (!sound_manager.is_audio_enabled())
+  {
+    throw std::runtime_error("Couldn't open the software mixer");
+  }
+
+  std::vector<std::unique_ptr<SoundSource> > sources;
+  int mixed = 0;
+  for (int i = 0; i < voices; ++i)
+  {
+    auto source = sound_manager.create_sound_source(filenames[i % filenames.size()]);
+    // out of sources or the file didn't load
+    if (dynamic_cast<OpenALSoundSource*>(source.get()) != nullptr)
+    {
+      mixed += 1;
+    }
+    source->set_looping(true);
+    source->play();
+    sources.push_back(std::move(source));
+  }
+
+  // one game frame per chunk
+  const size_t chunk_frames = SoundManager::LOOPBACK_RATE / 50;
+  const size_t chunks = 10 * 50;
+
+  std::vector<int16_t> samples(2 * chunk_frames * (wav_filename.empty() ? 1 : chunks));
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < chunks; ++i)
+  {
+    sound_manager.update();
+    const size_t offset = wav_filename.empty() ? 0 : 2 * chunk_frames * i;
+    sound_manager.render(samples.data() + offset, chunk_frames);
+  }
+
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const double audio_seconds = static_cast<double>(chunks * chunk_frames) / SoundManager::LOOPBACK_RATE;
+
+  if (!wav_filename.empty())
+  {
+    std::ofstream wav(wav_filename, std::ios::binary);
+    WavSoundFile::write(wav, samples.data(), chunks * chunk_frames, 2, SoundManager::LOOPBACK_RATE);
+    if (!wav)
+    {
+      throw std::runtime_error("Couldn't write " + wav_filename);
+    }
+  }
+
+  out << boost::format("voices:     %d of %d\n") % mixed % voices;
+  out << boost::format("mixed:      %.1f s of audio in %.3f s, %.1fx realtime\n")
+    % audio_seconds % seconds % (seconds > 0.0 ? audio_seconds / seconds : 0.0);
+  out << boost::format("throughput: %.1f voices/sec\n")
+    % (seconds > 0.0 ? mixed * audio_seconds / seconds : 0.0);
+  out << std::flush;
+}
+
+Benchmark::Benchmark(GameSession& session) :
+  m_session(session),
+  m_ticks(0),
+  m_total_time(0.0),
+  m_profile()
+{
+}
+
+void
+Benchmark::run(int ticks, float dt_sec)
+{
+  // the demo feeds the player, nobody presses the menu keys
+  const Controller controller;
+
+  Sector::set_update_profile(&m_profile);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  int tick = 0;
+  for (; tick < ticks && !m_session.has_ended(); ++tick)
+  {
+    // the same steps as ScreenManager::run()
+    float timestep = dt_sec;
+    g_real_time += timestep;
+    timestep *= ScreenManager::current()->get_speed();
+    g_game_time += timestep;
+
+    m_session.update(timestep, controller);
+  }
+
+  m_ticks += tick;
+  m_total_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  Sector::set_update_profile(nullptr);
+}
+
+void
+Benchmark::print_report(std::ostream& out) const
+{
+  if (m_ticks == 0 || m_total_time <= 0.0)
+  {
+    out << "no ticks simulated" << std::endl;
+    return;
+  }
+
+  out << boost::format("ticks:      %d in %.3f s, %.1f ticks/sec\n")
+    % m_ticks % m_total_time % (m_ticks / m_total_time);
+
+  const auto phase = [this, &out](const char* name, double seconds) {
+    out << boost::format("%-11s %8.4f ms/tick %5.1f%%\n")
+      % name
+      % (seconds * 1000.0 / m_ticks)
+      % (seconds * 100.0 / m_total_time);
+  };
+
+  phase("scripts:", m_profile.scripts);
+  phase("objects:", m_profile.objects);
+  phase("collision:", m_profile.collision);
+  phase("flush:", m_profile.flush);
+  phase("other:", m_total_time - m_profile.scripts - m_profile.objects -
+        m_profile.collision - m_profile.flush);
+  out << std::flush;
+}
+
+/* EOF */
@@ -0,0 +1,70 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+#define HEADER_SUPERTUX_SUPERTUX_BENCHMARK_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "supertux/sector.hpp"
+
+class GameSession;
+
+/** Steps a GameSession at a fixed rate as fast as possible, without
+    drawing anything, and measures how long the simulation takes.
+    Input comes from the demo played by the session, if any, so runs
+    are reproducible. */
+class Benchmark final
+{
+public:
+  /** Looks up every key of every mapping in the given files and
+      directories, plus one that is missing, the way object
+      constructors query their options, and reports the time taken */
+  static void run_reader(const std::vector<std::string>& filenames, int passes, std::ostream& out);
+
+  /** Plays the given sound files on voices looping sources, taking
+      turns, mixes ten seconds of them in software and reports how
+      many voices got mixed per second. The mix is written to
+      wav_filename unless that is empty. */
+  static void run_audio(const std::vector<std::string>& filenames, int voices,
+                        const std::string& wav_filename, std::ostream& out);
+
+public:
+  Benchmark(GameSession& session);
+
+  /** Advances the game clocks and updates the session by dt_sec
+      ticks times, or until the session ends */
+  void run(int ticks, float dt_sec);
+
+  void print_report(std::ostream& out) const;
+
+private:
+  GameSession& m_session;
+
+  int m_ticks;
+  double m_total_time;
+  Sector::UpdateProfile m_profile;
+
+private:
+  Benchmark(const Benchmark&) = delete;
+  Benchmark& operator=(const Benchmark&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -50,7 +50,14 @@ CommandLineArguments::CommandLineArguments() :
   christmas_mode(),
   repository_url(),
   editor(),
-  resave()
+  resave(),
+  rebuild_cache(),
+  bench_ticks(),
+  bench_reader(),
+  bench_passes(),
+  bench_audio(),
+  bench_voices(),
+  bench_wav()
 {
 }
 
@@ -108,9 +115,18 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("  --record-demo FILE LEVEL     Record a demo to FILE") << "\n"
     << _("  --play-demo FILE LEVEL       Play a recorded demo") << "\n"
     << "\n"
+    << _("Benchmark Options:") << "\n"
+    << _("  --bench-ticks N              Number of ticks to simulate in supertux2-bench") << "\n"
+    << _("  --bench-reader               Time key lookups in the given files or directories") << "\n"
+    << _("  --bench-passes N             Number of lookup passes of --bench-reader (default: 100)") << "\n"
+    << _("  --bench-audio                Mix looping voices of the given sound files") << "\n"
+    << _("  --bench-voices N             Number of voices mixed by --bench-audio (default: 16)") << "\n"
+    << _("  --bench-wav FILE             Write the mix of --bench-audio to FILE") << "\n"
+    << "\n"
     << _("Directory Options:") << "\n"
     << _("  --datadir DIR                Set the directory for the games datafiles") << "\n"
     << _("  --userdir DIR                Set the directory for user data (savegames, etc.)") << "\n"
+    << _("  --rebuild-cache              Discard the cache of parsed level, sprite and tileset files") << "\n"
     << "\n"
     << _("Add-On Options:") << "\n"
     << _("  --repository-url URL         Set the URL to the Add-On repository") << "\n"
@@ -375,6 +391,65 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       resave = true;
     }
+    else if (arg == "--rebuild-cache")
+    {
+      rebuild_cache = true;
+    }
+    else if (arg == "--bench-ticks")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify the number of ticks");
+      else
+      {
+        int ticks;
+        if (sscanf(argv[i], "%9d", &ticks) != 1 || ticks <= 0)
+          throw std::runtime_error("Invalid number of ticks");
+        bench_ticks = ticks;
+      }
+    }
+    else if (arg == "--bench-reader")
+    {
+      bench_reader = true;
+    }
+    else if (arg == "--bench-passes")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify the number of passes");
+      else
+      {
+        int passes;
+        if (sscanf(argv[i], "%9d", &passes) != 1 || passes <= 0)
+          throw std::runtime_error("Invalid number of passes");
+        bench_passes = passes;
+      }
+    }
+    else if (arg == "--bench-audio")
+    {
+      bench_audio = true;
+    }
+    else if (arg == "--bench-voices")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("Need to specify the number of voices");
+      else
+      {
+        int voices;
+        if (sscanf(argv[i], "%9d", &voices) != 1 || voices <= 0)
+          throw std::runtime_error("Invalid number of voices");
+        bench_voices = voices;
+      }
+    }
+    else if (arg == "--bench-wav")
+    {
+      if (i + 1 >= argc)
+      {
+        throw std::runtime_error("Need to specify a wav filename");
+      }
+      else
+      {
+        bench_wav = argv[++i];
+      }
+    }
     else if (arg[0] != '-')
     {
       filenames.push_back(arg);
@@ -81,6 +81,27 @@ public:
   boost::optional<bool> editor;
   boost::optional<bool> resave;
 
+  /** Throw away the binary cache of parsed documents */
+  boost::optional<bool> rebuild_cache;
+
+  /** Number of simulation steps run by supertux2-bench */
+  boost::optional<int> bench_ticks;
+
+  /** Make supertux2-bench time ReaderMapping lookups instead */
+  boost::optional<bool> bench_reader;
+
+  /** Number of lookup passes of --bench-reader */
+  boost::optional<int> bench_passes;
+
+  /** Make supertux2-bench mix sounds in software instead */
+  boost::optional<bool> bench_audio;
+
+  /** Number of voices mixed by --bench-audio */
+  boost::optional<int> bench_voices;
+
+  /** File the mix of --bench-audio is written to */
+  boost::optional<std::string> bench_wav;
+
   // boost::optional<std::string> locale;
 
 public:
@@ -25,6 +25,11 @@ static const float LOGICAL_FPS = 64.0;
 // SHIFT_DELTA is used for sliding over 1-tile gaps and collision detection
 static const float SHIFT_DELTA = 7.0f;
 
+// Frames are drawn in between the last two logical frames. Objects and
+// the camera that moved further than this in a single logical frame were
+// teleported and are drawn at their new position right away.
+static const float MAX_INTERPOLATION_DISTANCE = 128.0f;
+
 #endif
 
 /* EOF */
@@ -37,6 +37,9 @@ public:
 
   bool show_controller;
 
+  /** Show the bytes held by cached images and textures */
+  bool show_texture_memory;
+
 private:
   /** Use old bitmap fonts instead of TTF */
   bool m_use_bitmap_fonts;
@@ -92,7 +92,6 @@ FlipLevelTransformer::transform_path(float height, float obj_height, Path& path)
 void
 FlipLevelTransformer::transform_tilemap(float height, TileMap& tilemap)
 {
-  tilemap.draw_rects_update_enabled(false);
   for (int x = 0; x < tilemap.get_width(); ++x) {
     for (int y = 0; y < tilemap.get_height()/2; ++y) {
       // swap tiles
@@ -110,7 +109,6 @@ FlipLevelTransformer::transform_tilemap(float height, TileMap& tilemap)
   auto path = tilemap.get_path();
   if (path)
     transform_path(height, tilemap.get_bbox().get_height(), *path);
-  tilemap.draw_rects_update_enabled(true);
 }
 
 void
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "editor/object_settings.hpp"
+#include "math/vector.hpp"
 #include "supertux/game_object_component.hpp"
 #include "util/gettext.hpp"
 #include "util/uid.hpp"
@@ -71,6 +72,15 @@ public:
       DrawingContext if this function is called. */
   virtual void draw(DrawingContext& context) = 0;
 
+  /** Called by the Sector before every update(), objects that move
+      remember where they are to be drawn in between two updates */
+  virtual void save_previous_state() {}
+
+  /** How far the object is to be drawn away from where draw() puts
+      it, alpha (0.0 to 1.0) of the way from the state before the last
+      update() to the current one */
+  virtual Vector get_draw_shift(float /*alpha*/) const { return Vector(0.0f, 0.0f); }
+
   /** This function saves the object. Editor will use that. */
   void save(Writer& writer);
   virtual std::string get_class() const { return "game-object"; }
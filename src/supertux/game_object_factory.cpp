@@ -133,6 +133,7 @@ GameObjectFactory::instance()
 GameObjectFactory::GameObjectFactory()
 {
   init_factories();
+  init_manifests();
 }
 
 void
@@ -264,6 +265,178 @@ GameObjectFactory::init_factories()
     });
 }
 
+void
+GameObjectFactory::init_manifests()
+{
+  // Resources that objects load on their own after the level was
+  // constructed, e.g. when they die, explode or spawn something. The
+  // spawns refer to other manifests by name, Dispenser and BonusBlock
+  // name their spawns in the level file, LevelManifest picks those up
+  // from there.
+
+  // badguys
+  add_manifest("angrystone", {"images/creatures/angrystone/angrystone.sprite"});
+  add_manifest("bouncingsnowball", {"images/creatures/bouncing_snowball/bouncing_snowball.sprite"});
+  add_manifest("captainsnowball", {"images/creatures/snowball/cpt-snowball.sprite"});
+  add_manifest("crystallo", {"images/creatures/crystallo/crystallo.sprite"});
+  add_manifest("dart", {"images/creatures/dart/dart.sprite",
+                        "sounds/darthit.wav", "sounds/flame.wav", "sounds/stomp.wav"});
+  add_manifest("darttrap", {"images/creatures/darttrap/darttrap.sprite", "sounds/dartfire.wav"},
+               {"dart"});
+  add_manifest("dispenser", {"images/creatures/dispenser/dispenser.sprite", "sounds/squish.wav"});
+  add_manifest("fish", {"images/creatures/fish/fish.sprite"});
+  add_manifest("flame", {"images/creatures/flame/flame.sprite",
+                         "images/objects/lightmap_light/lightmap_light-small.sprite",
+                         "images/objects/particles/smoke.sprite",
+                         "sounds/flame.wav", "sounds/sizzle.ogg"});
+  add_manifest("flyingsnowball", {"images/creatures/flying_snowball/flying_snowball.sprite",
+                                  "images/objects/particles/smoke.sprite"});
+  add_manifest("ghostflame", {"images/creatures/flame/ghostflame.sprite"});
+  add_manifest("ghosttree", {"images/creatures/ghosttree/ghosttree.sprite",
+                             "images/creatures/ghosttree/ghosttree-glow.sprite",
+                             "images/creatures/ghosttree/root.sprite",
+                             "images/creatures/ghosttree/root-base.sprite",
+                             "images/creatures/willowisp/willowisp.sprite",
+                             "sounds/tree_howling.ogg", "sounds/tree_suck.ogg", "sounds/willowisp.wav"},
+               {"lantern"});
+  add_manifest("goldbomb", {"images/creatures/gold_bomb/gold_bomb.sprite", "sounds/fizz.wav"},
+               {"explosion", "coin"});
+  add_manifest("haywire", {"images/creatures/haywire/haywire.sprite",
+                           "sounds/fizz.wav", "sounds/grunts.ogg"},
+               {"explosion"});
+  add_manifest("iceflame", {"images/creatures/flame/iceflame.sprite",
+                            "images/objects/particles/smoke.sprite", "sounds/sizzle.ogg"});
+  add_manifest("igel", {"images/creatures/igel/igel.sprite"});
+  add_manifest("jumpy", {"images/creatures/snowjumpy/snowjumpy.sprite", "sounds/skid.wav"});
+  add_manifest("kamikazesnowball", {"images/creatures/snowball/kamikaze-snowball.sprite", "sounds/splat.wav"});
+  add_manifest("kugelblitz", {"images/creatures/kugelblitz/kugelblitz.sprite",
+                              "images/objects/lightmap_light/lightmap_light.sprite",
+                              "sounds/lightning.wav"});
+  add_manifest("leafshot", {"images/creatures/leafshot/leafshot.sprite",
+                            "images/objects/particles/leafshot.sprite", "sounds/splat.wav"});
+  add_manifest("livefire", {"images/creatures/livefire/livefire.sprite",
+                            "images/objects/particles/smoke.sprite",
+                            "sounds/fall.wav", "sounds/sizzle.ogg"});
+  add_manifest("livefire_asleep", {}, {"livefire"});
+  add_manifest("livefire_dormant", {}, {"livefire"});
+  add_manifest("mole", {"images/creatures/mole/mole.sprite",
+                        "sounds/dartfire.wav", "sounds/fall.wav", "sounds/fire.ogg", "sounds/squish.wav"},
+               {"mole_rock"});
+  add_manifest("mole_rock", {"images/creatures/mole/mole_rock.sprite",
+                             "sounds/darthit.wav", "sounds/stomp.wav"});
+  add_manifest("mrbomb", {"images/creatures/mr_bomb/mr_bomb.sprite", "sounds/fizz.wav"},
+               {"explosion"});
+  add_manifest("mriceblock", {"images/creatures/mr_iceblock/mr_iceblock.sprite",
+                              "sounds/iceblock_bump.wav", "sounds/kick.wav", "sounds/stomp.wav"});
+  add_manifest("mrtree", {"images/creatures/mr_tree/mr_tree.sprite",
+                          "images/objects/lightmap_light/lightmap_light-large.sprite",
+                          "images/objects/particles/leaf.sprite", "sounds/mr_tree.ogg"},
+               {"poisonivy", "stumpy"});
+  add_manifest("owl", {"images/creatures/owl/owl.sprite", "sounds/fall.wav"});
+  add_manifest("plant", {"images/creatures/plant/plant.sprite"});
+  add_manifest("poisonivy", {"images/creatures/poison_ivy/poison_ivy.sprite",
+                             "images/objects/particles/poisonivy.sprite"});
+  add_manifest("short_fuse", {"images/creatures/short_fuse/short_fuse.sprite"}, {"explosion"});
+  add_manifest("sspiky", {"images/creatures/spiky/sleepingspiky.sprite"});
+  add_manifest("skydive", {"images/creatures/skydive/skydive.sprite"}, {"explosion"});
+  add_manifest("skullyhop", {"images/creatures/skullyhop/skullyhop.sprite", "sounds/hop.ogg"});
+  add_manifest("smartball", {"images/creatures/snowball/smart-snowball.sprite"});
+  add_manifest("smartblock", {"images/creatures/mr_iceblock/smart_block/smart_block.sprite"});
+  add_manifest("snail", {"images/creatures/snail/snail.sprite",
+                         "sounds/iceblock_bump.wav", "sounds/kick.wav", "sounds/stomp.wav"});
+  add_manifest("snowball", {"images/creatures/snowball/snowball.sprite"});
+  add_manifest("snowman", {"images/creatures/snowman/snowman.sprite", "sounds/pop.ogg"},
+               {"snowball"});
+  add_manifest("spidermite", {"images/creatures/spidermite/spidermite.sprite"});
+  add_manifest("spiky", {"images/creatures/spiky/spiky.sprite"});
+  add_manifest("stalactite", {"images/creatures/stalactite/stalactite.sprite",
+                              "sounds/cracking.wav", "sounds/icecrash.ogg", "sounds/sizzle.ogg"});
+  add_manifest("stumpy", {"images/creatures/mr_tree/stumpy.sprite",
+                          "images/objects/lightmap_light/lightmap_light-large.sprite",
+                          "images/objects/particles/bark.sprite", "sounds/mr_treehit.ogg"});
+  add_manifest("toad", {"images/creatures/toad/toad.sprite", "sounds/hop.ogg"});
+  add_manifest("totem", {"images/creatures/totem/totem.sprite", "sounds/totem.ogg"});
+  add_manifest("walking_candle", {"images/creatures/mr_candle/mr-candle.sprite"});
+  add_manifest("walkingleaf", {"images/creatures/walkingleaf/walkingleaf.sprite",
+                               "images/objects/particles/walkingleaf.sprite"});
+  add_manifest("willowisp", {"images/creatures/willowisp/willowisp.sprite",
+                             "images/objects/lightmap_light/lightmap_light-small.sprite",
+                             "sounds/warp.wav", "sounds/willowisp.wav"});
+  add_manifest("yeti", {"images/creatures/yeti/yeti.sprite", "images/creatures/yeti/hudlife.png",
+                        "images/objects/bullets/icebullet.sprite",
+                        "sounds/stomp.wav", "sounds/yeti_gna.wav", "sounds/yeti_roar.wav"},
+               {"yeti_stalactite"});
+  add_manifest("yeti_stalactite", {}, {"stalactite"});
+  add_manifest("zeekling", {"images/creatures/zeekling/zeekling.sprite"});
+
+  // other objects
+  add_manifest("bonusblock", {"images/objects/bonus_block/bonusblock.sprite",
+                              "sounds/brick.wav", "sounds/switch.ogg", "sounds/upgrade.wav"},
+               {"coin", "powerup", "rock", "trampoline"});
+  add_manifest("brick", {"images/objects/bonus_block/brick.sprite", "sounds/brick.wav"}, {"coin"});
+  add_manifest("candle", {"images/objects/candle/candle.sprite",
+                          "images/objects/candle/candle-light-1.sprite",
+                          "images/objects/candle/candle-light-2.sprite",
+                          "images/objects/particles/smoke.sprite"});
+  add_manifest("coin", {"images/objects/coin/coin.sprite", "sounds/coin.wav", "sounds/coin2.ogg"});
+  add_manifest("explosion", {"images/objects/explosion/explosion.sprite",
+                             "images/objects/lightmap_light/lightmap_light-large.sprite",
+                             "sounds/explosion.wav", "sounds/firecracker.ogg"});
+  add_manifest("firefly", {"images/objects/resetpoints/default-resetpoint.sprite",
+                           "images/objects/lightmap_light/lightmap_light-small.sprite",
+                           "images/objects/particles/reset.sprite",
+                           "sounds/fire.ogg", "sounds/savebell2.wav", "sounds/savebell_low.wav"});
+  add_manifest("heavycoin", {}, {"coin"});
+  add_manifest("icecrusher", {"images/creatures/icecrusher/icecrusher.sprite",
+                              "sounds/brick.wav", "sounds/thud.ogg"});
+  add_manifest("infoblock", {"images/objects/bonus_block/infoblock.sprite", "sounds/phone.wav"});
+  add_manifest("invisible_block", {"images/objects/bonus_block/invisibleblock.sprite", "sounds/brick.wav"});
+  add_manifest("lantern", {"images/objects/lantern/lantern.sprite",
+                           "images/objects/lightmap_light/lightmap_light.sprite",
+                           "sounds/willocatch.wav"});
+  add_manifest("powerup", {"images/powerups/1up/1up.sprite",
+                           "images/powerups/airflower/airflower.sprite",
+                           "images/powerups/earthflower/earthflower.sprite",
+                           "images/powerups/egg/egg.sprite",
+                           "images/powerups/fireflower/fireflower.sprite",
+                           "images/powerups/iceflower/iceflower.sprite",
+                           "images/powerups/potions/blue-potion.sprite",
+                           "images/powerups/potions/red-potion.sprite",
+                           "images/powerups/star/star.sprite",
+                           "images/objects/lightmap_light/lightmap_light-small.sprite",
+                           "images/objects/particles/sparkle.sprite",
+                           "sounds/fire-flower.wav", "sounds/grow.ogg", "sounds/gulp.wav"});
+  add_manifest("pushbutton", {"images/objects/pushbutton/pushbutton.sprite", "sounds/switch.ogg"});
+  add_manifest("rock", {"images/objects/rock/rock.sprite", "sounds/brick.wav"});
+  add_manifest("thunderstorm", {"sounds/lightning.wav", "sounds/thunder.wav"});
+  add_manifest("trampoline", {"images/objects/trampoline/trampoline.sprite",
+                              "images/objects/trampoline/trampoline_fix.sprite",
+                              "sounds/trampoline.wav"});
+  add_manifest("rustytrampoline", {"images/objects/rusty-trampoline/rusty-trampoline.sprite",
+                                   "sounds/trampoline.wav"});
+  add_manifest("weak_block", {"images/objects/weak_block/meltbox.sprite",
+                              "images/objects/weak_block/strawbox.sprite",
+                              "images/objects/lightmap_light/lightmap_light-small.sprite",
+                              "images/objects/lightmap_light/lightmap_light-tiny.sprite",
+                              "sounds/fire.ogg", "sounds/sizzle.ogg"});
+
+  // trigger
+  add_manifest("door", {"images/objects/door/door.sprite", "sounds/door.wav"});
+  add_manifest("switch", {"images/objects/switch/left.sprite", "sounds/switch.ogg"});
+
+  // not created by the factory, but present in every level
+  add_manifest("player", {"images/creatures/tux/tux.sprite",
+                          "images/creatures/tux/powerups.sprite",
+                          "images/creatures/tux/light.sprite",
+                          "images/objects/bullets/firebullet.sprite",
+                          "images/objects/bullets/icebullet.sprite",
+                          "images/objects/particles/sparkle.sprite",
+                          "sounds/bigjump.wav", "sounds/flip.wav", "sounds/grow.wav",
+                          "sounds/hurt.wav", "sounds/invincible_start.ogg", "sounds/jump.wav",
+                          "sounds/kill.wav", "sounds/shoot.wav", "sounds/skid.wav",
+                          "sounds/splash.wav"});
+}
+
 std::unique_ptr<GameObject>
 GameObjectFactory::create(const std::string& name, const Vector& pos, const Direction& dir, const std::string& data) const
 {
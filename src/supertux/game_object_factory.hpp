@@ -36,6 +36,7 @@ private:
   GameObjectFactory();
 
   void init_factories();
+  void init_manifests();
 
 private:
   GameObjectFactory(const GameObjectFactory&) = delete;
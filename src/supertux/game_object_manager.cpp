@@ -20,6 +20,7 @@
 #include <algorithm>
 
 #include "object/tilemap.hpp"
+#include "video/drawing_context.hpp"
 
 bool GameObjectManager::s_draw_solids_only = false;
 
@@ -28,6 +29,7 @@ GameObjectManager::GameObjectManager() :
   m_gameobjects(),
   m_gameobjects_new(),
   m_solid_tilemaps(),
+  m_solid_tilemaps_revision(0),
   m_objects_by_name(),
   m_objects_by_uid(),
   m_objects_by_type_index(),
@@ -122,7 +124,7 @@ GameObjectManager::update(float dt_sec)
 }
 
 void
-GameObjectManager::draw(DrawingContext& context)
+GameObjectManager::draw(DrawingContext& context, float alpha)
 {
   for (const auto& object : m_gameobjects)
   {
@@ -136,7 +138,20 @@ GameObjectManager::draw(DrawingContext& context)
         continue;
     }
 
-    object->draw(context);
+    const Vector shift = alpha < 1.0f ? object->get_draw_shift(alpha) : Vector(0.0f, 0.0f);
+    if (shift == Vector(0.0f, 0.0f))
+    {
+      object->draw(context);
+    }
+    else
+    {
+      // the object draws itself where it is, moving the view the other
+      // way puts it where it is drawn in this frame
+      context.push_transform();
+      context.set_translation(context.get_translation() - shift);
+      object->draw(context);
+      context.pop_transform();
+    }
   }
 }
 
@@ -176,12 +191,17 @@ GameObjectManager::flush_game_objects()
   }
 
   { // update solid_tilemaps list
-    m_solid_tilemaps.clear();
+    std::vector<TileMap*> solid_tilemaps;
     for (const auto& obj : m_gameobjects)
     {
       const auto& tm = dynamic_cast<TileMap*>(obj.get());
       if (!tm) continue;
-      if (tm->is_solid()) m_solid_tilemaps.push_back(tm);
+      if (tm->is_solid()) solid_tilemaps.push_back(tm);
+    }
+
+    if (solid_tilemaps != m_solid_tilemaps) {
+      m_solid_tilemaps = std::move(solid_tilemaps);
+      m_solid_tilemaps_revision += 1;
     }
   }
 }
@@ -202,8 +222,18 @@ GameObjectManager::this_before_object_add(GameObject& object)
     m_objects_by_uid[object.get_uid()] = &object;
   }
 
+  const std::type_index type_idx(typeid(object));
+
   { // by_type_index
-    m_objects_by_type_index[std::type_index(typeid(object))].push_back(&object);
+    m_objects_by_type_index[type_idx].push_back(&object);
+  }
+
+  { // solid_tilemaps, a new tilemap might reuse the address of a removed one,
+    // TileMap is final so its exact type is enough
+    if (type_idx == std::type_index(typeid(TileMap)))
+    {
+      m_solid_tilemaps_revision += 1;
+    }
   }
 }
 
@@ -222,12 +252,21 @@ GameObjectManager::this_before_object_remove(GameObject& object)
     m_objects_by_uid.erase(object.get_uid());
   }
 
+  const std::type_index type_idx(typeid(object));
+
   { // by_type_index
-    auto& vec = m_objects_by_type_index[std::type_index(typeid(object))];
+    auto& vec = m_objects_by_type_index[type_idx];
     auto it = std::find(vec.begin(), vec.end(), &object);
     assert(it != vec.end());
     vec.erase(it);
   }
+
+  { // solid_tilemaps
+    if (type_idx == std::type_index(typeid(TileMap)))
+    {
+      m_solid_tilemaps_revision += 1;
+    }
+  }
 }
 
 float
@@ -19,6 +19,7 @@
 #define HEADER_SUPERTUX_SUPERTUX_GAME_OBJECT_MANAGER_HPP
 
 #include <functional>
+#include <stdint.h>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
@@ -61,7 +62,11 @@ public:
   }
 
   void update(float dt_sec);
-  void draw(DrawingContext& context);
+
+  /** Draws the objects alpha (0.0 to 1.0) of the way from their state
+      before the last update() to the current one, see
+      GameObject::get_draw_shift() */
+  void draw(DrawingContext& context, float alpha = 1.0f);
 
   const std::vector<std::unique_ptr<GameObject> >& get_objects() const;
 
@@ -178,6 +183,9 @@ public:
 
   const std::vector<TileMap*>& get_solid_tilemaps() const { return m_solid_tilemaps; }
 
+  /** Incremented whenever the list of solid tilemaps changes */
+  uint32_t get_solid_tilemaps_revision() const { return m_solid_tilemaps_revision; }
+
 protected:
   void process_resolve_requests();
 
@@ -206,6 +214,7 @@ private:
 
   /** Fast access to solid tilemaps */
   std::vector<TileMap*> m_solid_tilemaps;
+  uint32_t m_solid_tilemaps_revision;
 
   std::unordered_map<std::string, GameObject*> m_objects_by_name;
   std::unordered_map<UID, GameObject*> m_objects_by_uid;
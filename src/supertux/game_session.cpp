@@ -29,6 +29,7 @@
 #include "supertux/fadetoblack.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_manifest.hpp"
 #include "supertux/level_parser.hpp"
 #include "supertux/levelintro.hpp"
 #include "supertux/levelset_screen.hpp"
@@ -38,22 +39,27 @@
 #include "supertux/sector.hpp"
 #include "supertux/levelsavestate.hpp"
 #include "util/file_system.hpp"
+#include "util/reader_document.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
 #include "worldmap/worldmap.hpp"
 
-GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics) :
+GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Statistics* statistics,
+                         bool preload_resources) :
   GameSessionRecorder(),
   reset_button(false),
   m_level(),
   m_old_level(),
+  m_manifest(),
+  m_preload_resources(preload_resources),
   m_statistics_backdrop(Surface::from_file("images/engine/menu/score-backdrop.png")),
   m_scripts(),
   m_currentsector(nullptr),
   m_end_sequence(nullptr),
   m_game_pause(false),
   m_speed_before_pause(ScreenManager::current()->get_speed()),
+  m_sector_updated(false),
   m_levelfile(levelfile_),
   m_reset_sector(),
   m_reset_pos(),
@@ -80,6 +86,10 @@ GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Stat
     throw std::runtime_error ("Initializing the level failed.");
 }
 
+GameSession::~GameSession()
+{
+}
+
 void
 GameSession::reset_level()
 {
@@ -107,6 +117,7 @@ GameSession::restart_level(bool after_death)
   }
 
   m_game_pause   = false;
+  m_sector_updated = false;
   m_end_sequence = nullptr;
 
   InputManager::current()->reset();
@@ -120,7 +131,12 @@ GameSession::restart_level(bool after_death)
 
   try {
     m_old_level = std::move(m_level);
-    m_level = LevelParser::from_file(m_levelfile, false, false);
+    auto doc = ReaderDocument::from_file(m_levelfile);
+    m_level = LevelParser::from_document(doc, false, false);
+
+    if (!m_manifest && m_preload_resources) {
+      m_manifest = LevelManifest::from_document(doc);
+    }
 
     if (!m_reset_sector.empty()) {
       m_currentsector = m_level->get_sector(m_reset_sector);
@@ -252,14 +268,14 @@ GameSession::check_end_conditions()
 }
 
 void
-GameSession::draw(Compositor& compositor)
+GameSession::draw(Compositor& compositor, float alpha)
 {
   if (!m_currentsector)
     return;
 
   auto& context = compositor.make_context();
 
-  m_currentsector->draw(context);
+  m_currentsector->draw(context, m_sector_updated ? alpha : 1.0f);
   drawstatus(context);
 
   if (m_game_pause)
@@ -290,7 +306,12 @@ GameSession::setup()
   if ((!m_levelintro_shown) && (total_stats_to_be_collected > 0)) {
     m_levelintro_shown = true;
     m_active = false;
-    ScreenManager::current()->push_screen(std::make_unique<LevelIntro>(*m_level, m_best_level_statistics, m_savegame.get_player_status()));
+    ScreenManager::current()->push_screen(std::make_unique<LevelIntro>(*m_level, m_best_level_statistics, m_savegame.get_player_status(),
+                                                                       m_manifest.get()));
+  }
+  else if (m_manifest) {
+    // whatever the intro didn't get to is loaded before the level starts
+    m_manifest->preload();
   }
   ScreenManager::current()->set_screen_fade(std::make_unique<FadeToBlack>(FadeToBlack::FADEIN, 1));
   m_end_seq_started = false;
@@ -377,15 +398,18 @@ GameSession::update(float dt_sec, const Controller& controller)
   }
 
   // Update the world state and all objects in the world
+  m_sector_updated = false;
   if (!m_game_pause) {
     // Update the world
     if (!m_end_sequence) {
       m_play_time += dt_sec; //TODO: make sure we don't count cutscene time
       m_level->m_stats.finish(m_play_time);
       m_currentsector->update(dt_sec);
+      m_sector_updated = true;
     } else {
       if (!m_end_sequence->is_tux_stopped()) {
         m_currentsector->update(dt_sec);
+        m_sector_updated = true;
       } else {
         m_end_sequence->update(dt_sec);
       }
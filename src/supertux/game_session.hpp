@@ -33,6 +33,7 @@ class CodeController;
 class DrawingContext;
 class EndSequence;
 class Level;
+class LevelManifest;
 class Sector;
 class Statistics;
 class Savegame;
@@ -43,9 +44,14 @@ class GameSession final : public Screen,
                           public Currenton<GameSession>
 {
 public:
-  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr);
-
-  virtual void draw(Compositor& compositor) override;
+  /** preload_resources builds the level's LevelManifest, sessions
+      that never show the level intro, like the title screen's, go
+      without */
+  GameSession(const std::string& levelfile, Savegame& savegame, Statistics* statistics = nullptr,
+              bool preload_resources = true);
+  virtual ~GameSession();
+
+  virtual void draw(Compositor& compositor, float alpha) override;
   virtual void update(float dt_sec, const Controller& controller) override;
   virtual void setup() override;
   virtual void leave() override;
@@ -77,6 +83,10 @@ public:
   void abort_level();
   bool is_active() const;
 
+  /** Whether the level was finished or couldn't be (re)loaded, the
+      session has asked to be popped off the screen stack then */
+  bool has_ended() const { return m_end_seq_started || !m_currentsector; }
+
   /** Enters or leaves level editor mode */
   void set_editmode(bool edit_mode = true);
 
@@ -96,6 +106,8 @@ private:
 private:
   std::unique_ptr<Level> m_level;
   std::unique_ptr<Level> m_old_level;
+  std::unique_ptr<LevelManifest> m_manifest;
+  bool m_preload_resources;
   SurfacePtr m_statistics_backdrop;
 
   // scripts
@@ -109,6 +121,10 @@ private:
   bool  m_game_pause;
   float m_speed_before_pause;
 
+  /** Whether the last update() moved the current sector along, only
+      then is it drawn in between its last two states */
+  bool  m_sector_updated;
+
   std::string m_levelfile;
 
   // reset point (the point where tux respawns if he dies)
@@ -33,12 +33,15 @@ Config::Config() :
   use_fullscreen(true),
   video(VideoSystem::VIDEO_AUTO),
   try_vsync(true),
+  use_texture_atlas(true),
+  texture_memory_budget(256),
   show_fps(false),
   show_player_pos(false),
   sound_enabled(true),
   music_enabled(true),
   sound_volume(50),
   music_volume(50),
+  sound_cache_budget(16),
   random_seed(0), // set by time(), by default (unless in config)
   enable_script_debugger(false),
   start_demo(),
@@ -94,6 +97,8 @@ Config::load()
     config_video_mapping->get("video", video_string);
     video = VideoSystem::get_video_system(video_string);
     config_video_mapping->get("vsync", try_vsync);
+    config_video_mapping->get("texture_atlas", use_texture_atlas);
+    config_video_mapping->get("texture_memory_budget", texture_memory_budget);
 
     config_video_mapping->get("fullscreen_width",  fullscreen_size.width);
     config_video_mapping->get("fullscreen_height", fullscreen_size.height);
@@ -123,6 +128,7 @@ Config::load()
     config_audio_mapping->get("music_enabled", music_enabled);
     config_audio_mapping->get("sound_volume", sound_volume);
     config_audio_mapping->get("music_volume", music_volume);
+    config_audio_mapping->get("sound_cache_budget", sound_cache_budget);
   }
 
   boost::optional<ReaderMapping> config_control_mapping;
@@ -195,6 +201,8 @@ Config::save()
     writer.write("video", VideoSystem::get_video_string(video));
   }
   writer.write("vsync", try_vsync);
+  writer.write("texture_atlas", use_texture_atlas);
+  writer.write("texture_memory_budget", texture_memory_budget);
 
   writer.write("fullscreen_width",  fullscreen_size.width);
   writer.write("fullscreen_height", fullscreen_size.height);
@@ -217,6 +225,7 @@ Config::save()
   writer.write("music_enabled", music_enabled);
   writer.write("sound_volume", sound_volume);
   writer.write("music_volume", music_volume);
+  writer.write("sound_cache_budget", sound_cache_budget);
   writer.end_list("audio");
 
   writer.start_list("control");
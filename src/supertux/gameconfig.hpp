@@ -57,6 +57,14 @@ public:
   bool use_fullscreen;
   VideoSystem::Enum video;
   bool try_vsync;
+
+  /** pack small images into shared textures, see TextureManager */
+  bool use_texture_atlas;
+
+  /** MiB that decoded images kept for further uploads may take
+      before the least recently used get dropped, 0 for no limit */
+  int texture_memory_budget;
+
   bool show_fps;
   bool show_player_pos;
   bool sound_enabled;
@@ -64,6 +72,9 @@ public:
   int sound_volume;
   int music_volume;
 
+  /** MiB of decoded sound effects to keep around */
+  int sound_cache_budget;
+
   /** initial random seed.  0 ==> set from time() */
   int random_seed;
 
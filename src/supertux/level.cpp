@@ -53,9 +53,10 @@ Level::~Level()
 }
 
 void
-Level::save(std::ostream& stream)
+Level::save(std::ostream& stream, bool rle_tiles)
 {
   Writer writer(stream);
+  writer.set_rle_tiles(rle_tiles);
   save(writer);
 }
 
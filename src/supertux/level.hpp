@@ -42,7 +42,9 @@ public:
 
   // saves to a levelfile
   void save(const std::string& filename, bool retry = false);
-  void save(std::ostream& stream);
+  /** rle_tiles shrinks tilemaps in a way only this version can read,
+      see Writer::set_rle_tiles() */
+  void save(std::ostream& stream, bool rle_tiles = false);
 
   void add_sector(std::unique_ptr<Sector> sector);
   const std::string& get_name() const { return m_name; }
@@ -0,0 +1,196 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/level_manifest.hpp"
+
+#include <chrono>
+#include <sexp/value.hpp>
+
+#include "audio/sound_manager.hpp"
+#include "sprite/sprite.hpp"
+#include "sprite/sprite_manager.hpp"
+#include "supertux/game_object_factory.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_object.hpp"
+#include "util/string_util.hpp"
+#include "video/surface.hpp"
+
+namespace {
+
+bool is_sprite(const std::string& filename)
+{
+  return StringUtil::has_suffix(filename, ".sprite");
+}
+
+bool is_image(const std::string& filename)
+{
+  return (StringUtil::has_suffix(filename, ".png") ||
+          StringUtil::has_suffix(filename, ".jpg"));
+}
+
+bool is_sound(const std::string& filename)
+{
+  return (StringUtil::has_suffix(filename, ".wav") ||
+          StringUtil::has_suffix(filename, ".ogg"));
+}
+
+} // namespace
+
+std::unique_ptr<LevelManifest>
+LevelManifest::from_document(const ReaderDocument& doc)
+{
+  auto manifest = std::make_unique<LevelManifest>(doc.get_filename());
+  manifest->add_object("player");
+  manifest->scan(doc.get_root().get_sexp());
+
+  log_debug << "manifest of '" << doc.get_filename() << "': " << manifest->size() << " files" << std::endl;
+
+  return manifest;
+}
+
+LevelManifest::LevelManifest(const std::string& levelfile) :
+  m_levelfile(levelfile),
+  m_basedir(FileSystem::dirname(levelfile)),
+  m_resources(),
+  m_pending(),
+  m_next(0),
+  m_images(),
+  m_misses()
+{
+}
+
+LevelManifest::~LevelManifest()
+{
+  if (!m_misses.empty())
+  {
+    log_info << "manifest of '" << m_levelfile << "' missed " << m_misses.size() << " files" << std::endl;
+  }
+}
+
+void
+LevelManifest::scan(const sexp::Value& sx)
+{
+  if (sx.is_array())
+  {
+    for (const auto& item : sx.as_array())
+    {
+      scan(item);
+    }
+  }
+  else if (sx.is_symbol() || sx.is_string())
+  {
+    // symbols are object types, strings can be files or the names of
+    // objects that get spawned later, e.g. the badguys of a Dispenser
+    const std::string& text = sx.as_string();
+    if (GameObjectFactory::instance().has_manifest(text))
+    {
+      add_object(text);
+    }
+    else if (sx.is_string())
+    {
+      add_resource(text);
+    }
+  }
+}
+
+void
+LevelManifest::add_object(const std::string& name)
+{
+  std::set<std::string> resources;
+  GameObjectFactory::instance().get_resources(name, resources);
+  for (const auto& resource : resources)
+  {
+    add_resource(resource);
+  }
+}
+
+void
+LevelManifest::add_resource(const std::string& filename)
+{
+  if (!is_sprite(filename) && !is_image(filename) && !is_sound(filename))
+    return;
+
+  // levels name some files relative to their own directory
+  std::string path = filename;
+  if (!FileSystem::exists(path))
+  {
+    path = FileSystem::join(m_basedir, filename);
+    if (!FileSystem::exists(path))
+      return;
+  }
+
+  if (m_resources.insert(path).second)
+  {
+    m_pending.push_back(path);
+  }
+}
+
+bool
+LevelManifest::preload(float budget)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  while (m_next < m_pending.size())
+  {
+    const std::string& filename = m_pending[m_next++];
+    try
+    {
+      if (is_sprite(filename))
+      {
+        SpriteManager::current()->create(filename);
+      }
+      else if (is_image(filename))
+      {
+        m_images.push_back(Surface::from_file(filename));
+      }
+      else if (SoundManager::current())
+      {
+        SoundManager::current()->preload(filename);
+      }
+    }
+    catch(const std::exception& err)
+    {
+      log_warning << "Couldn't preload '" << filename << "': " << err.what() << std::endl;
+    }
+
+    const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed.count() >= budget)
+      break;
+  }
+
+  return m_next >= m_pending.size();
+}
+
+void
+LevelManifest::report_load(const std::string& filename)
+{
+  // loads during level construction and preloading are expected
+  if (m_next < m_pending.size())
+    return;
+
+  if (m_resources.find(filename) != m_resources.end())
+    return;
+
+  if (m_misses.insert(filename).second)
+  {
+    log_warning << "'" << filename << "' loaded mid-level, missing from manifest of '"
+                << m_levelfile << "'" << std::endl;
+  }
+}
+
+/* EOF */
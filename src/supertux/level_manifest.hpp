@@ -0,0 +1,92 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_SUPERTUX_LEVEL_MANIFEST_HPP
+#define HEADER_SUPERTUX_SUPERTUX_LEVEL_MANIFEST_HPP
+
+#include <limits>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "util/currenton.hpp"
+#include "video/surface_ptr.hpp"
+
+class ReaderDocument;
+
+namespace sexp {
+class Value;
+} // namespace sexp
+
+/** List of the sprites, images and sounds a level can reach, built
+    from the files named in the level itself and the manifests
+    GameObjectFactory keeps for its objects. Everything on it is
+    loaded while the level intro is shown, so that objects spawned
+    later on don't have to hit the disk mid-game. */
+class LevelManifest final : public Currenton<LevelManifest>
+{
+public:
+  /** Builds the manifest of the level in doc */
+  static std::unique_ptr<LevelManifest> from_document(const ReaderDocument& doc);
+
+public:
+  LevelManifest(const std::string& levelfile);
+  ~LevelManifest();
+
+  /** Adds the manifest of objects of type name */
+  void add_object(const std::string& name);
+
+  /** Adds a .sprite, image or sound file, other files are ignored */
+  void add_resource(const std::string& filename);
+
+  /** Loads manifest entries until budget seconds have passed, returns
+      true once everything on the manifest has been loaded */
+  bool preload(float budget = std::numeric_limits<float>::infinity());
+
+  /** Called when a resource gets loaded on demand, once preloading
+      is done the files that are not on the manifest are logged so
+      that the manifests can be corrected */
+  void report_load(const std::string& filename);
+
+  size_t size() const { return m_pending.size(); }
+
+private:
+  void scan(const sexp::Value& sx);
+
+private:
+  std::string m_levelfile;
+  std::string m_basedir;
+  std::set<std::string> m_resources;
+
+  /** Resources in the order they get preloaded */
+  std::vector<std::string> m_pending;
+  size_t m_next;
+
+  /** Keeps preloaded images alive, sprites and sounds are kept by
+      their managers */
+  std::vector<SurfacePtr> m_images;
+
+  std::set<std::string> m_misses;
+
+private:
+  LevelManifest(const LevelManifest&) = delete;
+  LevelManifest& operator=(const LevelManifest&) = delete;
+};
+
+#endif
+
+/* EOF */
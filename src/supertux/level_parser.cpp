@@ -18,6 +18,7 @@
 
 #include <physfs.h>
 #include <sstream>
+#include <sexp/value.hpp>
 
 #include "supertux/level.hpp"
 #include "supertux/sector.hpp"
@@ -26,6 +27,34 @@
 #include "util/reader.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
+#include "video/texture_manager.hpp"
+
+namespace {
+
+/** Queues the images a level refers to by filename, e.g. backgrounds,
+    for decoding while the sectors get parsed */
+void prefetch_images(const sexp::Value& sx)
+{
+  if (sx.is_array())
+  {
+    for (const auto& item : sx.as_array())
+    {
+      prefetch_images(item);
+    }
+  }
+  else if (sx.is_string())
+  {
+    const std::string& text = sx.as_string();
+    if (StringUtil::has_suffix(text, ".png") ||
+        StringUtil::has_suffix(text, ".jpg"))
+    {
+      TextureManager::current()->prefetch(text);
+    }
+  }
+}
+
+} // namespace
 
 std::string
 LevelParser::get_level_name(const std::string& filename)
@@ -71,6 +100,24 @@ LevelParser::from_file(const std::string& filename, bool worldmap, bool editable
   return level;
 }
 
+std::unique_ptr<Level>
+LevelParser::from_document(const ReaderDocument& doc, bool worldmap, bool editable)
+{
+  auto level = std::make_unique<Level>(worldmap);
+  level->m_filename = doc.get_filename();
+  register_translation_directory(doc.get_filename());
+
+  LevelParser parser(*level, worldmap, editable);
+  try {
+    parser.load(doc);
+  } catch(std::exception& e) {
+    std::stringstream msg;
+    msg << "Problem when reading level '" << doc.get_filename() << "': " << e.what();
+    throw std::runtime_error(msg.str());
+  }
+  return level;
+}
+
 std::unique_ptr<Level>
 LevelParser::from_nothing(const std::string& basedir)
 {
@@ -151,6 +198,11 @@ LevelParser::load(const ReaderDocument& doc)
   if (root.get_name() != "supertux-level")
     throw std::runtime_error("file is not a supertux-level file.");
 
+  if (TextureManager::current())
+  {
+    prefetch_images(root.get_sexp());
+  }
+
   auto level = root.get_mapping();
 
   int version = 1;
@@ -186,6 +238,13 @@ LevelParser::load(const ReaderDocument& doc)
   }
 
   m_level.m_stats.init(m_level);
+
+  if (TextureManager::current())
+  {
+    // strings that merely look like filenames, or images whose
+    // textures were still cached, got queued as well
+    TextureManager::current()->discard_prefetched();
+  }
 }
 
 void
@@ -23,6 +23,7 @@
 #include "supertux/fadetoblack.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/level.hpp"
+#include "supertux/level_manifest.hpp"
 #include "supertux/player_status.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/screen_manager.hpp"
@@ -32,7 +33,8 @@
 
 #include <boost/format.hpp>
 
-LevelIntro::LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status) :
+LevelIntro::LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status,
+                       LevelManifest* manifest) :
   m_level(level),
   m_best_level_statistics(best_level_statistics),
   m_player_sprite(SpriteManager::current()->create("images/creatures/tux/tux.sprite")),
@@ -40,7 +42,8 @@ LevelIntro::LevelIntro(const Level& level, const Statistics* best_level_statisti
   m_player_sprite_py(0),
   m_player_sprite_vy(0),
   m_player_sprite_jump_timer(),
-  m_player_status(player_status)
+  m_player_status(player_status),
+  m_manifest(manifest)
 {
   //Show appropriate tux animation for player status.
   if (m_player_status.bonus == FIRE_BONUS && g_config->christmas_mode)
@@ -73,6 +76,12 @@ LevelIntro::setup()
 void
 LevelIntro::update(float dt_sec, const Controller& controller)
 {
+  if (m_manifest)
+  {
+    // spread the loading over the frames, so the intro stays animated
+    m_manifest->preload(0.01f);
+  }
+
   auto bonus_prefix = m_player_status.get_bonus_prefix();
   if (m_player_status.bonus == FIRE_BONUS && g_config->christmas_mode)
   {
@@ -115,7 +124,7 @@ void LevelIntro::draw_stats_line(DrawingContext& context, int& py, const std::st
 }
 
 void
-LevelIntro::draw(Compositor& compositor)
+LevelIntro::draw(Compositor& compositor, float alpha)
 {
   auto& context = compositor.make_context();
 
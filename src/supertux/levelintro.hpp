@@ -24,6 +24,7 @@
 
 class DrawingContext;
 class Level;
+class LevelManifest;
 class PlayerStatus;
 class Statistics;
 
@@ -37,11 +38,12 @@ private:
   static Color s_stat_color;
 
 public:
-  LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status);
+  LevelIntro(const Level& level, const Statistics* best_level_statistics, const PlayerStatus& player_status,
+             LevelManifest* manifest = nullptr);
   virtual ~LevelIntro();
 
   virtual void setup() override;
-  virtual void draw(Compositor& compositor) override;
+  virtual void draw(Compositor& compositor, float alpha) override;
   virtual void update(float dt_sec, const Controller& controller) override;
 
 private:
@@ -56,6 +58,7 @@ private:
   float m_player_sprite_vy; /**< Velocity (y axis) for the player sprite */
   Timer m_player_sprite_jump_timer; /**< When timer fires, the player sprite will "jump" */
   const PlayerStatus& m_player_status; /**The player status passed from GameSession*/
+  LevelManifest* m_manifest; /**< Resources to preload while the intro is shown */
 
 private:
   LevelIntro(const LevelIntro&) = delete;
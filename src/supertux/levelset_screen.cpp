@@ -47,7 +47,7 @@ LevelsetScreen::LevelsetScreen(const std::string& basedir, const std::string& le
 }
 
 void
-LevelsetScreen::draw(Compositor& compositor)
+LevelsetScreen::draw(Compositor& compositor, float alpha)
 {
 }
 
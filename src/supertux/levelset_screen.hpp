@@ -37,7 +37,7 @@ private:
 public:
   LevelsetScreen(const std::string& basedir, const std::string& level_filename, Savegame& savegame);
 
-  virtual void draw(Compositor& compositor) override;
+  virtual void draw(Compositor& compositor, float alpha) override;
   virtual void update(float dt_sec, const Controller& controller) override;
 
   virtual void setup() override;
@@ -53,7 +53,9 @@ extern "C" {
 #include "physfs/physfs_sdl.hpp"
 #include "sprite/sprite_data.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/command_line_arguments.hpp"
+#include "supertux/constants.hpp"
 #include "supertux/console.hpp"
 #include "supertux/game_manager.hpp"
 #include "supertux/game_session.hpp"
@@ -73,9 +75,11 @@ extern "C" {
 #include "supertux/world.hpp"
 #include "util/file_system.hpp"
 #include "util/gettext.hpp"
+#include "util/reader_cache.hpp"
 #include "util/string_util.hpp"
 #include "util/timelog.hpp"
 #include "util/string_util.hpp"
+#include "video/image_decoder.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/ttf_surface_manager.hpp"
@@ -122,7 +126,8 @@ public:
   }
 };
 
-Main::Main()
+Main::Main(Mode mode) :
+  m_mode(mode)
 {
 }
 
@@ -338,9 +343,9 @@ public:
 class SDLSubsystem final
 {
 public:
-  SDLSubsystem()
+  SDLSubsystem(Uint32 flags = SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_JOYSTICK)
   {
-    if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_VIDEO | SDL_INIT_JOYSTICK) < 0)
+    if (SDL_Init(flags) < 0)
     {
       std::stringstream msg;
       msg << "Couldn't initialize SDL: " << SDL_GetError();
@@ -432,6 +437,7 @@ Main::launch_game(const CommandLineArguments& args)
     }
   }
   s_timelog.log("video");
+  ImageDecoder image_decoder;
   std::unique_ptr<VideoSystem> video_system = VideoSystem::create(video);
   init_video();
 
@@ -443,6 +449,7 @@ Main::launch_game(const CommandLineArguments& args)
   sound_manager.enable_music(g_config->music_enabled);
   sound_manager.set_sound_volume(g_config->sound_volume);
   sound_manager.set_music_volume(g_config->music_volume);
+  sound_manager.set_cache_budget(static_cast<size_t>(g_config->sound_cache_budget) * 1024 * 1024);
 
   s_timelog.log("scripting");
   SquirrelVirtualMachine scripting(g_config->enable_script_debugger);
@@ -553,6 +560,70 @@ Main::launch_game(const CommandLineArguments& args)
   screen_manager.run();
 }
 
+void
+Main::launch_benchmark(const CommandLineArguments& args)
+{
+  if (args.filenames.empty())
+  {
+    throw std::runtime_error("No level given to benchmark");
+  }
+
+  if (args.bench_reader.get_value_or(false))
+  {
+    Benchmark::run_reader(args.filenames, args.bench_passes.get_value_or(100), std::cout);
+    return;
+  }
+
+  if (args.bench_audio.get_value_or(false))
+  {
+    Benchmark::run_audio(args.filenames, args.bench_voices.get_value_or(16),
+                         args.bench_wav.get_value_or(std::string()), std::cout);
+    return;
+  }
+
+  // no display, no input devices and no audio hardware needed
+  SDLSubsystem sdl_subsystem(SDL_INIT_TIMER);
+  ConsoleBuffer console_buffer;
+  InputManager input_manager(g_config->keyboard_config, g_config->joystick_config);
+  ImageDecoder image_decoder;
+  std::unique_ptr<VideoSystem> video_system = VideoSystem::create(VideoSystem::VIDEO_NULL);
+  TTFSurfaceManager ttf_surface_manager;
+  SoundManager sound_manager(SoundManager::OUTPUT_NONE);
+  SquirrelVirtualMachine scripting(false);
+  TileManager tile_manager;
+  SpriteManager sprite_manager;
+  Resources resources;
+  Console console(console_buffer);
+
+  const auto default_savegame = std::make_unique<Savegame>(std::string());
+  GameManager game_manager;
+  ScreenManager screen_manager(*video_system, input_manager);
+
+  const std::string& start_level = args.filenames.front();
+  PHYSFS_mount(FileSystem::dirname(start_level).c_str(), nullptr, true);
+
+  // the demo stores the seed it was recorded with
+  const std::string demo = args.start_demo.get_value_or(std::string());
+  int seed = g_config->random_seed;
+  if (!demo.empty())
+  {
+    seed = GameSessionRecorder().get_demo_random_seed(demo);
+  }
+  gameRandom.seed(seed);
+  graphicsRandom.seed(0);
+
+  GameSession session(FileSystem::basename(start_level), *default_savegame);
+  if (!demo.empty())
+  {
+    session.play_demo(demo);
+  }
+
+  Benchmark benchmark(session);
+  benchmark.run(args.bench_ticks.get_value_or(60 * static_cast<int>(LOGICAL_FPS)),
+                1.0f / LOGICAL_FPS);
+  benchmark.print_report(std::cout);
+}
+
 int
 Main::run(int argc, char** argv)
 {
@@ -622,8 +693,18 @@ Main::run(int argc, char** argv)
         return 0;
 
       default:
-        launch_game(args);
+      {
+        ReaderCache reader_cache("cache/reader", args.rebuild_cache.get_value_or(false));
+        if (m_mode == BENCHMARK)
+        {
+          launch_benchmark(args);
+        }
+        else
+        {
+          launch_game(args);
+        }
         break;
+      }
     }
   }
   catch(const std::exception& e)
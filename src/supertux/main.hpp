@@ -24,7 +24,17 @@ class CommandLineArguments;
 class Main final
 {
 public:
-  Main();
+  enum Mode
+  {
+    /** Normal interactive game */
+    GAME,
+
+    /** Headless simulation benchmark, used by supertux2-bench */
+    BENCHMARK
+  };
+
+public:
+  Main(Mode mode = GAME);
 
   /** We call it run() instead of main() as main collides with
       #define main SDL_main from SDL.h */
@@ -35,8 +45,12 @@ private:
   void init_video();
 
   void launch_game(const CommandLineArguments& args);
+  void launch_benchmark(const CommandLineArguments& args);
   void resave(const std::string& input_filename, const std::string& output_filename);
 
+private:
+  Mode m_mode;
+
 private:
   Main(const Main&) = delete;
   Main& operator=(const Main&) = delete;
@@ -17,17 +17,20 @@
 #include "supertux/moving_object.hpp"
 
 #include "editor/resize_marker.hpp"
+#include "supertux/constants.hpp"
 #include "supertux/sector.hpp"
 #include "util/writer.hpp"
 
 MovingObject::MovingObject() :
-  m_col(COLGROUP_MOVING, *this)
+  m_col(COLGROUP_MOVING, *this),
+  m_previous_pos()
 {
 }
 
 MovingObject::MovingObject(const ReaderMapping& reader) :
   GameObject(reader),
-  m_col(COLGROUP_MOVING, *this)
+  m_col(COLGROUP_MOVING, *this),
+  m_previous_pos()
 {
 }
 
@@ -35,6 +38,17 @@ MovingObject::~MovingObject()
 {
 }
 
+Vector
+MovingObject::get_draw_pos(float alpha) const
+{
+  const Vector pos = get_pos();
+  const Vector delta = pos - m_previous_pos;
+  if (delta.norm() > MAX_INTERPOLATION_DISTANCE) {
+    return pos;
+  }
+  return m_previous_pos + delta * alpha;
+}
+
 ObjectSettings
 MovingObject::get_settings()
 {
@@ -31,7 +31,6 @@ class Sector;
 class MovingObject : public GameObject,
                      public CollisionListener
 {
-  friend class Sector;
   friend class CollisionSystem;
 
 public:
@@ -69,6 +68,14 @@ public:
     return m_col.m_bbox.p1();
   }
 
+  /** Position alpha (0.0 to 1.0) of the way from the one before the
+      last update() to the current one, objects that were teleported
+      are drawn where they are */
+  Vector get_draw_pos(float alpha) const;
+
+  virtual void save_previous_state() override { m_previous_pos = get_pos(); }
+  virtual Vector get_draw_shift(float alpha) const override { return get_draw_pos(alpha) - get_pos(); }
+
   const Rectf& get_bbox() const
   {
     return m_col.m_bbox;
@@ -81,7 +88,7 @@ public:
 
   CollisionGroup get_group() const
   {
-    return m_col.m_group;
+    return m_col.get_group();
   }
 
   CollisionObject* get_collision_object() {
@@ -100,12 +107,17 @@ public:
 protected:
   void set_group(CollisionGroup group)
   {
-    m_col.m_group = group;
+    m_col.set_group(group);
   }
 
 protected:
   CollisionObject m_col;
 
+private:
+  /** Position at the start of the current logical frame, the object
+      is drawn in between that and get_pos() */
+  Vector m_previous_pos;
+
 private:
   MovingObject(const MovingObject&) = delete;
   MovingObject& operator=(const MovingObject&) = delete;
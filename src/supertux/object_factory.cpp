@@ -22,7 +22,8 @@
 #include "supertux/game_object.hpp"
 
 ObjectFactory::ObjectFactory() :
-  factories()
+  factories(),
+  manifests()
 {
 }
 
@@ -43,4 +44,35 @@ ObjectFactory::create(const std::string& name, const ReaderMapping& reader) cons
   }
 }
 
+bool
+ObjectFactory::has_manifest(const std::string& name) const
+{
+  return manifests.find(name) != manifests.end();
+}
+
+void
+ObjectFactory::get_resources(const std::string& name, std::set<std::string>& resources) const
+{
+  std::set<std::string> visited;
+  get_resources(name, resources, visited);
+}
+
+void
+ObjectFactory::get_resources(const std::string& name, std::set<std::string>& resources,
+                             std::set<std::string>& visited) const
+{
+  if (!visited.insert(name).second)
+    return;
+
+  auto it = manifests.find(name);
+  if (it == manifests.end())
+    return;
+
+  resources.insert(it->second.resources.begin(), it->second.resources.end());
+  for (const auto& spawn : it->second.spawns)
+  {
+    get_resources(spawn, resources, visited);
+  }
+}
+
 /* EOF */
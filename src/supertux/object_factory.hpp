@@ -22,6 +22,9 @@
 #include <map>
 #include <memory>
 #include <functional>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "supertux/direction.hpp"
 
@@ -36,10 +39,26 @@ private:
   typedef std::map<std::string, FactoryFunction> Factories;
   Factories factories;
 
+  struct Manifest
+  {
+    std::vector<std::string> resources;
+    std::vector<std::string> spawns;
+  };
+  typedef std::map<std::string, Manifest> Manifests;
+  Manifests manifests;
+
 public:
   /** Will throw in case of creation failure, will never return nullptr */
   std::unique_ptr<GameObject> create(const std::string& name, const ReaderMapping& reader) const;
 
+  /** Returns true if a manifest was registered for objects of type name */
+  bool has_manifest(const std::string& name) const;
+
+  /** Adds the sprites, images and sounds that objects of type name
+      load during the game, including those of the objects they can
+      spawn, to resources */
+  void get_resources(const std::string& name, std::set<std::string>& resources) const;
+
 protected:
   ObjectFactory();
 
@@ -56,6 +75,20 @@ protected:
         return std::make_unique<C>(reader);
       });
   }
+
+  /** Registers the resources of objects of type name, spawns are the
+      names of further objects they create at runtime */
+  void add_manifest(const char* name,
+                    const std::vector<std::string>& resources,
+                    const std::vector<std::string>& spawns = {})
+  {
+    assert(manifests.find(name) == manifests.end());
+    manifests[name] = Manifest{resources, spawns};
+  }
+
+private:
+  void get_resources(const std::string& name, std::set<std::string>& resources,
+                     std::set<std::string>& visited) const;
 };
 
 #endif
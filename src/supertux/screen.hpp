@@ -44,9 +44,12 @@ public:
 
   /**
    * gets called once per frame. The screen should draw itself in this function.
-   * State changes should not be done in this function, but rather in update
+   * State changes should not be done in this function, but rather in update.
+   * Frames are drawn independently of the logical frames, alpha tells how
+   * far the time of drawing is between the last update and the next one
+   * (0.0 to 1.0)
    */
-  virtual void draw(Compositor& compositor) = 0;
+  virtual void draw(Compositor& compositor, float alpha) = 0;
 
   /**
    * gets called for once (per logical) frame. Screens should do their state
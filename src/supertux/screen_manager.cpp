@@ -37,7 +37,10 @@
 #include "util/log.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
+#include "video/texture_manager.hpp"
 
+#include <algorithm>
+#include <math.h>
 #include <stdio.h>
 
 #if SDL_VERSION_ATLEAST(2,0,0)
@@ -45,7 +48,7 @@
 #define SDLK_PRINTSCREEN SDLK_PRINT
 #endif // SDL_VERSION_ATLEAST(2,0,0)
 
-/** don't skip more than every 2nd frame */
+/** don't run more than 2 logic steps in a row without drawing */
 static const int MAX_FRAME_SKIP = 2;
 
 ScreenManager::ScreenManager(VideoSystem& video_system, InputManager& input_manager) :
@@ -134,7 +137,7 @@ ScreenManager::get_speed() const
 }
 
 void
-ScreenManager::draw_fps(DrawingContext& context, float fps_fps)
+ScreenManager::draw_fps(DrawingContext& context, float fps_fps, int draw_calls)
 {
   char str[60];
   snprintf(str, sizeof(str), "%3.1f", static_cast<double>(fps_fps));
@@ -144,6 +147,14 @@ ScreenManager::draw_fps(DrawingContext& context, float fps_fps)
     Vector(static_cast<float>(context.get_width()) - Resources::small_font->get_text_width(fpstext) - Resources::small_font->get_text_width(" 99999") - BORDER_X,
            BORDER_Y + 20), ALIGN_LEFT, LAYER_HUD);
   context.color().draw_text(Resources::small_font, str, Vector(static_cast<float>(context.get_width()) - BORDER_X, BORDER_Y + 20), ALIGN_RIGHT, LAYER_HUD);
+
+  snprintf(str, sizeof(str), "%d", draw_calls);
+  const char* callstext = "Draw calls";
+  context.color().draw_text(
+    Resources::small_font, callstext,
+    Vector(static_cast<float>(context.get_width()) - Resources::small_font->get_text_width(callstext) - Resources::small_font->get_text_width(" 99999") - BORDER_X,
+           BORDER_Y + 40), ALIGN_LEFT, LAYER_HUD);
+  context.color().draw_text(Resources::small_font, str, Vector(static_cast<float>(context.get_width()) - BORDER_X, BORDER_Y + 40), ALIGN_RIGHT, LAYER_HUD);
 }
 
 void
@@ -158,19 +169,38 @@ ScreenManager::draw_player_pos(DrawingContext& context)
     context.color().draw_text(
       Resources::small_font, pos_text,
       Vector(static_cast<float>(context.get_width()) - Resources::small_font->get_text_width("99999x99999") - BORDER_X,
-             BORDER_Y + 40.0f), ALIGN_LEFT, LAYER_HUD);
+             BORDER_Y + 60.0f), ALIGN_LEFT, LAYER_HUD);
   }
 }
 
 void
-ScreenManager::draw(Compositor& compositor)
+ScreenManager::draw_texture_memory(DrawingContext& context)
+{
+  const TextureManager& texture_manager = *TextureManager::current();
+  const size_t mib = 1024 * 1024;
+
+  char str[60];
+  snprintf(str, sizeof(str), "%zu %zu/%zu MiB",
+           texture_manager.get_texture_bytes() / mib,
+           texture_manager.get_surface_bytes() / mib,
+           texture_manager.get_budget() / mib);
+  const char* memtext = "Textures";
+  context.color().draw_text(
+    Resources::small_font, memtext,
+    Vector(static_cast<float>(context.get_width()) - Resources::small_font->get_text_width(memtext) - Resources::small_font->get_text_width(" 9999 9999/9999 MiB") - BORDER_X,
+           BORDER_Y + 80), ALIGN_LEFT, LAYER_HUD);
+  context.color().draw_text(Resources::small_font, str, Vector(static_cast<float>(context.get_width()) - BORDER_X, BORDER_Y + 80), ALIGN_RIGHT, LAYER_HUD);
+}
+
+void
+ScreenManager::draw(Compositor& compositor, float alpha)
 {
   assert(!m_screen_stack.empty());
 
   static Uint32 fps_ticks = SDL_GetTicks();
 
   // draw the actual screen
-  m_screen_stack.back()->draw(compositor);
+  m_screen_stack.back()->draw(compositor, alpha);
 
   // draw effects and hud
   auto& context = compositor.make_context(true);
@@ -183,7 +213,7 @@ ScreenManager::draw(Compositor& compositor)
   Console::current()->draw(context);
 
   if (g_config->show_fps) {
-    draw_fps(context, m_fps);
+    draw_fps(context, m_fps, compositor.get_draw_calls());
   }
 
   if (g_debug.show_controller) {
@@ -194,6 +224,10 @@ ScreenManager::draw(Compositor& compositor)
     draw_player_pos(context);
   }
 
+  if (g_debug.show_texture_memory) {
+    draw_texture_memory(context);
+  }
+
   // render everything
   compositor.render();
 
@@ -395,55 +429,73 @@ ScreenManager::handle_screen_switch()
 void
 ScreenManager::run()
 {
-  Uint32 last_ticks = 0;
-  Uint32 elapsed_ticks = 0;
+  Uint32 last_ticks = SDL_GetTicks();
+
+  /** seconds of game logic not yet simulated */
+  float elapsed_time = 0.0f;
+
+  /** seconds since the last frame was drawn */
+  float draw_time = 0.0f;
 
   handle_screen_switch();
 
   while (!m_screen_stack.empty())
   {
+    // the game logic always runs at LOGICAL_FPS, m_target_framerate
+    // only limits how often the result is drawn
+    const float step_time = 1.0f / LOGICAL_FPS * g_debug.get_game_speed_multiplier();
+    const float frame_time = 1.0f / m_target_framerate;
+
     Uint32 ticks = SDL_GetTicks();
-    elapsed_ticks += ticks - last_ticks;
+    elapsed_time += static_cast<float>(ticks - last_ticks) / 1000.0f;
+    draw_time += static_cast<float>(ticks - last_ticks) / 1000.0f;
     last_ticks = ticks;
 
-    /** ticks (as returned from SDL_GetTicks) per frame */
-    const Uint32 ticks_per_frame = static_cast<Uint32>(1000.0f / m_target_framerate * g_debug.get_game_speed_multiplier());
-
-    if (elapsed_ticks > ticks_per_frame*4)
+    if (elapsed_time > step_time * 4)
     {
       // when the game loads up or levels are switched the
-      // elapsed_ticks grows extremely large, so we just ignore those
+      // elapsed_time grows extremely large, so we just ignore those
       // large time jumps
-      elapsed_ticks = 0;
+      elapsed_time = 0.0f;
     }
 
-    if (elapsed_ticks < ticks_per_frame)
+    // sleep until either a logic step or a frame is due
+    const float delay = std::min(step_time - elapsed_time, frame_time - draw_time);
+    if (delay > 0.0f)
     {
-      Uint32 delay_ticks = ticks_per_frame - elapsed_ticks;
+      const Uint32 delay_ticks = static_cast<Uint32>(ceilf(delay * 1000.0f));
       SDL_Delay(delay_ticks);
       last_ticks += delay_ticks;
-      elapsed_ticks += delay_ticks;
+      elapsed_time += static_cast<float>(delay_ticks) / 1000.0f;
+      draw_time += static_cast<float>(delay_ticks) / 1000.0f;
     }
 
-    int frames = 0;
+    int steps = 0;
 
-    while (elapsed_ticks >= ticks_per_frame && frames < MAX_FRAME_SKIP)
+    while (elapsed_time >= step_time && steps < MAX_FRAME_SKIP)
     {
-      elapsed_ticks -= ticks_per_frame;
-      float timestep = 1.0f / m_target_framerate;
+      elapsed_time -= step_time;
+      float timestep = 1.0f / LOGICAL_FPS;
       g_real_time += timestep;
       timestep *= m_speed;
       g_game_time += timestep;
 
       process_events();
       update_gamelogic(timestep);
-      frames += 1;
+      steps += 1;
     }
 
-    if (!m_screen_stack.empty())
+    if (draw_time >= frame_time && !m_screen_stack.empty())
     {
+      // don't try to catch up on frames that were missed
+      draw_time = std::min(draw_time - frame_time, frame_time);
+
+      // how far the game is between the last step and the next one,
+      // objects are drawn in between their last two positions by that
+      const float alpha = std::min(elapsed_time / step_time, 1.0f);
+
       Compositor compositor(m_video_system);
-      draw(compositor);
+      draw(compositor, alpha);
     }
 
     SoundManager::current()->update();
@@ -56,9 +56,10 @@ public:
   void set_screen_fade(std::unique_ptr<ScreenFade> fade);
 
 private:
-  void draw_fps(DrawingContext& context, float fps);
+  void draw_fps(DrawingContext& context, float fps, int draw_calls);
   void draw_player_pos(DrawingContext& context);
-  void draw(Compositor& compositor);
+  void draw_texture_memory(DrawingContext& context);
+  void draw(Compositor& compositor, float alpha);
   void update_gamelogic(float dt_sec);
   void process_events();
   void handle_screen_switch();
@@ -71,6 +72,9 @@ private:
   std::unique_ptr<ControllerHUD> m_controller_hud;
 
   float m_speed;
+
+  /** Frames drawn per second at most, the game logic always runs at
+      LOGICAL_FPS */
   float m_target_framerate;
 
   struct Action
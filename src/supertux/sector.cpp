@@ -18,6 +18,7 @@
 
 #include <physfs.h>
 #include <algorithm>
+#include <chrono>
 
 #include "audio/sound_manager.hpp"
 #include "badguy/badguy.hpp"
@@ -58,11 +59,42 @@
 #include "video/viewport.hpp"
 
 Sector* Sector::s_current = nullptr;
+Sector::UpdateProfile* Sector::s_update_profile = nullptr;
 
 namespace {
 
 PlayerStatus dummy_player_status;
 
+/** Adds the time since the last lap to a field of the profile, does
+    nothing if there is no profile */
+class UpdateTimer final
+{
+public:
+  UpdateTimer(Sector::UpdateProfile* profile) :
+    m_profile(profile),
+    m_last(profile ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point())
+  {
+  }
+
+  void lap(double Sector::UpdateProfile::*field)
+  {
+    if (!m_profile)
+      return;
+
+    const auto now = std::chrono::steady_clock::now();
+    m_profile->*field += std::chrono::duration<double>(now - m_last).count();
+    m_last = now;
+  }
+
+private:
+  Sector::UpdateProfile* m_profile;
+  std::chrono::steady_clock::time_point m_last;
+
+private:
+  UpdateTimer(const UpdateTimer&) = delete;
+  UpdateTimer& operator=(const UpdateTimer&) = delete;
+};
+
 } // namespace
 
 Sector::Sector(Level& parent) :
@@ -153,6 +185,8 @@ Sector::finish_construction(bool editable)
 
   flush_game_objects();
 
+  m_collision_system->rebuild_tile_layers();
+
   m_fully_constructed = true;
 }
 
@@ -319,13 +353,26 @@ Sector::update(float dt_sec)
 
   BIND_SECTOR(*this);
 
+  // draw() interpolates from here
+  for (const auto& object : get_objects())
+  {
+    object->save_previous_state();
+  }
+
+  UpdateTimer timer(s_update_profile);
+
   m_squirrel_environment->update(dt_sec);
+  timer.lap(&UpdateProfile::scripts);
 
   GameObjectManager::update(dt_sec);
+  timer.lap(&UpdateProfile::objects);
 
   /* Handle all possible collisions. */
   m_collision_system->update();
+  timer.lap(&UpdateProfile::collision);
+
   flush_game_objects();
+  timer.lap(&UpdateProfile::flush);
 }
 
 bool
@@ -346,6 +393,7 @@ Sector::before_object_add(GameObject& object)
   {
     m_collision_system->add(movingobject->get_collision_object());
   }
+  object.save_previous_state();
 
   if (s_current == this) {
     m_squirrel_environment->try_expose(object);
@@ -373,16 +421,16 @@ Sector::before_object_remove(GameObject& object)
 }
 
 void
-Sector::draw(DrawingContext& context)
+Sector::draw(DrawingContext& context, float alpha)
 {
   BIND_SECTOR(*this);
 
   Camera& camera = get_camera();
 
   context.push_transform();
-  context.set_translation(camera.get_translation());
+  context.set_translation(camera.get_interpolated_translation(alpha));
 
-  GameObjectManager::draw(context);
+  GameObjectManager::draw(context, alpha);
 
   if (g_debug.show_collision_rects) {
     m_collision_system->draw(context);
@@ -422,13 +470,27 @@ Sector::free_line_of_sight(const Vector& line_start, const Vector& line_end, con
 bool
 Sector::can_see_player(const Vector& eye) const
 {
+  return can_see_player(std::vector<Vector>{ eye });
+}
+
+bool
+Sector::can_see_player(const std::vector<Vector>& eyes) const
+{
+  std::vector<std::pair<Vector, Vector> > lines;
   for (const auto& player : get_objects_by_type<Player>()) {
     // test for free line of sight to any of all four corners and the middle of the player's bounding box
-    if (free_line_of_sight(eye, player.get_bbox().p1(), &player)) return true;
-    if (free_line_of_sight(eye, Vector(player.get_bbox().get_right(), player.get_bbox().get_top()), &player)) return true;
-    if (free_line_of_sight(eye, player.get_bbox().p2(), &player)) return true;
-    if (free_line_of_sight(eye, Vector(player.get_bbox().get_left(), player.get_bbox().get_bottom()), &player)) return true;
-    if (free_line_of_sight(eye, player.get_bbox().get_middle(), &player)) return true;
+    const Rectf& bbox = player.get_bbox();
+    lines.clear();
+    for (const auto& eye : eyes) {
+      lines.push_back(std::make_pair(eye, bbox.p1()));
+      lines.push_back(std::make_pair(eye, Vector(bbox.get_right(), bbox.get_top())));
+      lines.push_back(std::make_pair(eye, bbox.p2()));
+      lines.push_back(std::make_pair(eye, Vector(bbox.get_left(), bbox.get_bottom())));
+      lines.push_back(std::make_pair(eye, bbox.get_middle()));
+    }
+
+    if (m_collision_system->any_free_line_of_sight(lines, player.get_collision_object()))
+      return true;
   }
   return false;
 }
@@ -60,6 +60,17 @@ public:
   static Sector& get() { assert(s_current != nullptr); return *s_current; }
   static Sector* current() { return s_current; }
 
+public:
+  /** Seconds spent in the phases of update(), summed up over all
+      calls while the profile is set with set_update_profile() */
+  struct UpdateProfile
+  {
+    double scripts = 0.0;
+    double objects = 0.0;
+    double collision = 0.0;
+    double flush = 0.0;
+  };
+
 public:
   Sector(Level& parent);
   ~Sector();
@@ -77,7 +88,13 @@ public:
 
   void update(float dt_sec);
 
-  void draw(DrawingContext& context);
+  /** Start accumulating the time spent in update() of any sector
+      into profile, nullptr stops it */
+  static void set_update_profile(UpdateProfile* profile) { s_update_profile = profile; }
+
+  /** Draws the sector as it is alpha (0.0 to 1.0) of the way from
+      the start of the last update() to its end */
+  void draw(DrawingContext& context, float alpha = 1.0f);
 
   void save(Writer &writer);
 
@@ -113,6 +130,10 @@ public:
   bool free_line_of_sight(const Vector& line_start, const Vector& line_end, const MovingObject* ignore_object = nullptr) const;
   bool can_see_player(const Vector& eye) const;
 
+  /** Returns true if any player can be seen from any of the eyes,
+      all lines are tested in one batch */
+  bool can_see_player(const std::vector<Vector>& eyes) const;
+
   Player* get_nearest_player (const Vector& pos) const;
   Player* get_nearest_player (const Rectf& pos) const {
     return (get_nearest_player (get_anchor_pos (pos, ANCHOR_MIDDLE)));
@@ -176,6 +197,8 @@ private:
 
   float m_gravity;
 
+  static UpdateProfile* s_update_profile;
+
 private:
   Sector(const Sector&) = delete;
   Sector& operator=(const Sector&) = delete;
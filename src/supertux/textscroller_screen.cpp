@@ -126,7 +126,7 @@ TextScrollerScreen::update(float dt_sec, const Controller& controller)
 }
 
 void
-TextScrollerScreen::draw(Compositor& compositor)
+TextScrollerScreen::draw(Compositor& compositor, float alpha)
 {
   auto& context = compositor.make_context();
 
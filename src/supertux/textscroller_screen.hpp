@@ -37,7 +37,7 @@ public:
   virtual ~TextScrollerScreen();
 
   virtual void setup() override;
-  virtual void draw(Compositor& compositor) override;
+  virtual void draw(Compositor& compositor, float alpha) override;
   virtual void update(float dt_sec, const Controller& controller) override;
 
 private:
@@ -108,6 +108,14 @@ public:
   void draw_debug(Canvas& canvas, const Vector& pos, int z_pos, const Color& color = Color(1.0f, 0.f, 1.0f, 0.5f)) const;
 
   SurfacePtr get_current_surface() const;
+
+  /** Returns true if the surface returned by get_current_surface()
+      changes over time */
+  bool is_animated() const { return m_images.size() > 1; }
+
+  /** Same as is_animated(), for get_current_editor_surface() */
+  bool is_editor_animated() const
+  { return m_editor_images.empty() ? is_animated() : m_editor_images.size() > 1; }
   SurfacePtr get_current_editor_surface() const;
 
   uint32_t get_attributes() const { return m_attributes; }
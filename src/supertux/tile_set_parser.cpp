@@ -17,6 +17,7 @@
 
 #include "supertux/tile_set_parser.hpp"
 
+#include <boost/utility/typed_in_place_factory.hpp>
 #include <sstream>
 #include <sexp/value.hpp>
 #include <sexp/io.hpp>
@@ -28,7 +29,23 @@
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/file_system.hpp"
+#include "video/image_decoder.hpp"
 #include "video/surface.hpp"
+#include "video/texture_manager.hpp"
+
+TileSetParser::TileSpec::TileSpec() :
+  id(0),
+  attributes(0),
+  data(0),
+  fps(10),
+  object_name(),
+  object_data(),
+  deprecated(false),
+  images(),
+  editor_images(),
+  shared_region()
+{
+}
 
 TileSetParser::TileSetParser(TileSet& tileset, const std::string& filename) :
   m_tileset(tileset),
@@ -49,13 +66,16 @@ TileSetParser::parse()
     throw std::runtime_error("file is not a supertux tiles file.");
   }
 
+  prefetch_images(root.get_mapping());
+
+  std::vector<std::pair<std::string, ReaderMapping> > entries;
+
   auto iter = root.get_mapping().get_iter();
   while (iter.next())
   {
-    if (iter.get_key() == "tile")
+    if (iter.get_key() == "tile" || iter.get_key() == "tiles")
     {
-      ReaderMapping tile_mapping = iter.as_mapping();
-      parse_tile(tile_mapping);
+      entries.emplace_back(iter.get_key(), iter.as_mapping());
     }
     else if (iter.get_key() == "tilegroup")
     {
@@ -66,16 +86,20 @@ TileSetParser::parse()
       reader.get("tiles", tilegroup.tiles);
       m_tileset.add_tilegroup(tilegroup);
     }
-    else if (iter.get_key() == "tiles")
-    {
-      ReaderMapping tiles_mapping = iter.as_mapping();
-      parse_tiles(tiles_mapping);
-    }
     else
     {
       log_warning << "Unknown symbol '" << iter.get_key() << "' in tileset file" << std::endl;
     }
   }
+
+  std::vector<Block> blocks;
+  parse_blocks(entries, blocks);
+
+  for (const auto& block : blocks)
+  {
+    add_block(block);
+  }
+
   if (g_config->developer_mode)
   {
     m_tileset.add_unassigned_tilegroup();
@@ -83,15 +107,152 @@ TileSetParser::parse()
 }
 
 void
-TileSetParser::parse_tile(const ReaderMapping& reader)
+TileSetParser::prefetch_images(const ReaderMapping& root) const
+{
+  auto iter = root.get_iter();
+  while (iter.next())
+  {
+    if (iter.get_key() == "tile" || iter.get_key() == "tiles")
+    {
+      ReaderMapping reader = iter.as_mapping();
+      boost::optional<ReaderMapping> images_mapping;
+      if (reader.get("image", images_mapping) ||
+          reader.get("images", images_mapping)) {
+        prefetch_imagespecs(*images_mapping);
+      }
+      if (reader.get("editor-images", images_mapping)) {
+        prefetch_imagespecs(*images_mapping);
+      }
+    }
+  }
+}
+
+void
+TileSetParser::prefetch_imagespecs(const ReaderMapping& images_mapping) const
+{
+  auto iter = images_mapping.get_iter();
+  while (iter.next())
+  {
+    if (iter.is_string())
+    {
+      TextureManager::current()->prefetch(FileSystem::join(m_tiles_path, iter.as_string_item()));
+    }
+    else if (iter.is_pair() && iter.get_key() == "region")
+    {
+      auto const& arr = iter.as_mapping().get_sexp().as_array();
+      if (arr.size() == 6 && arr[1].is_string())
+      {
+        TextureManager::current()->prefetch(FileSystem::join(m_tiles_path, arr[1].as_string()));
+      }
+    }
+  }
+}
+
+void
+TileSetParser::parse_blocks(const std::vector<std::pair<std::string, ReaderMapping> >& entries,
+                            std::vector<Block>& blocks) const
+{
+  blocks.resize(entries.size());
+
+  const auto parse = [this, &entries, &blocks](size_t i)
+  {
+    parse_block(entries[i].first, entries[i].second, blocks[i]);
+  };
+
+  // the image decoder's workers are idle by now or busy with this
+  // tileset's images, which only get needed once the blocks are parsed
+  if (ImageDecoder::current())
+  {
+    ImageDecoder::current()->parallel_for(entries.size(), parse);
+  }
+  else
+  {
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+      parse(i);
+    }
+  }
+}
+
+void
+TileSetParser::parse_block(const std::string& key, const ReaderMapping& entry, Block& block) const
 {
-  uint32_t id;
+  try
+  {
+    if (key == "tile")
+    {
+      parse_tile(entry, block);
+    }
+    else
+    {
+      parse_tiles(entry, block);
+    }
+  }
+  catch (...)
+  {
+    block.error = std::current_exception();
+  }
+}
+
+void
+TileSetParser::add_block(const Block& block)
+{
+  for (const auto& warning : block.warnings)
+  {
+    log_warning << warning << std::endl;
+  }
+
+  if (block.error)
+  {
+    std::rethrow_exception(block.error);
+  }
+
+  const std::vector<SurfacePtr> shared_surfaces = create_surfaces(block.shared_images);
+  const std::vector<SurfacePtr> shared_editor_surfaces = create_surfaces(block.shared_editor_images);
+
+  for (const auto& spec : block.tiles)
+  {
+    std::vector<SurfacePtr> surfaces;
+    std::vector<SurfacePtr> editor_surfaces;
+
+    if (spec.shared_region)
+    {
+      surfaces.reserve(shared_surfaces.size());
+      for (const auto& surface : shared_surfaces)
+      {
+        surfaces.push_back(surface->region(*spec.shared_region));
+      }
+
+      editor_surfaces.reserve(shared_editor_surfaces.size());
+      for (const auto& surface : shared_editor_surfaces)
+      {
+        editor_surfaces.push_back(surface->region(*spec.shared_region));
+      }
+    }
+    else
+    {
+      editor_surfaces = create_surfaces(spec.editor_images);
+      surfaces = create_surfaces(spec.images);
+    }
+
+    auto tile = std::make_unique<Tile>(surfaces, editor_surfaces,
+                                       spec.attributes, spec.data, spec.fps,
+                                       spec.object_name, spec.object_data, spec.deprecated);
+    m_tileset.add_tile(spec.id, std::move(tile));
+  }
+}
+
+void
+TileSetParser::parse_tile(const ReaderMapping& reader, Block& block) const
+{
+  TileSpec spec;
+  uint32_t& id = spec.id;
   if (!reader.get("id", id))
   {
     throw std::runtime_error("Missing tile-id.");
   }
 
-  uint32_t attributes = 0;
+  uint32_t& attributes = spec.attributes;
 
   bool value = false;
   if (reader.get("solid", value) && value)
@@ -115,7 +276,7 @@ TileSetParser::parse_tile(const ReaderMapping& reader)
   if (reader.get("goal", value) && value)
     attributes |= Tile::GOAL;
 
-  uint32_t data = 0;
+  uint32_t& data = spec.data;
 
   if (reader.get("north", value) && value)
     data |= Tile::WORLDMAP_NORTH;
@@ -130,41 +291,33 @@ TileSetParser::parse_tile(const ReaderMapping& reader)
 
   reader.get("data", data);
 
-  float fps = 10;
-  reader.get("fps", fps);
+  reader.get("fps", spec.fps);
 
-  std::string object_name, object_data;
-  reader.get("object-name", object_name);
-  reader.get("object-data", object_data);
+  reader.get("object-name", spec.object_name);
+  reader.get("object-data", spec.object_data);
 
   if (reader.get("slope-type", data))
   {
     attributes |= Tile::SOLID | Tile::SLOPE;
   }
 
-  std::vector<SurfacePtr> editor_surfaces;
   boost::optional<ReaderMapping> editor_images_mapping;
   if (reader.get("editor-images", editor_images_mapping)) {
-    editor_surfaces = parse_imagespecs(*editor_images_mapping);
+    spec.editor_images = parse_imagespecs(*editor_images_mapping, block);
   }
 
-  std::vector<SurfacePtr> surfaces;
   boost::optional<ReaderMapping> images_mapping;
   if (reader.get("images", images_mapping)) {
-    surfaces = parse_imagespecs(*images_mapping);
+    spec.images = parse_imagespecs(*images_mapping, block);
   }
 
-  bool deprecated = false;
-  reader.get("deprecated", deprecated);
+  reader.get("deprecated", spec.deprecated);
 
-  auto tile = std::make_unique<Tile>(surfaces, editor_surfaces,
-                                     attributes, data, fps,
-                                     object_name, object_data, deprecated);
-  m_tileset.add_tile(id, std::move(tile));
+  block.tiles.push_back(std::move(spec));
 }
 
 void
-TileSetParser::parse_tiles(const ReaderMapping& reader)
+TileSetParser::parse_tiles(const ReaderMapping& reader, Block& block) const
 {
   // List of ids (use 0 if the tile should be ignored)
   std::vector<uint32_t> ids;
@@ -236,92 +389,65 @@ TileSetParser::parse_tiles(const ReaderMapping& reader)
   }
   else
   {
+    block.tiles.reserve(ids.size() - static_cast<size_t>(std::count(ids.begin(), ids.end(), 0u)));
+
+    boost::optional<ReaderMapping> surfaces_mapping;
+    if (!reader.get("image", surfaces_mapping)) {
+      reader.get("images", surfaces_mapping);
+    }
+
+    boost::optional<ReaderMapping> editor_surfaces_mapping;
+    reader.get("editor-images", editor_surfaces_mapping);
+
     if (shared_surface)
     {
-      std::vector<SurfacePtr> editor_surfaces;
-      boost::optional<ReaderMapping> editor_surfaces_mapping;
-      if (reader.get("editor-images", editor_surfaces_mapping)) {
-        editor_surfaces = parse_imagespecs(*editor_surfaces_mapping);
+      if (editor_surfaces_mapping) {
+        block.shared_editor_images = parse_imagespecs(*editor_surfaces_mapping, block);
       }
-
-      std::vector<SurfacePtr> surfaces;
-      boost::optional<ReaderMapping> surfaces_mapping;
-      if (reader.get("image", surfaces_mapping) ||
-         reader.get("images", surfaces_mapping)) {
-        surfaces = parse_imagespecs(*surfaces_mapping);
+      if (surfaces_mapping) {
+        block.shared_images = parse_imagespecs(*surfaces_mapping, block);
       }
+    }
 
-      for (size_t i = 0; i < ids.size(); ++i)
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      if (ids[i] != 0)
       {
-        if (ids[i] != 0)
-        {
-          const int x = static_cast<int>(32 * (i % width));
-          const int y = static_cast<int>(32 * (i / width));
-
-          std::vector<SurfacePtr> regions;
-          regions.reserve(surfaces.size());
-          for (const auto& surface : surfaces)
-          {
-            regions.push_back(surface->region(Rect(x, y, Size(32, 32))));
-          }
-
-          std::vector<SurfacePtr> editor_regions;
-          editor_regions.reserve(editor_surfaces.size());
-          for (const auto& surface : editor_surfaces)
-          {
-            editor_regions.push_back(surface->region(Rect(x, y, Size(32, 32))));
-          }
+        const int x = static_cast<int>(32 * (i % width));
+        const int y = static_cast<int>(32 * (i / width));
+        const Rect region(x, y, Size(32, 32));
 
-          auto tile = std::make_unique<Tile>(regions,
-                                             editor_regions,
-                                             (has_attributes ? attributes[i] : 0),
-                                             (has_datas ? datas[i] : 0),
-                                             fps);
+        TileSpec spec;
+        spec.id = ids[i];
+        spec.attributes = (has_attributes ? attributes[i] : 0);
+        spec.data = (has_datas ? datas[i] : 0);
+        spec.fps = fps;
 
-          m_tileset.add_tile(ids[i], std::move(tile));
+        if (shared_surface)
+        {
+          spec.shared_region = region;
         }
-      }
-    }
-    else // (!shared_surface)
-    {
-      for (size_t i = 0; i < ids.size(); ++i)
-      {
-        if (ids[i] != 0)
+        else
         {
-          int x = static_cast<int>(32 * (i % width));
-          int y = static_cast<int>(32 * (i / width));
-
-          std::vector<SurfacePtr> surfaces;
-          boost::optional<ReaderMapping> surfaces_mapping;
-          if (reader.get("image", surfaces_mapping) ||
-             reader.get("images", surfaces_mapping)) {
-            surfaces = parse_imagespecs(*surfaces_mapping, Rect(x, y, Size(32, 32)));
+          if (surfaces_mapping) {
+            spec.images = parse_imagespecs(*surfaces_mapping, block, region);
           }
-
-          std::vector<SurfacePtr> editor_surfaces;
-          boost::optional<ReaderMapping> editor_surfaces_mapping;
-          if (reader.get("editor-images", editor_surfaces_mapping)) {
-            editor_surfaces = parse_imagespecs(*editor_surfaces_mapping, Rect(x, y, Size(32, 32)));
+          if (editor_surfaces_mapping) {
+            spec.editor_images = parse_imagespecs(*editor_surfaces_mapping, block, region);
           }
-
-          auto tile = std::make_unique<Tile>(surfaces,
-                                             editor_surfaces,
-                                             (has_attributes ? attributes[i] : 0),
-                                             (has_datas ? datas[i] : 0),
-                                             fps);
-
-          m_tileset.add_tile(ids[i], std::move(tile));
         }
+
+        block.tiles.push_back(std::move(spec));
       }
     }
   }
 }
 
-std::vector<SurfacePtr>
-  TileSetParser::parse_imagespecs(const ReaderMapping& images_mapping,
-                                  const boost::optional<Rect>& surface_region) const
+std::vector<TileSetParser::ImageSpec>
+TileSetParser::parse_imagespecs(const ReaderMapping& images_mapping, Block& block,
+                                const boost::optional<Rect>& surface_region) const
 {
-  std::vector<SurfacePtr> surfaces;
+  std::vector<ImageSpec> specs;
 
   // (images "foo.png" "foo.bar" ...)
   // (images (region "foo.png" 0 0 32 32))
@@ -330,12 +456,17 @@ std::vector<SurfacePtr>
   {
     if (iter.is_string())
     {
-      std::string file = iter.as_string_item();
-      surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file), surface_region));
+      ImageSpec spec;
+      spec.filename = FileSystem::join(m_tiles_path, iter.as_string_item());
+      spec.region = surface_region;
+      specs.push_back(std::move(spec));
     }
     else if (iter.is_pair() && iter.get_key() == "surface")
     {
-      surfaces.push_back(Surface::from_reader(iter.as_mapping(), surface_region));
+      ImageSpec spec;
+      spec.surface = boost::in_place<ReaderMapping>(iter.as_mapping());
+      spec.region = surface_region;
+      specs.push_back(std::move(spec));
     }
     else if (iter.is_pair() && iter.get_key() == "region")
     {
@@ -343,7 +474,9 @@ std::vector<SurfacePtr>
       auto const& arr = sx.as_array();
       if (arr.size() != 6)
       {
-        log_warning << "(region X Y WIDTH HEIGHT) tag malformed: " << sx << std::endl;
+        std::ostringstream msg;
+        msg << "(region X Y WIDTH HEIGHT) tag malformed: " << sx;
+        block.warnings.push_back(msg.str());
       }
       else
       {
@@ -364,16 +497,37 @@ std::vector<SurfacePtr>
           rect.bottom = rect.top + surface_region->get_height();
         }
 
-        surfaces.push_back(Surface::from_file(FileSystem::join(m_tiles_path, file),
-                                              rect));
+        ImageSpec spec;
+        spec.filename = FileSystem::join(m_tiles_path, file);
+        spec.region = rect;
+        specs.push_back(std::move(spec));
       }
     }
     else
     {
-      log_warning << "Expected string or list in images tag" << std::endl;
+      block.warnings.push_back("Expected string or list in images tag");
     }
   }
 
+  return specs;
+}
+
+std::vector<SurfacePtr>
+TileSetParser::create_surfaces(const std::vector<ImageSpec>& specs) const
+{
+  std::vector<SurfacePtr> surfaces;
+  surfaces.reserve(specs.size());
+  for (const auto& spec : specs)
+  {
+    if (spec.surface)
+    {
+      surfaces.push_back(Surface::from_reader(*spec.surface, spec.region));
+    }
+    else
+    {
+      surfaces.push_back(Surface::from_file(spec.filename, spec.region));
+    }
+  }
   return surfaces;
 }
 
@@ -18,18 +18,71 @@
 #ifndef HEADER_SUPERTUX_SUPERTUX_TILE_SET_PARSER_HPP
 #define HEADER_SUPERTUX_SUPERTUX_TILE_SET_PARSER_HPP
 
+#include <exception>
 #include <string>
+#include <utility>
 #include <vector>
 #include <boost/optional.hpp>
 
 #include "math/rect.hpp"
 #include "supertux/tile.hpp"
+#include "util/reader_mapping.hpp"
 
-class ReaderMapping;
 class TileSet;
 
+/** Reads a tileset file. The (tile ...) and (tiles ...) entries are
+    parsed into TileSpecs on a few worker threads, the Surfaces and
+    Tiles are then created on the main thread in the order of the
+    file, as creating textures needs the GL context. */
 class TileSetParser final
 {
+private:
+  /** One image of a tile, turned into a Surface by create_surfaces() */
+  struct ImageSpec
+  {
+    ImageSpec() : filename(), region(), surface() {}
+
+    std::string filename;
+    boost::optional<Rect> region;
+
+    /** Set for (surface ...) entries, which go through Surface::from_reader() */
+    boost::optional<ReaderMapping> surface;
+  };
+
+  struct TileSpec
+  {
+    TileSpec();
+
+    uint32_t id;
+    uint32_t attributes;
+    uint32_t data;
+    float fps;
+    std::string object_name;
+    std::string object_data;
+    bool deprecated;
+
+    std::vector<ImageSpec> images;
+    std::vector<ImageSpec> editor_images;
+
+    /** Set for (tiles (shared-surface #t) ...), the tile then uses
+        this part of the shared images of its block instead of images */
+    boost::optional<Rect> shared_region;
+  };
+
+  /** The result of parsing a single (tile ...) or (tiles ...) entry */
+  struct Block
+  {
+    Block() : shared_images(), shared_editor_images(), tiles(), warnings(), error() {}
+
+    std::vector<ImageSpec> shared_images;
+    std::vector<ImageSpec> shared_editor_images;
+    std::vector<TileSpec> tiles;
+
+    /** Logged from the main thread, in order */
+    std::vector<std::string> warnings;
+    std::exception_ptr error;
+  };
+
 private:
   TileSet&    m_tileset;
   std::string m_filename;
@@ -41,10 +94,22 @@ public:
   void parse();
 
 private:
-  void parse_tile(const ReaderMapping& reader);
-  void parse_tiles(const ReaderMapping& reader);
-  std::vector<SurfacePtr> parse_imagespecs(const ReaderMapping& cur,
-                                           const boost::optional<Rect>& region = boost::none) const;
+  /** Queues all images of the tileset for background decoding */
+  void prefetch_images(const ReaderMapping& root) const;
+  void prefetch_imagespecs(const ReaderMapping& images_mapping) const;
+
+  /** Fills blocks[i] from entries[i], spread over the image decoder's
+      workers */
+  void parse_blocks(const std::vector<std::pair<std::string, ReaderMapping> >& entries,
+                    std::vector<Block>& blocks) const;
+  void parse_block(const std::string& key, const ReaderMapping& entry, Block& block) const;
+  void add_block(const Block& block);
+
+  void parse_tile(const ReaderMapping& reader, Block& block) const;
+  void parse_tiles(const ReaderMapping& reader, Block& block) const;
+  std::vector<ImageSpec> parse_imagespecs(const ReaderMapping& cur, Block& block,
+                                          const boost::optional<Rect>& region = boost::none) const;
+  std::vector<SurfacePtr> create_surfaces(const std::vector<ImageSpec>& specs) const;
 
 private:
   TileSetParser(const TileSetParser&) = delete;
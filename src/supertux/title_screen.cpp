@@ -41,7 +41,7 @@
 TitleScreen::TitleScreen(Savegame& savegame) :
   m_frame(Surface::from_file("images/engine/menu/frame.png")),
   m_controller(new CodeController()),
-  m_titlesession(new GameSession("levels/misc/menu.stl", savegame)),
+  m_titlesession(new GameSession("levels/misc/menu.stl", savegame, nullptr, false)),
   m_copyright_text("SuperTux " PACKAGE_VERSION "\n" +
     _("Copyright") + " (c) 2003-2018 SuperTux Devel Team\n" +
     _("This game comes with ABSOLUTELY NO WARRANTY. This is free software, and you are welcome to\n"
@@ -109,12 +109,12 @@ TitleScreen::leave()
 }
 
 void
-TitleScreen::draw(Compositor& compositor)
+TitleScreen::draw(Compositor& compositor, float alpha)
 {
   auto& context = compositor.make_context();
 
   Sector& sector  = m_titlesession->get_current_sector();
-  sector.draw(context);
+  sector.draw(context, alpha);
 
   context.color().draw_surface_scaled(m_frame,
                                       Rectf(0, 0, static_cast<float>(context.get_width()), static_cast<float>(context.get_height())),
@@ -44,7 +44,7 @@ Climbable::Climbable(const ReaderMapping& reader) :
   float w = 32, h = 32;
   reader.get("width", w);
   reader.get("height", h);
-  m_col.m_bbox.set_size(w, h);
+  m_col.set_size(w, h);
   new_size.x = w;
   new_size.y = h;
   reader.get("message", message);
@@ -56,7 +56,8 @@ Climbable::Climbable(const Rectf& area) :
   message(),
   new_size()
 {
-  m_col.m_bbox = area;
+  m_col.set_pos(area.p1());
+  m_col.set_size(area.get_width(), area.get_height());
 }
 
 Climbable::~Climbable()
@@ -87,7 +88,7 @@ Climbable::get_settings()
 
 void
 Climbable::after_editor_set() {
-  m_col.m_bbox.set_size(new_size.x, new_size.y);
+  m_col.set_size(new_size.x, new_size.y);
 }
 
 void
@@ -43,7 +43,7 @@ Door::Door(const ReaderMapping& mapping) :
   mapping.get("script", script);
 
   sprite->set_action("closed");
-  m_col.m_bbox.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+  m_col.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 
   SoundManager::current()->preload("sounds/door.wav");
 }
@@ -57,10 +57,10 @@ Door::Door(int x, int y, const std::string& sector, const std::string& spawnpoin
   sprite(SpriteManager::current()->create("images/objects/door/door.sprite")),
   stay_open_timer()
 {
-  m_col.m_bbox.set_pos(Vector(static_cast<float>(x), static_cast<float>(y)));
+  m_col.set_pos(Vector(static_cast<float>(x), static_cast<float>(y)));
 
   sprite->set_action("closed");
-  m_col.m_bbox.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+  m_col.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 
   SoundManager::current()->preload("sounds/door.wav");
 }
@@ -43,7 +43,7 @@ SecretAreaTrigger::SecretAreaTrigger(const ReaderMapping& reader) :
   float w,h;
   reader.get("width", w, 32.0f);
   reader.get("height", h, 32.0f);
-  m_col.m_bbox.set_size(w, h);
+  m_col.set_size(w, h);
   new_size.x = w;
   new_size.y = h;
   reader.get("fade-tilemap", fade_tilemap);
@@ -62,7 +62,8 @@ SecretAreaTrigger::SecretAreaTrigger(const Rectf& area, const std::string& fade_
   script(),
   new_size()
 {
-  m_col.m_bbox = area;
+  m_col.set_pos(area.p1());
+  m_col.set_size(area.get_width(), area.get_height());
 }
 
 ObjectSettings
@@ -86,7 +87,7 @@ SecretAreaTrigger::get_settings()
 void
 SecretAreaTrigger::after_editor_set()
 {
-  m_col.m_bbox.set_size(new_size.x, new_size.y);
+  m_col.set_size(new_size.x, new_size.y);
 }
 
 std::string
@@ -41,7 +41,7 @@ Switch::Switch(const ReaderMapping& reader) :
   if (!reader.get("y", m_col.m_bbox.get_top())) throw std::runtime_error("no y position set");
   if (!reader.get("sprite", sprite_name)) sprite_name = "images/objects/switch/left.sprite";
   sprite = SpriteManager::current()->create(sprite_name);
-  m_col.m_bbox.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
+  m_col.set_size(sprite->get_current_hitbox_width(), sprite->get_current_hitbox_height());
 
   reader.get("script", script);
   bistable = reader.get("off-script", off_script);
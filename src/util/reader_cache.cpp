@@ -0,0 +1,531 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/reader_cache.hpp"
+
+#include <iterator>
+#include <memory>
+#include <physfs.h>
+#include <sstream>
+#include <stdexcept>
+#include <string.h>
+#include <unordered_map>
+#include <vector>
+
+#include "physfs/ifile_stream.hpp"
+#include "physfs/ofile_stream.hpp"
+#include "util/file_system.hpp"
+#include "util/log.hpp"
+#include "util/reader_document.hpp"
+#include "util/string_util.hpp"
+
+namespace {
+
+const char CACHE_MAGIC[4] = { 'S', 'T', 'R', 'C' };
+
+/** Bump this whenever the layout of the cache files changes */
+const uint32_t CACHE_VERSION = 2;
+
+enum NodeType : uint8_t
+{
+  NODE_NIL,
+  NODE_BOOLEAN,
+  NODE_INTEGER,
+  NODE_REAL,
+  NODE_STRING,
+  NODE_SYMBOL,
+  NODE_CONS,
+  NODE_ARRAY
+};
+
+class BinaryWriter final
+{
+public:
+  BinaryWriter() : m_data() {}
+
+  template<typename T>
+  void write(T value)
+  {
+    m_data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void write_string(const std::string& text)
+  {
+    write(static_cast<uint32_t>(text.size()));
+    m_data.append(text);
+  }
+
+  void write_array(const uint32_t* values, size_t count)
+  {
+    m_data.append(reinterpret_cast<const char*>(values), count * sizeof(uint32_t));
+  }
+
+  std::string& get_data() { return m_data; }
+
+private:
+  std::string m_data;
+};
+
+class BinaryReader final
+{
+public:
+  BinaryReader(const std::string& data) : m_data(data), m_pos(0) {}
+
+  template<typename T>
+  T read()
+  {
+    T value;
+    memcpy(&value, take(sizeof(value)), sizeof(value));
+    return value;
+  }
+
+  std::string read_string()
+  {
+    const uint32_t len = read<uint32_t>();
+    return std::string(take(len), len);
+  }
+
+  /** Reads an element count, throws if there isn't room for that many
+      elements of at least min_size bytes */
+  uint32_t read_count(size_t min_size)
+  {
+    const uint32_t count = read<uint32_t>();
+    if (count > (m_data.size() - m_pos) / min_size)
+    {
+      throw std::runtime_error("bogus element count in cache data");
+    }
+    return count;
+  }
+
+  void read_array(uint32_t* values, size_t count)
+  {
+    memcpy(values, take(count * sizeof(uint32_t)), count * sizeof(uint32_t));
+  }
+
+  bool at_end() const { return m_pos == m_data.size(); }
+
+private:
+  const char* take(size_t len)
+  {
+    if (len > m_data.size() - m_pos)
+    {
+      throw std::runtime_error("unexpected end of cache data");
+    }
+    const char* result = m_data.data() + m_pos;
+    m_pos += len;
+    return result;
+  }
+
+private:
+  const std::string& m_data;
+  size_t m_pos;
+
+private:
+  BinaryReader(const BinaryReader&) = delete;
+  BinaryReader& operator=(const BinaryReader&) = delete;
+};
+
+typedef std::unordered_map<std::string, uint32_t> StringTable;
+
+void collect_strings(const sexp::Value& sx, StringTable& table, std::vector<const std::string*>& strings)
+{
+  switch (sx.get_type())
+  {
+    case sexp::Value::Type::STRING:
+    case sexp::Value::Type::SYMBOL:
+      {
+        auto it = table.emplace(sx.as_string(), static_cast<uint32_t>(strings.size()));
+        if (it.second)
+        {
+          strings.push_back(&it.first->first);
+        }
+      }
+      break;
+
+    case sexp::Value::Type::CONS:
+      collect_strings(sx.get_car(), table, strings);
+      collect_strings(sx.get_cdr(), table, strings);
+      break;
+
+    case sexp::Value::Type::ARRAY:
+      for (const auto& item : sx.as_array())
+      {
+        collect_strings(item, table, strings);
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+void write_node(BinaryWriter& writer, const sexp::Value& sx, const StringTable& table)
+{
+  switch (sx.get_type())
+  {
+    case sexp::Value::Type::NIL:
+      writer.write(NODE_NIL);
+      break;
+
+    case sexp::Value::Type::BOOLEAN:
+      writer.write(NODE_BOOLEAN);
+      writer.write(static_cast<uint8_t>(sx.as_bool()));
+      break;
+
+    case sexp::Value::Type::INTEGER:
+      writer.write(NODE_INTEGER);
+      writer.write(static_cast<int32_t>(sx.as_int()));
+      break;
+
+    case sexp::Value::Type::REAL:
+      writer.write(NODE_REAL);
+      writer.write(sx.as_float());
+      break;
+
+    case sexp::Value::Type::STRING:
+      writer.write(NODE_STRING);
+      writer.write(table.at(sx.as_string()));
+      break;
+
+    case sexp::Value::Type::SYMBOL:
+      writer.write(NODE_SYMBOL);
+      writer.write(table.at(sx.as_string()));
+      break;
+
+    case sexp::Value::Type::CONS:
+      writer.write(NODE_CONS);
+      write_node(writer, sx.get_car(), table);
+      write_node(writer, sx.get_cdr(), table);
+      break;
+
+    case sexp::Value::Type::ARRAY:
+      writer.write(NODE_ARRAY);
+      writer.write(static_cast<uint32_t>(sx.as_array().size()));
+      for (const auto& item : sx.as_array())
+      {
+        write_node(writer, item, table);
+      }
+      break;
+  }
+}
+
+sexp::Value read_node(BinaryReader& reader, const std::vector<std::string>& strings)
+{
+  const auto type = reader.read<uint8_t>();
+  switch (type)
+  {
+    case NODE_NIL:
+      return sexp::Value::nil();
+
+    case NODE_BOOLEAN:
+      return sexp::Value::boolean(reader.read<uint8_t>() != 0);
+
+    case NODE_INTEGER:
+      return sexp::Value::integer(reader.read<int32_t>());
+
+    case NODE_REAL:
+      return sexp::Value::real(reader.read<float>());
+
+    case NODE_STRING:
+      return sexp::Value::string(strings.at(reader.read<uint32_t>()));
+
+    case NODE_SYMBOL:
+      return sexp::Value::symbol(strings.at(reader.read<uint32_t>()));
+
+    case NODE_CONS:
+      {
+        sexp::Value car = read_node(reader, strings);
+        sexp::Value cdr = read_node(reader, strings);
+        return sexp::Value::cons(std::move(car), std::move(cdr));
+      }
+
+    case NODE_ARRAY:
+      {
+        const uint32_t count = reader.read_count(1);
+        std::vector<sexp::Value> items;
+        items.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          items.push_back(read_node(reader, strings));
+        }
+        return sexp::Value::array(std::move(items));
+      }
+
+    default:
+      throw std::runtime_error("unknown node type in cache data");
+  }
+}
+
+void serialize_tree(BinaryWriter& writer, const sexp::Value& sx)
+{
+  StringTable table;
+  std::vector<const std::string*> strings;
+  collect_strings(sx, table, strings);
+
+  writer.write(static_cast<uint32_t>(strings.size()));
+  for (const auto& text : strings)
+  {
+    writer.write_string(*text);
+  }
+
+  write_node(writer, sx, table);
+}
+
+sexp::Value deserialize_tree(BinaryReader& reader)
+{
+  const uint32_t count = reader.read_count(sizeof(uint32_t));
+  std::vector<std::string> strings;
+  strings.reserve(count);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    strings.push_back(reader.read_string());
+  }
+
+  return read_node(reader, strings);
+}
+
+void serialize_tile_blocks(BinaryWriter& writer, const std::vector<std::vector<uint32_t> >& blocks)
+{
+  writer.write(static_cast<uint32_t>(blocks.size()));
+  for (const auto& block : blocks)
+  {
+    writer.write(static_cast<uint32_t>(block.size()));
+    writer.write_array(block.data(), block.size());
+  }
+}
+
+std::vector<std::vector<uint32_t> > deserialize_tile_blocks(BinaryReader& reader)
+{
+  std::vector<std::vector<uint32_t> > blocks(reader.read_count(sizeof(uint32_t)));
+  for (auto& block : blocks)
+  {
+    block.resize(reader.read_count(sizeof(uint32_t)));
+    reader.read_array(block.data(), block.size());
+  }
+  return blocks;
+}
+
+/** FNV-1a, unlike std::hash it gives the same result in every build */
+uint64_t hash_filename(const std::string& filename)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : filename)
+  {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+} // namespace
+
+std::string
+ReaderCache::serialize(const sexp::Value& sx)
+{
+  BinaryWriter writer;
+  serialize_tree(writer, sx);
+  return std::move(writer.get_data());
+}
+
+sexp::Value
+ReaderCache::deserialize(const std::string& data)
+{
+  BinaryReader reader(data);
+  sexp::Value sx = deserialize_tree(reader);
+  if (!reader.at_end())
+  {
+    throw std::runtime_error("trailing garbage in cache data");
+  }
+  return sx;
+}
+
+bool
+ReaderCache::is_cacheable(const std::string& filename)
+{
+  return (StringUtil::has_suffix(filename, ".stl") ||
+          StringUtil::has_suffix(filename, ".stwm") ||
+          StringUtil::has_suffix(filename, ".sprite") ||
+          StringUtil::has_suffix(filename, ".strf"));
+}
+
+ReaderCache::ReaderCache(const std::string& directory, bool rebuild) :
+  m_directory(directory),
+  m_enabled(false),
+  m_hits(0),
+  m_misses(0)
+{
+  if (!PHYSFS_getWriteDir())
+  {
+    log_info << "no user directory, reader cache disabled" << std::endl;
+    return;
+  }
+
+  if (!PHYSFS_mkdir(m_directory.c_str()))
+  {
+    log_warning << "couldn't create reader cache directory '" << m_directory << "': "
+                << PHYSFS_getLastErrorCode() << std::endl;
+    return;
+  }
+
+  if (rebuild)
+  {
+    std::unique_ptr<char*, decltype(&PHYSFS_freeList)>
+      files(PHYSFS_enumerateFiles(m_directory.c_str()),
+            PHYSFS_freeList);
+    for (char** i = files.get(); *i != nullptr; ++i)
+    {
+      const std::string cache_filename = FileSystem::join(m_directory, *i);
+      if (!PHYSFS_delete(cache_filename.c_str()))
+      {
+        log_warning << "PHYSFS_delete failed on '" << cache_filename << "': "
+                    << PHYSFS_getLastErrorCode() << std::endl;
+      }
+    }
+  }
+
+  m_enabled = true;
+}
+
+ReaderCache::~ReaderCache()
+{
+  log_info << "reader cache: " << m_hits << " hits, " << m_misses << " misses" << std::endl;
+}
+
+boost::optional<ReaderDocument>
+ReaderCache::load(const std::string& filename)
+{
+  if (!m_enabled || !is_cacheable(filename))
+  {
+    return boost::none;
+  }
+
+  int64_t size;
+  int64_t mtime;
+  const std::string cache_filename = get_cache_filename(filename);
+  if (!get_file_info(filename, size, mtime) ||
+      !PHYSFS_exists(cache_filename.c_str()))
+  {
+    m_misses += 1;
+    return boost::none;
+  }
+
+  try
+  {
+    IFileStream in(cache_filename);
+    const std::string data((std::istreambuf_iterator<char>(in)),
+                           std::istreambuf_iterator<char>());
+
+    BinaryReader reader(data);
+    char magic[sizeof(CACHE_MAGIC)];
+    for (auto& c : magic)
+    {
+      c = reader.read<char>();
+    }
+
+    if (memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        reader.read<uint32_t>() != CACHE_VERSION ||
+        reader.read<int64_t>() != size ||
+        reader.read<int64_t>() != mtime ||
+        reader.read_string() != filename)
+    {
+      // stale entry, it gets overwritten by store()
+      m_misses += 1;
+      return boost::none;
+    }
+
+    sexp::Value sx = deserialize_tree(reader);
+    auto tile_blocks = deserialize_tile_blocks(reader);
+    if (!reader.at_end())
+    {
+      throw std::runtime_error("trailing garbage in cache data");
+    }
+
+    m_hits += 1;
+    return ReaderDocument(filename, std::move(sx), std::move(tile_blocks));
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "broken reader cache entry '" << cache_filename << "' for '"
+                << filename << "': " << err.what() << std::endl;
+    m_misses += 1;
+    return boost::none;
+  }
+}
+
+void
+ReaderCache::store(const ReaderDocument& doc)
+{
+  const std::string filename = doc.get_filename();
+  if (!m_enabled || !is_cacheable(filename))
+  {
+    return;
+  }
+
+  int64_t size;
+  int64_t mtime;
+  if (!get_file_info(filename, size, mtime))
+  {
+    return;
+  }
+
+  BinaryWriter writer;
+  for (const char c : CACHE_MAGIC)
+  {
+    writer.write(c);
+  }
+  writer.write(CACHE_VERSION);
+  writer.write(size);
+  writer.write(mtime);
+  writer.write_string(filename);
+  serialize_tree(writer, doc.get_sexp());
+  serialize_tile_blocks(writer, doc.get_tile_blocks());
+
+  const std::string cache_filename = get_cache_filename(filename);
+  try
+  {
+    OFileStream out(cache_filename);
+    out.write(writer.get_data().data(), writer.get_data().size());
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "couldn't write reader cache entry '" << cache_filename << "': "
+                << err.what() << std::endl;
+  }
+}
+
+std::string
+ReaderCache::get_cache_filename(const std::string& filename) const
+{
+  std::ostringstream out;
+  out << m_directory << "/" << std::hex << hash_filename(filename) << ".bin";
+  return out.str();
+}
+
+bool
+ReaderCache::get_file_info(const std::string& filename, int64_t& size, int64_t& mtime) const
+{
+  PHYSFS_Stat statbuf;
+  if (!PHYSFS_stat(filename.c_str(), &statbuf))
+  {
+    return false;
+  }
+
+  size = statbuf.filesize;
+  mtime = statbuf.modtime;
+  return true;
+}
+
+/* EOF */
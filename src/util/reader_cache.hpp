@@ -0,0 +1,79 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_READER_CACHE_HPP
+#define HEADER_SUPERTUX_UTIL_READER_CACHE_HPP
+
+#include <string>
+#include <boost/optional.hpp>
+#include <sexp/value.hpp>
+
+#include "util/currenton.hpp"
+
+class ReaderDocument;
+
+/** Keeps the parsed trees of levels, worldmaps, sprites and tilesets
+    in a binary form in the user directory, so that ReaderDocument
+    doesn't have to tokenize them again on the next load. Entries are
+    keyed by path, size and modification time of the source file. */
+class ReaderCache final : public Currenton<ReaderCache>
+{
+public:
+  /** Turns sx into the binary cache format. All strings and symbols
+      go into a table at the front, so that every repeated key is only
+      stored once, nodes follow in preorder with fixed size fields. */
+  static std::string serialize(const sexp::Value& sx);
+
+  /** Throws on malformed data */
+  static sexp::Value deserialize(const std::string& data);
+
+  /** Returns true for the file types that are worth caching */
+  static bool is_cacheable(const std::string& filename);
+
+public:
+  /** With rebuild set, all existing entries are thrown away */
+  ReaderCache(const std::string& directory = "cache/reader", bool rebuild = false);
+  ~ReaderCache();
+
+  /** Returns the cached document of filename, or none if there is no
+      entry or the file changed since it was written */
+  boost::optional<ReaderDocument> load(const std::string& filename);
+
+  /** Writes the tree and the tile blocks of doc, which has to come
+      straight from the file named by doc.get_filename() */
+  void store(const ReaderDocument& doc);
+
+  int get_hits() const { return m_hits; }
+  int get_misses() const { return m_misses; }
+
+private:
+  std::string get_cache_filename(const std::string& filename) const;
+  bool get_file_info(const std::string& filename, int64_t& size, int64_t& mtime) const;
+
+private:
+  std::string m_directory;
+  bool m_enabled;
+  int m_hits;
+  int m_misses;
+
+private:
+  ReaderCache(const ReaderCache&) = delete;
+  ReaderCache& operator=(const ReaderCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -16,23 +16,42 @@
 
 #include "util/reader_document.hpp"
 
+#include <iterator>
 #include <sexp/parser.hpp>
 #include <sstream>
 
 #include "physfs/ifile_stream.hpp"
 #include "util/file_system.hpp"
+#include "util/reader_cache.hpp"
+#include "util/tiles_parser.hpp"
 #include "util/log.hpp"
 
 ReaderDocument
 ReaderDocument::from_stream(std::istream& stream, const std::string& filename)
 {
-  sexp::Value sx = sexp::Parser::from_stream(stream, sexp::Parser::USE_ARRAYS);
-  return ReaderDocument(filename, std::move(sx));
+  std::string text((std::istreambuf_iterator<char>(stream)),
+                   std::istreambuf_iterator<char>());
+
+  std::vector<std::vector<uint32_t> > tile_blocks;
+  TilesParser::extract(text, tile_blocks);
+
+  std::istringstream in(text);
+  sexp::Value sx = sexp::Parser::from_stream(in, sexp::Parser::USE_ARRAYS);
+  return ReaderDocument(filename, std::move(sx), std::move(tile_blocks));
 }
 
 ReaderDocument
 ReaderDocument::from_file(const std::string& filename)
 {
+  ReaderCache* cache = ReaderCache::current();
+  if (cache)
+  {
+    if (auto doc = cache->load(filename))
+    {
+      return std::move(*doc);
+    }
+  }
+
   log_debug << "ReaderDocument::parse: " << filename << std::endl;
 
   IFileStream in(filename);
@@ -41,16 +60,41 @@ ReaderDocument::from_file(const std::string& filename)
     msg << "Parser problem: Couldn't open file '" << filename << "'.";
     throw std::runtime_error(msg.str());
   } else {
-    return from_stream(in, filename);
+    ReaderDocument doc = from_stream(in, filename);
+    if (cache)
+    {
+      cache->store(doc);
+    }
+    return doc;
   }
 }
 
-ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx) :
+ReaderDocument::ReaderDocument(const std::string& filename, sexp::Value sx,
+                               std::vector<std::vector<uint32_t> > tile_blocks) :
   m_filename(filename),
-  m_sx(std::move(sx))
+  m_sx(std::move(sx)),
+  m_tile_blocks(std::move(tile_blocks))
 {
 }
 
+const std::vector<uint32_t>*
+ReaderDocument::get_tile_block(const sexp::Value& sx) const
+{
+  if (sx.is_array() &&
+      sx.as_array().size() == 2 &&
+      sx.as_array()[0].is_symbol() &&
+      sx.as_array()[0].as_string() == TilesParser::BLOCK_SYMBOL &&
+      sx.as_array()[1].is_integer())
+  {
+    const int idx = sx.as_array()[1].as_int();
+    if (idx >= 0 && static_cast<size_t>(idx) < m_tile_blocks.size())
+    {
+      return &m_tile_blocks[idx];
+    }
+  }
+  return nullptr;
+}
+
 ReaderObject
 ReaderDocument::get_root() const
 {
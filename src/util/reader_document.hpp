@@ -18,6 +18,8 @@
 #define HEADER_SUPERTUX_UTIL_READER_DOCUMENT_HPP
 
 #include <istream>
+#include <stdint.h>
+#include <vector>
 #include <sexp/value.hpp>
 
 #include "util/reader_object.hpp"
@@ -31,7 +33,8 @@ public:
   static ReaderDocument from_file(const std::string& filename);
 
 public:
-  ReaderDocument(const std::string& filename, sexp::Value sx);
+  ReaderDocument(const std::string& filename, sexp::Value sx,
+                 std::vector<std::vector<uint32_t> > tile_blocks = {});
 
   /** Returns the root object */
   ReaderObject get_root() const;
@@ -44,9 +47,16 @@ public:
 
   const sexp::Value& get_sexp() const { return m_sx; }
 
+  /** Returns the tile ids of a (tile-block N) reference left by
+      TilesParser, or nullptr if sx is something else */
+  const std::vector<uint32_t>* get_tile_block(const sexp::Value& sx) const;
+
+  const std::vector<std::vector<uint32_t> >& get_tile_blocks() const { return m_tile_blocks; }
+
 private:
   std::string m_filename;
   sexp::Value m_sx;
+  std::vector<std::vector<uint32_t> > m_tile_blocks;
 };
 
 #endif
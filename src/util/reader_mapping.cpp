@@ -27,12 +27,32 @@
 #include "util/reader_document.hpp"
 #include "util/reader_error.hpp"
 
+namespace {
+
+/** Mappings up to this size are faster to scan than to index */
+const size_t INDEX_THRESHOLD = 8;
+
+uint32_t hash_key(const char* key)
+{
+  uint32_t hash = 2166136261u;
+  for (; *key; ++key)
+  {
+    hash ^= static_cast<uint8_t>(*key);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+} // namespace
+
 bool ReaderMapping::s_translations_enabled = true;
 
 ReaderMapping::ReaderMapping(const ReaderDocument& doc, const sexp::Value& sx) :
   m_doc(doc),
   m_sx(sx),
-  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}())
+  m_arr([this]() -> decltype(m_arr){ assert_is_array(m_doc, m_sx); return m_sx.as_array();}()),
+  m_index(),
+  m_indexed(false)
 {
 }
 
@@ -44,9 +64,75 @@ ReaderMapping::get_iter() const
   return ReaderIterator(m_doc, m_sx);
 }
 
+void
+ReaderMapping::build_index() const
+{
+  m_indexed = true;
+
+  size_t size = 1;
+  while (size < 2 * m_arr.size())
+  {
+    size *= 2;
+  }
+
+  std::vector<IndexSlot> index(size, IndexSlot{0, 0});
+  const size_t mask = size - 1;
+  for (size_t i = 1; i < m_arr.size(); ++i)
+  {
+    auto const& pair = m_arr[i];
+    if (!pair.is_array() || pair.as_array().empty() || !pair.as_array()[0].is_symbol())
+    {
+      return;
+    }
+
+    const std::string& name = pair.as_array()[0].as_string();
+    const uint32_t hash = hash_key(name.c_str());
+    size_t slot = hash & mask;
+    while (index[slot].pos != 0 &&
+           !(index[slot].hash == hash && m_arr[index[slot].pos].as_array()[0].as_string() == name))
+    {
+      slot = (slot + 1) & mask;
+    }
+
+    // like the scan, the first entry with a given key wins
+    if (index[slot].pos == 0)
+    {
+      index[slot] = IndexSlot{hash, static_cast<uint32_t>(i)};
+    }
+  }
+
+  m_index = std::move(index);
+}
+
 const sexp::Value*
 ReaderMapping::get_item(const char* key) const
 {
+  if (m_arr.size() > INDEX_THRESHOLD)
+  {
+    if (!m_indexed)
+    {
+      build_index();
+    }
+
+    if (!m_index.empty())
+    {
+      const uint32_t hash = hash_key(key);
+      const size_t mask = m_index.size() - 1;
+      for (size_t slot = hash & mask; m_index[slot].pos != 0; slot = (slot + 1) & mask)
+      {
+        if (m_index[slot].hash == hash)
+        {
+          auto const& pair = m_arr[m_index[slot].pos];
+          if (pair.as_array()[0].as_string() == key)
+          {
+            return &pair;
+          }
+        }
+      }
+      return nullptr;
+    }
+  }
+
   for (size_t i = 1; i < m_arr.size(); ++i)
   {
     auto const& pair = m_arr[i];
@@ -139,6 +225,20 @@ ReaderMapping::get(const char* key, std::string& value, const boost::optional<co
   }
 }
 
+const std::vector<uint32_t>*
+ReaderMapping::get_tile_block(const char* key) const
+{
+  auto const sx = get_item(key);
+  if (sx && sx->as_array().size() == 2)
+  {
+    return m_doc.get_tile_block(sx->as_array()[1]);
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
 #define GET_VALUES_MACRO(type, checker, getter)                         \
   auto const sx = get_item(key);                                        \
   if (!sx) {                                                            \
@@ -165,6 +265,11 @@ bool
 ReaderMapping::get(const char* key, std::vector<int>& value) const
 {
   value.clear();
+  if (auto const block = get_tile_block(key))
+  {
+    value.assign(block->begin(), block->end());
+    return true;
+  }
   GET_VALUES_MACRO("int", is_integer, as_int);
 }
 
@@ -187,6 +292,11 @@ bool
 ReaderMapping::get(const char* key, std::vector<unsigned int>& value) const
 {
   value.clear();
+  if (auto const block = get_tile_block(key))
+  {
+    value.assign(block->begin(), block->end());
+    return true;
+  }
   GET_VALUES_MACRO("unsigned int", is_integer, as_int);
 }
 
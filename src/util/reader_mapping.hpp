@@ -18,6 +18,7 @@
 #define HEADER_SUPERTUX_UTIL_READER_MAPPING_HPP
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "util/reader_iterator.hpp"
 
@@ -86,10 +87,31 @@ private:
   /** Returns pointer to (key value) */
   const sexp::Value* get_item(const char* key) const;
 
+  /** Returns the ids of (key (tile-block N)), see TilesParser */
+  const std::vector<uint32_t>* get_tile_block(const char* key) const;
+
+  /** Fills m_index, leaves it empty when the mapping is malformed so
+      that get_item() falls back to the scan that reports the error */
+  void build_index() const;
+
+private:
+  struct IndexSlot
+  {
+    uint32_t hash;
+
+    /** Position of the entry in m_arr, 0 marks an empty slot */
+    uint32_t pos;
+  };
+
 private:
   const ReaderDocument& m_doc;
   const sexp::Value& m_sx;
   const std::vector<sexp::Value>& m_arr;
+
+  /** Open addressing table from key to entry, created on the first
+      lookup in larger mappings */
+  mutable std::vector<IndexSlot> m_index;
+  mutable bool m_indexed;
 };
 
 #endif
@@ -0,0 +1,95 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_SPSC_QUEUE_HPP
+#define HEADER_SUPERTUX_UTIL_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+/** Fixed size queue that one thread pushes to and another one pops
+    from without taking a lock. Calling push() from more than one
+    thread, or pop() from more than one thread, is not safe. */
+template<typename T>
+class SPSCQueue final
+{
+public:
+  SPSCQueue(size_t capacity) :
+    m_items(capacity + 1),
+    m_head(0),
+    m_tail(0)
+  {
+  }
+
+  /** Returns false when the queue is full, only to be called from the
+      producer thread */
+  bool push(T item)
+  {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t next = (tail + 1) % m_items.size();
+    if (next == m_head.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+
+    m_items[tail] = std::move(item);
+    m_tail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /** Returns false when the queue is empty, only to be called from
+      the consumer thread */
+  bool pop(T& item)
+  {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+
+    item = std::move(m_items[head]);
+    m_head.store((head + 1) % m_items.size(), std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const
+  {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const { return m_items.size() - 1; }
+
+private:
+  /** One slot more than the capacity, so that a full queue can be told
+      apart from an empty one */
+  std::vector<T> m_items;
+
+  /** Next slot to pop, only written by the consumer */
+  std::atomic<size_t> m_head;
+
+  /** Next slot to push to, only written by the producer */
+  std::atomic<size_t> m_tail;
+
+private:
+  SPSCQueue(const SPSCQueue&) = delete;
+  SPSCQueue& operator=(const SPSCQueue&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -0,0 +1,212 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/tiles_parser.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+/** Upper limit for a single run, anything larger is most likely
+    garbage and left for the regular parser to complain about */
+const uint32_t MAX_RUN_LENGTH = 1u << 24;
+
+bool is_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool is_delimiter(char c)
+{
+  return is_space(c) || c == '(' || c == ')' || c == ';' || c == '"';
+}
+
+void skip_space(const char*& p, const char* end)
+{
+  while (p != end)
+  {
+    if (is_space(*p))
+    {
+      ++p;
+    }
+    else if (*p == ';')
+    {
+      while (p != end && *p != '\n') ++p;
+    }
+    else
+    {
+      return;
+    }
+  }
+}
+
+bool parse_uint(const char*& p, const char* end, uint32_t& value)
+{
+  uint64_t result = 0;
+  const char* start = p;
+  while (p != end && *p >= '0' && *p <= '9')
+  {
+    result = result * 10 + static_cast<uint64_t>(*p - '0');
+    if (result > UINT32_MAX)
+    {
+      return false;
+    }
+    ++p;
+  }
+
+  if (p == start || (p != end && !is_delimiter(*p)))
+  {
+    return false;
+  }
+
+  value = static_cast<uint32_t>(result);
+  return true;
+}
+
+/** Parses "rle ID COUNT)", p points behind the opening paren */
+bool parse_run(const char*& p, const char* end, std::vector<uint32_t>& ids)
+{
+  if (end - p < 4 || strncmp(p, "rle", 3) != 0 || !is_space(p[3]))
+  {
+    return false;
+  }
+  p += 3;
+
+  uint32_t id;
+  uint32_t count;
+  skip_space(p, end);
+  if (!parse_uint(p, end, id))
+  {
+    return false;
+  }
+  skip_space(p, end);
+  if (!parse_uint(p, end, count) || count > MAX_RUN_LENGTH)
+  {
+    return false;
+  }
+  skip_space(p, end);
+  if (p == end || *p != ')')
+  {
+    return false;
+  }
+  ++p;
+
+  ids.insert(ids.end(), count, id);
+  return true;
+}
+
+} // namespace
+
+const char* const TilesParser::BLOCK_SYMBOL = "tile-block";
+
+bool
+TilesParser::parse(const char*& p, const char* end, std::vector<uint32_t>& ids)
+{
+  while (true)
+  {
+    skip_space(p, end);
+    if (p == end)
+    {
+      return false;
+    }
+    else if (*p == ')')
+    {
+      return true;
+    }
+    else if (*p == '(')
+    {
+      ++p;
+      if (!parse_run(p, end, ids))
+      {
+        return false;
+      }
+    }
+    else
+    {
+      uint32_t id;
+      if (!parse_uint(p, end, id))
+      {
+        return false;
+      }
+      ids.push_back(id);
+    }
+  }
+}
+
+void
+TilesParser::extract(std::string& text, std::vector<std::vector<uint32_t> >& blocks)
+{
+  std::string result;
+  size_t copied = 0;
+
+  const char* const begin = text.data();
+  const char* const end = begin + text.size();
+  const char* p = begin;
+  while (p != end)
+  {
+    if (*p == ';')
+    {
+      while (p != end && *p != '\n') ++p;
+    }
+    else if (*p == '"')
+    {
+      for (++p; p != end && *p != '"'; ++p)
+      {
+        if (*p == '\\' && p + 1 != end) ++p;
+      }
+      if (p != end) ++p;
+    }
+    else if (*p == '(' && end - p > 6 && strncmp(p + 1, "tiles", 5) == 0 && is_space(p[6]))
+    {
+      const char* body = p + 6;
+      const char* q = body;
+      std::vector<uint32_t> ids;
+      if (parse(q, end, ids))
+      {
+        if (result.empty())
+        {
+          result.reserve(text.size());
+        }
+        result.append(text, copied, static_cast<size_t>(body - begin) - copied);
+        result += " (";
+        result += BLOCK_SYMBOL;
+        result += " " + std::to_string(blocks.size()) + ")";
+        result.append(static_cast<size_t>(std::count(body, q, '\n')), '\n');
+        copied = static_cast<size_t>(q - begin);
+
+        blocks.push_back(std::move(ids));
+        p = q;
+      }
+      else
+      {
+        p = body;
+      }
+    }
+    else
+    {
+      ++p;
+    }
+  }
+
+  if (copied != 0)
+  {
+    result.append(text, copied, std::string::npos);
+    text = std::move(result);
+  }
+}
+
+/* EOF */
@@ -0,0 +1,53 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_UTIL_TILES_PARSER_HPP
+#define HEADER_SUPERTUX_UTIL_TILES_PARSER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/** Fast path for the (tiles ...) lists of tilemaps, which make up most
+    of a level file. They are decoded straight from the document text,
+    before sexp::Parser sees it, so that no sexp::Value gets created
+    for each tile.
+
+    Besides plain tile ids a list can contain runs written as
+    (rle ID COUNT), as produced by Writer::write_tiles(). */
+class TilesParser final
+{
+public:
+  /** Name of the list that replaces the contents of a decoded (tiles
+      ...) list, (tiles (tile-block N)) refers to blocks[N] */
+  static const char* const BLOCK_SYMBOL;
+
+  /** Replaces the contents of every (tiles ...) list in text that
+      holds only tile ids and runs with a (tile-block N) reference to
+      the decoded ids, which get appended to blocks. Other lists are
+      left alone. Newlines are kept, so line numbers in error messages
+      stay the same. */
+  static void extract(std::string& text, std::vector<std::vector<uint32_t> >& blocks);
+
+  /** Decodes the contents of a tiles list, p has to point behind the
+      list name. Returns true and leaves p at the closing paren when
+      the list holds only tile ids and runs. */
+  static bool parse(const char*& p, const char* end, std::vector<uint32_t>& ids);
+};
+
+#endif
+
+/* EOF */
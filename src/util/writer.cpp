@@ -16,6 +16,7 @@
 
 #include "util/writer.hpp"
 
+#include <algorithm>
 #include <sexp/value.hpp>
 #include <sexp/io.hpp>
 
@@ -27,7 +28,8 @@ Writer::Writer(const std::string& filename) :
   out(new OFileStream(filename)),
   out_owned(true),
   indent_depth(0),
-  lists()
+  lists(),
+  m_rle_tiles(false)
 {
   out->precision(7);
 }
@@ -37,7 +39,8 @@ Writer::Writer(std::ostream& newout) :
   out(&newout),
   out_owned(false),
   indent_depth(0),
-  lists()
+  lists(),
+  m_rle_tiles(false)
 {
   out->precision(7);
 }
@@ -180,6 +183,54 @@ Writer::write(const std::string& name,
   *out << ")\n";
 }
 
+void
+Writer::write_tiles(const std::string& name,
+                    const std::vector<unsigned int>& value,
+                    int width)
+{
+  if (!m_rle_tiles)
+  {
+    write(name, value, width);
+    return;
+  }
+
+  // shorter runs take up less space written out
+  const size_t min_run = 4;
+
+  indent();
+  *out << '(' << name << "\n";
+  const size_t row_size = static_cast<size_t>(std::max(width, 1));
+  for (size_t row = 0; row < value.size(); row += row_size)
+  {
+    const size_t row_end = std::min(row + row_size, value.size());
+
+    indent();
+    for (size_t i = row; i < row_end;)
+    {
+      size_t run_end = i + 1;
+      while (run_end < row_end && value[run_end] == value[i])
+        run_end += 1;
+
+      if (i != row)
+        *out << " ";
+
+      if (run_end - i >= min_run)
+      {
+        *out << "(rle " << value[i] << " " << (run_end - i) << ")";
+        i = run_end;
+      }
+      else
+      {
+        *out << value[i];
+        i += 1;
+      }
+    }
+    *out << "\n";
+  }
+  indent();
+  *out << ")\n";
+}
+
 void
 Writer::write(const std::string& name,
               const std::vector<float>& value)
@@ -45,6 +45,13 @@ public:
   void write(const std::string& name, const std::vector<float>& value);
   void write(const std::string& name, const std::vector<std::string>& value);
   void write(const std::string& name, const sexp::Value& value);
+
+  /** Writes width tile ids per line. With set_rle_tiles(), runs of
+      the same id in a line are written as (rle ID COUNT), which only
+      TilesParser understands, older versions can't load them. */
+  void write_tiles(const std::string& name, const std::vector<unsigned int>& value, int width);
+
+  void set_rle_tiles(bool rle_tiles) { m_rle_tiles = rle_tiles; }
   // add more write-functions when needed...
 
   void end_list(const std::string& listname);
@@ -60,6 +67,7 @@ private:
   bool out_owned;
   int indent_depth;
   std::vector<std::string> lists;
+  bool m_rle_tiles;
 
 private:
   Writer(const Writer&) = delete;
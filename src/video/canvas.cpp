@@ -17,6 +17,8 @@
 #include "video/canvas.hpp"
 
 #include <algorithm>
+#include <assert.h>
+#include <memory>
 
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
@@ -24,13 +26,53 @@
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
 #include "video/renderer.hpp"
+#include "video/static_batch.hpp"
 #include "video/surface.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+/** Largest distance between the lowest and the highest layer in a
+    frame that is still handled by counting sort. Levels can use
+    arbitrary z-pos values, beyond that std::stable_sort is used. */
+const long MAX_LAYER_RANGE = 4096;
+
+/** Two texture requests can be drawn as one if nothing but their
+    quads differ. Only requests on the same layer get merged, so that
+    the lightmap filter in Canvas::render() stays intact. */
+bool can_merge(const DrawingRequest& lhs, const DrawingRequest& rhs)
+{
+  if (lhs.type != TEXTURE || rhs.type != TEXTURE)
+    return false;
+
+  const auto& lhs_tex = static_cast<const TextureRequest&>(lhs);
+  const auto& rhs_tex = static_cast<const TextureRequest&>(rhs);
+
+  if (lhs_tex.batch || rhs_tex.batch)
+    return false;
+
+  return (lhs.layer == rhs.layer &&
+          lhs.flip == rhs.flip &&
+          lhs.alpha == rhs.alpha &&
+          lhs.blend == rhs.blend &&
+          lhs_tex.texture == rhs_tex.texture &&
+          lhs_tex.displacement_texture == rhs_tex.displacement_texture &&
+          lhs_tex.offset == rhs_tex.offset &&
+          lhs_tex.color == rhs_tex.color);
+}
+
+} // namespace
+
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_pixel_outputs(),
+  m_sorted_requests(),
+  m_layer_offsets(),
+  m_prepared_size(0),
+  m_below_lightmap_end(0),
+  m_above_lightmap_begin(0)
 {
 }
 
@@ -42,33 +84,32 @@ Canvas::~Canvas()
 void
 Canvas::clear()
 {
-  for (auto& request : m_requests)
-  {
-    request->~DrawingRequest();
-  }
+  // requests are trivially destructible, their memory is released
+  // along with the obstack
   m_requests.clear();
+  m_pixel_outputs.clear();
+  m_prepared_size = 0;
+  m_below_lightmap_end = 0;
+  m_above_lightmap_begin = 0;
 }
 
-void
+int
 Canvas::render(Renderer& renderer, Filter filter)
 {
-  // On a regular level, each frame has around 50-250 requests (before
-  // batching it was 1000-3000), the sort comparator function is
-  // called approximatly 3-7 times for each request.
-  std::stable_sort(m_requests.begin(), m_requests.end(),
-                   [](const DrawingRequest* r1, const DrawingRequest* r2){
-                     return r1->layer < r2->layer;
-                   });
+  prepare_requests();
 
-  Painter& painter = renderer.get_painter();
+  size_t begin = 0;
+  size_t end = m_requests.size();
+  if (filter == BELOW_LIGHTMAP)
+    end = m_below_lightmap_end;
+  else if (filter == ABOVE_LIGHTMAP)
+    begin = m_above_lightmap_begin;
 
-  for (const auto& i : m_requests) {
-    const DrawingRequest& request = *i;
+  Painter& painter = renderer.get_painter();
+  int draw_calls = 0;
 
-    if (filter == BELOW_LIGHTMAP && request.layer >= LAYER_LIGHTMAP)
-      continue;
-    else if (filter == ABOVE_LIGHTMAP && request.layer <= LAYER_LIGHTMAP)
-      continue;
+  for (size_t i = begin; i < end; ++i) {
+    const DrawingRequest& request = *m_requests[i];
 
     switch (request.type) {
       case TEXTURE:
@@ -99,7 +140,13 @@ Canvas::render(Renderer& renderer, Filter filter)
         painter.get_pixel(static_cast<const GetPixelRequest&>(request));
         break;
     }
+
+    // reading back a pixel doesn't paint anything
+    if (request.type != GETPIXEL)
+      draw_calls += 1;
   }
+
+  return draw_calls;
 }
 
 void
@@ -118,7 +165,10 @@ Canvas::draw_surface(const SurfacePtr& surface,
      position.y + static_cast<float>(surface->get_height()) < cliprect.get_top())
     return;
 
-  auto request = new(m_obst) TextureRequest();
+  Rectf* srcrects;
+  Rectf* dstrects;
+  float* angles;
+  auto request = new_texture_request(1, srcrects, dstrects, angles);
 
   request->type = TEXTURE;
   request->layer = layer;
@@ -126,9 +176,9 @@ Canvas::draw_surface(const SurfacePtr& surface,
   request->alpha = m_context.transform().alpha;
   request->blend = blend;
 
-  request->srcrects.emplace_back(Rectf(surface->get_region()));
-  request->dstrects.emplace_back(Rectf(apply_translate(position), Size(surface->get_width(), surface->get_height())));
-  request->angles.emplace_back(angle);
+  new(&srcrects[0]) Rectf(surface->get_region());
+  new(&dstrects[0]) Rectf(apply_translate(position), Size(surface->get_width(), surface->get_height()));
+  angles[0] = angle;
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = color;
@@ -156,7 +206,10 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
 {
   if (!surface) return;
 
-  auto request = new(m_obst) TextureRequest();
+  Rectf* srcrects;
+  Rectf* dstrects;
+  float* angles;
+  auto request = new_texture_request(1, srcrects, dstrects, angles);
 
   request->type = TEXTURE;
   request->layer = layer;
@@ -164,9 +217,9 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
   request->alpha = m_context.transform().alpha * style.get_alpha();
   request->blend = style.get_blend();
 
-  request->srcrects.emplace_back(srcrect);
-  request->dstrects.emplace_back(apply_translate(dstrect.p1()), dstrect.get_size());
-  request->angles.emplace_back(0.0f);
+  new(&srcrects[0]) Rectf(srcrect.moved(Rectf(surface->get_region()).p1()));
+  new(&dstrects[0]) Rectf(apply_translate(dstrect.p1()), dstrect.get_size());
+  angles[0] = 0.0f;
   request->texture = surface->get_texture().get();
   request->displacement_texture = surface->get_displacement_texture().get();
   request->color = style.get_color();
@@ -176,30 +229,33 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
 
 void
 Canvas::draw_surface_batch(const SurfacePtr& surface,
-                           std::vector<Rectf> srcrects,
-                           std::vector<Rectf> dstrects,
+                           const std::vector<Rectf>& srcrects,
+                           const std::vector<Rectf>& dstrects,
                            const Color& color,
                            int layer)
 {
-  const size_t len = srcrects.size();
-  draw_surface_batch(surface,
-                     std::move(srcrects),
-                     std::move(dstrects),
-                     std::vector<float>(len, 0.0f),
-                     color, layer);
+  draw_surface_batch(surface, srcrects, dstrects, std::vector<float>(), color, layer);
 }
 
 void
 Canvas::draw_surface_batch(const SurfacePtr& surface,
-                           std::vector<Rectf> srcrects,
-                           std::vector<Rectf> dstrects,
-                           std::vector<float> angles,
+                           const std::vector<Rectf>& srcrects,
+                           const std::vector<Rectf>& dstrects,
+                           const std::vector<float>& angles,
                            const Color& color,
                            int layer)
 {
   if (!surface) return;
 
-  auto request = new(m_obst) TextureRequest();
+  assert(srcrects.size() == dstrects.size());
+  assert(angles.empty() || angles.size() == srcrects.size());
+
+  const size_t count = srcrects.size();
+
+  Rectf* request_srcrects;
+  Rectf* request_dstrects;
+  float* request_angles;
+  auto request = new_texture_request(count, request_srcrects, request_dstrects, request_angles);
 
   request->type = TEXTURE;
   request->layer = layer;
@@ -207,13 +263,11 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   request->alpha = m_context.transform().alpha;
   request->color = color;
 
-  request->srcrects = std::move(srcrects);
-  request->dstrects = std::move(dstrects);
-  request->angles = std::move(angles);
-
-  for (auto& dstrect : request->dstrects)
+  for (size_t i = 0; i < count; ++i)
   {
-    dstrect = Rectf(apply_translate(dstrect.p1()), dstrect.get_size());
+    new(&request_srcrects[i]) Rectf(srcrects[i]);
+    new(&request_dstrects[i]) Rectf(apply_translate(dstrects[i].p1()), dstrects[i].get_size());
+    request_angles[i] = angles.empty() ? 0.0f : angles[i];
   }
 
   request->texture = surface->get_texture().get();
@@ -222,6 +276,37 @@ Canvas::draw_surface_batch(const SurfacePtr& surface,
   m_requests.push_back(request);
 }
 
+void
+Canvas::draw_static_batch(const SurfacePtr& surface, const StaticBatch& batch,
+                          size_t first, size_t count, const Vector& offset,
+                          const Color& color, int layer)
+{
+  if (!surface || count == 0) return;
+
+  assert(first + count <= batch.size());
+
+  auto request = new(m_obst) TextureRequest();
+
+  request->type = TEXTURE;
+  request->layer = layer;
+  request->flip = m_context.transform().flip ^ surface->get_flip();
+  request->alpha = m_context.transform().alpha;
+  request->color = color;
+
+  request->count = count;
+  request->srcrects = batch.get_srcrects().data() + first;
+  request->dstrects = batch.get_dstrects().data() + first;
+  request->angles = nullptr;
+  request->offset = apply_translate(offset);
+  request->batch = &batch;
+  request->batch_first = first;
+
+  request->texture = surface->get_texture().get();
+  request->displacement_texture = surface->get_displacement_texture().get();
+
+  m_requests.push_back(request);
+}
+
 void
 Canvas::draw_text(const FontPtr& font, const std::string& text,
                   const Vector& pos, FontAlignment alignment, int layer, const Color& color)
@@ -366,11 +451,189 @@ Canvas::get_pixel(const Vector& position, const std::shared_ptr<Color>& color_ou
 
   request->layer = LAYER_GETPIXEL;
   request->pos = pos;
-  request->color_ptr = color_out;
+  request->color_ptr = color_out.get();
+  m_pixel_outputs.push_back(color_out);
 
   m_requests.push_back(request);
 }
 
+TextureRequest*
+Canvas::new_texture_request(size_t count, Rectf*& srcrects, Rectf*& dstrects, float*& angles)
+{
+  // a single allocation for the request and its quads, laid out as
+  // [TextureRequest][srcrects][dstrects][angles]
+  static_assert(sizeof(TextureRequest) % alignof(Rectf) == 0, "misaligned TextureRequest");
+  const size_t bytes = sizeof(TextureRequest) + count * (2 * sizeof(Rectf) + sizeof(float));
+  char* data = static_cast<char*>(obstack_alloc(&m_obst, static_cast<int>(bytes)));
+
+  auto request = new(data) TextureRequest();
+  srcrects = reinterpret_cast<Rectf*>(data + sizeof(TextureRequest));
+  dstrects = srcrects + count;
+  angles = reinterpret_cast<float*>(dstrects + count);
+
+  request->count = count;
+  request->srcrects = srcrects;
+  request->dstrects = dstrects;
+  request->angles = angles;
+
+  return request;
+}
+
+void
+Canvas::prepare_requests()
+{
+  // the color canvas is rendered in up to three passes per frame, all
+  // of them share one sort and merge, requests added in between get
+  // them again
+  if (m_requests.size() == m_prepared_size)
+    return;
+
+  sort_requests();
+  merge_requests();
+
+  const auto below_end =
+    std::lower_bound(m_requests.begin(), m_requests.end(), LAYER_LIGHTMAP,
+                     [](const DrawingRequest* request, int layer) {
+                       return request->layer < layer;
+                     });
+  const auto above_begin =
+    std::upper_bound(below_end, m_requests.end(), LAYER_LIGHTMAP,
+                     [](int layer, const DrawingRequest* request) {
+                       return layer < request->layer;
+                     });
+
+  m_prepared_size = m_requests.size();
+  m_below_lightmap_end = static_cast<size_t>(below_end - m_requests.begin());
+  m_above_lightmap_begin = static_cast<size_t>(above_begin - m_requests.begin());
+}
+
+void
+Canvas::sort_requests()
+{
+  // On a regular level, each frame has around 50-250 requests (before
+  // batching it was 1000-3000), spread over a few dozen layers, so a
+  // counting sort over the layer range does the job in two passes.
+  if (m_requests.size() < 2)
+    return;
+
+  int min_layer = m_requests.front()->layer;
+  int max_layer = min_layer;
+  bool sorted = true;
+  for (size_t i = 1; i < m_requests.size(); ++i)
+  {
+    const int layer = m_requests[i]->layer;
+    if (layer < m_requests[i - 1]->layer)
+      sorted = false;
+    min_layer = std::min(min_layer, layer);
+    max_layer = std::max(max_layer, layer);
+  }
+
+  if (sorted)
+    return;
+
+  const long range = static_cast<long>(max_layer) - static_cast<long>(min_layer) + 1;
+  if (range > MAX_LAYER_RANGE)
+  {
+    std::stable_sort(m_requests.begin(), m_requests.end(),
+                     [](const DrawingRequest* r1, const DrawingRequest* r2){
+                       return r1->layer < r2->layer;
+                     });
+    return;
+  }
+
+  m_layer_offsets.assign(static_cast<size_t>(range) + 1, 0);
+  for (const auto& request : m_requests)
+  {
+    m_layer_offsets[request->layer - min_layer + 1] += 1;
+  }
+
+  for (size_t i = 1; i < m_layer_offsets.size(); ++i)
+  {
+    m_layer_offsets[i] += m_layer_offsets[i - 1];
+  }
+
+  m_sorted_requests.resize(m_requests.size());
+  for (const auto& request : m_requests)
+  {
+    m_sorted_requests[m_layer_offsets[request->layer - min_layer]++] = request;
+  }
+
+  m_requests.swap(m_sorted_requests);
+}
+
+void
+Canvas::merge_requests()
+{
+  // Sprites, particles and coins each send their own request, on a
+  // typical level most of them end up next to others using the same
+  // texture after sorting. Each run gets replaced by a single request
+  // holding all of their quads in their original order.
+  size_t out = 0;
+  for (size_t begin = 0; begin < m_requests.size();)
+  {
+    size_t end = begin + 1;
+    while (end < m_requests.size() && can_merge(*m_requests[begin], *m_requests[end]))
+    {
+      ++end;
+    }
+
+    if (end - begin == 1)
+    {
+      m_requests[out++] = m_requests[begin];
+    }
+    else
+    {
+      size_t count = 0;
+      for (size_t i = begin; i < end; ++i)
+      {
+        count += static_cast<const TextureRequest*>(m_requests[i])->count;
+      }
+
+      const auto& first = static_cast<const TextureRequest&>(*m_requests[begin]);
+
+      Rectf* srcrects;
+      Rectf* dstrects;
+      float* angles;
+      auto request = new_texture_request(count, srcrects, dstrects, angles);
+
+      request->type = TEXTURE;
+      request->layer = first.layer;
+      request->flip = first.flip;
+      request->alpha = first.alpha;
+      request->blend = first.blend;
+      request->texture = first.texture;
+      request->displacement_texture = first.displacement_texture;
+      request->color = first.color;
+
+      for (size_t i = begin; i < end; ++i)
+      {
+        const auto& part = static_cast<const TextureRequest&>(*m_requests[i]);
+        // the quads of batch requests live in the GPU, can_merge()
+        // keeps them out of here
+        assert(part.batch == nullptr);
+        std::uninitialized_copy(part.srcrects, part.srcrects + part.count, srcrects);
+        std::uninitialized_copy(part.dstrects, part.dstrects + part.count, dstrects);
+        if (part.angles)
+        {
+          std::copy(part.angles, part.angles + part.count, angles);
+        }
+        else
+        {
+          std::fill(angles, angles + part.count, 0.0f);
+        }
+        srcrects += part.count;
+        dstrects += part.count;
+        angles += part.count;
+      }
+
+      m_requests[out++] = request;
+    }
+
+    begin = end;
+  }
+  m_requests.resize(out);
+}
+
 Vector
 Canvas::apply_translate(const Vector& pos) const
 {
@@ -37,8 +37,10 @@
 
 class DrawingContext;
 class Renderer;
+class StaticBatch;
 class VideoSystem;
 struct DrawingRequest;
+struct TextureRequest;
 
 class Canvas final
 {
@@ -57,16 +59,24 @@ public:
   void draw_surface_scaled(const SurfacePtr& surface, const Rectf& dstrect,
                            int layer, const PaintStyle& style = PaintStyle());
   void draw_surface_batch(const SurfacePtr& surface,
-                          std::vector<Rectf> srcrects,
-                          std::vector<Rectf> dstrects,
+                          const std::vector<Rectf>& srcrects,
+                          const std::vector<Rectf>& dstrects,
                           const Color& color,
                           int layer);
   void draw_surface_batch(const SurfacePtr& surface,
-                          std::vector<Rectf> srcrects,
-                          std::vector<Rectf> dstrects,
-                          std::vector<float> angles,
+                          const std::vector<Rectf>& srcrects,
+                          const std::vector<Rectf>& dstrects,
+                          const std::vector<float>& angles,
                           const Color& color,
                           int layer);
+
+  /** Draws quads [first, first + count) of batch, their dstrects are
+      relative to offset. The batch has to stay alive and unchanged
+      until the frame is rendered. */
+  void draw_static_batch(const SurfacePtr& surface, const StaticBatch& batch,
+                         size_t first, size_t count, const Vector& offset,
+                         const Color& color, int layer);
+
   void draw_text(const FontPtr& font, const std::string& text,
                  const Vector& position, FontAlignment alignment, int layer, const Color& color = Color(1.0,1.0,1.0));
   /** Draw text to the center of the screen */
@@ -86,18 +96,52 @@ public:
   void get_pixel(const Vector& position, const std::shared_ptr<Color>& color_out);
 
   void clear();
-  void render(Renderer& renderer, Filter filter);
+
+  /** Sends the requests matching filter to the painter of renderer,
+      returns the number of painter calls it took */
+  int render(Renderer& renderer, Filter filter);
 
   DrawingContext& get_context() { return m_context; }
 
 private:
   Vector apply_translate(const Vector& pos) const;
 
+  /** Allocates a TextureRequest with room for count quads in the
+      same obstack block */
+  TextureRequest* new_texture_request(size_t count, Rectf*& srcrects, Rectf*& dstrects, float*& angles);
+
+  /** Sorts and merges the requests once per frame and finds where
+      the lightmap splits them */
+  void prepare_requests();
+
+  /** Stable sort of m_requests by layer */
+  void sort_requests();
+
+  /** Combines adjacent texture requests that only differ in their
+      quads, needs sorted requests */
+  void merge_requests();
+
 private:
   DrawingContext& m_context;
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
 
+  /** Keeps the targets of the GetPixelRequests alive until clear() */
+  std::vector<std::shared_ptr<Color> > m_pixel_outputs;
+
+  /** Scratch buffers of sort_requests(), kept to avoid allocations */
+  std::vector<DrawingRequest*> m_sorted_requests;
+  std::vector<size_t> m_layer_offsets;
+
+  /** Size of m_requests after prepare_requests(), it is done again
+      once more requests come in */
+  size_t m_prepared_size;
+
+  /** The requests [0, m_below_lightmap_end) are below the lightmap,
+      [m_above_lightmap_begin, size) above it */
+  size_t m_below_lightmap_end;
+  size_t m_above_lightmap_begin;
+
 private:
   Canvas(const Canvas&) = delete;
   Canvas& operator=(const Canvas&) = delete;
@@ -28,7 +28,8 @@ bool Compositor::s_render_lighting = true;
 Compositor::Compositor(VideoSystem& video_system) :
   m_video_system(video_system),
   m_obst(),
-  m_drawing_contexts()
+  m_drawing_contexts(),
+  m_draw_calls(0)
 {
   obstack_init(&m_obst);
 }
@@ -58,6 +59,8 @@ Compositor::render()
 
   use_lightmap = use_lightmap && s_render_lighting;
 
+  int draw_calls = 0;
+
   // prepare lightmap
   if (use_lightmap)
   {
@@ -71,7 +74,7 @@ Compositor::render()
         painter.set_clip_rect(ctx->get_viewport());
         painter.clear(ctx->get_ambient_color());
 
-        ctx->light().render(lightmap, Canvas::ALL);
+        draw_calls += ctx->light().render(lightmap, Canvas::ALL);
 
         painter.clear_clip_rect();
       }
@@ -89,7 +92,7 @@ Compositor::render()
     for (auto& ctx : m_drawing_contexts)
     {
       painter.set_clip_rect(ctx->get_viewport());
-      ctx->color().render(*back_renderer, Canvas::BELOW_LIGHTMAP);
+      draw_calls += ctx->color().render(*back_renderer, Canvas::BELOW_LIGHTMAP);
       painter.clear_clip_rect();
     }
 
@@ -106,7 +109,7 @@ Compositor::render()
     for (auto& ctx : m_drawing_contexts)
     {
       painter.set_clip_rect(ctx->get_viewport());
-      ctx->color().render(renderer, Canvas::BELOW_LIGHTMAP);
+      draw_calls += ctx->color().render(renderer, Canvas::BELOW_LIGHTMAP);
       painter.clear_clip_rect();
     }
 
@@ -122,16 +125,22 @@ Compositor::render()
         request.alpha = 1.0f;
         request.blend = Blend::MOD;
 
-        request.srcrects.emplace_back(0, 0,
-                                      static_cast<float>(texture->get_image_width()),
-                                      static_cast<float>(texture->get_image_height()));
-        request.dstrects.emplace_back(Vector(0, 0), lightmap.get_logical_size());
-        request.angles.emplace_back(0.0f);
+        const Rectf srcrect(0, 0,
+                            static_cast<float>(texture->get_image_width()),
+                            static_cast<float>(texture->get_image_height()));
+        const Rectf dstrect(Vector(0, 0), lightmap.get_logical_size());
+        const float angle = 0.0f;
+
+        request.count = 1;
+        request.srcrects = &srcrect;
+        request.dstrects = &dstrect;
+        request.angles = &angle;
 
         request.texture = texture.get();
         request.color = Color::WHITE;
 
         painter.draw_texture(request);
+        draw_calls += 1;
       }
     }
 
@@ -139,13 +148,15 @@ Compositor::render()
     for (auto& ctx : m_drawing_contexts)
     {
       painter.set_clip_rect(ctx->get_viewport());
-      ctx->color().render(renderer, Canvas::ABOVE_LIGHTMAP);
+      draw_calls += ctx->color().render(renderer, Canvas::ABOVE_LIGHTMAP);
       painter.clear_clip_rect();
     }
 
     renderer.end_draw();
   }
 
+  m_draw_calls = draw_calls;
+
   // cleanup
   for (auto& ctx : m_drawing_contexts)
   {
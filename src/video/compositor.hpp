@@ -44,6 +44,9 @@ public:
       otherwise their lighting would get messed up. */
   DrawingContext& make_context(bool overlay = false);
 
+  /** Number of painter calls of the last render() */
+  int get_draw_calls() const { return m_draw_calls; }
+
 private:
   VideoSystem& m_video_system;
 
@@ -52,6 +55,8 @@ private:
 
   std::vector<std::unique_ptr<DrawingContext> > m_drawing_contexts;
 
+  int m_draw_calls;
+
 private:
   Compositor(const Compositor&) = delete;
   Compositor& operator=(const Compositor&) = delete;
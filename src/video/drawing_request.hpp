@@ -17,8 +17,8 @@
 #ifndef HEADER_SUPERTUX_VIDEO_DRAWING_REQUEST_HPP
 #define HEADER_SUPERTUX_VIDEO_DRAWING_REQUEST_HPP
 
+#include <stddef.h>
 #include <string>
-#include <memory>
 
 #include "math/rectf.hpp"
 #include "math/sizef.hpp"
@@ -27,6 +27,7 @@
 #include "video/drawing_context.hpp"
 #include "video/font.hpp"
 
+class StaticBatch;
 class Surface;
 
 enum RequestType
@@ -34,6 +35,10 @@ enum RequestType
   TEXTURE, GRADIENT, FILLRECT, INVERSEELLIPSE, GETPIXEL, LINE, TRIANGLE
 };
 
+/** Requests are placed into the obstack of the Compositor and never
+    destroyed individually, so they must stay trivially destructible,
+    anything they point to has to live at least until the end of the
+    frame. */
 struct DrawingRequest
 {
   RequestType type;
@@ -51,7 +56,6 @@ struct DrawingRequest
     alpha(),
     blend()
   {}
-  virtual ~DrawingRequest() {}
 };
 
 struct TextureRequest : public DrawingRequest
@@ -60,17 +64,37 @@ struct TextureRequest : public DrawingRequest
     DrawingRequest(TEXTURE),
     texture(),
     displacement_texture(),
+    count(),
     srcrects(),
     dstrects(),
     angles(),
+    offset(),
+    batch(),
+    batch_first(),
     color(1.0f, 1.0f, 1.0f)
   {}
 
   const Texture* texture;
   const Texture* displacement_texture;
-  std::vector<Rectf> srcrects;
-  std::vector<Rectf> dstrects;
-  std::vector<float> angles;
+
+  /** Number of quads, each of srcrects, dstrects and angles holds
+      count elements. Canvas stores them in the same obstack block
+      directly behind the request. */
+  size_t count;
+  const Rectf* srcrects;
+  const Rectf* dstrects;
+
+  /** nullptr if none of the quads are rotated */
+  const float* angles;
+
+  /** Added to all of the dstrects */
+  Vector offset;
+
+  /** Set when the quads are a range of a StaticBatch, srcrects[0]
+      and dstrects[0] are then element batch_first of it */
+  const StaticBatch* batch;
+  size_t batch_first;
+
   Color color;
 
 private:
@@ -162,7 +186,9 @@ struct GetPixelRequest : public DrawingRequest
     color_ptr() {}
 
   Vector pos;
-  std::shared_ptr<Color> color_ptr;
+
+  /** Owned by the Canvas until it gets cleared */
+  Color* color_ptr;
 
 private:
   GetPixelRequest(const GetPixelRequest&) = delete;
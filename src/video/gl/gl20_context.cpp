@@ -20,6 +20,7 @@
 #include "video/glutil.hpp"
 #include "video/color.hpp"
 #include "video/gl/gl_texture.hpp"
+#include "video/gl/gl_vertex_buffer.hpp"
 
 #ifndef USE_OPENGLES2
 
@@ -71,6 +72,18 @@ GL20Context::ortho(float width, float height, bool vflip)
   assert_gl();
 }
 
+void
+GL20Context::set_translation(const Vector& translation)
+{
+  assert_gl();
+
+  glMatrixMode(GL_MODELVIEW);
+  glLoadIdentity();
+  glTranslatef(translation.x, translation.y, 0.0f);
+
+  assert_gl();
+}
+
 void
 GL20Context::blend_func(GLenum src, GLenum dst)
 {
@@ -113,6 +126,27 @@ GL20Context::set_texcoord(float u, float v)
   assert_gl();
 }
 
+void
+GL20Context::bind_vertex_buffer(const GLVertexBuffer& buffer)
+{
+  assert_gl();
+
+  // the pointers refer to the buffer bound at the time of the call,
+  // unbinding afterwards keeps the client arrays of set_positions()
+  // and set_texcoords() working
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glBindBuffer(GL_ARRAY_BUFFER, buffer.get_positions_buffer());
+  glVertexPointer(2, GL_FLOAT, 0, nullptr);
+
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glBindBuffer(GL_ARRAY_BUFFER, buffer.get_texcoords_buffer());
+  glTexCoordPointer(2, GL_FLOAT, 0, nullptr);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  assert_gl();
+}
+
 void
 GL20Context::set_colors(const float* data, size_t size)
 {
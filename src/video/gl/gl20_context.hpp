@@ -32,6 +32,7 @@ public:
   virtual void bind() override;
 
   virtual void ortho(float width, float height, bool vflip) override;
+  virtual void set_translation(const Vector& translation) override;
 
   virtual void blend_func(GLenum src, GLenum dst) override;
 
@@ -40,6 +41,8 @@ public:
   virtual void set_texcoords(const float* data, size_t size) override;
   virtual void set_texcoord(float u, float v) override;
 
+  virtual void bind_vertex_buffer(const GLVertexBuffer& buffer) override;
+
   virtual void set_colors(const float* data, size_t size) override;
   virtual void set_color(const Color& color) override;
 
@@ -22,6 +22,7 @@
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_texture_renderer.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
+#include "video/gl/gl_vertex_buffer.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
@@ -32,7 +33,8 @@ GL33CoreContext::GL33CoreContext(GLVideoSystem& video_system) :
   m_white_texture(),
   m_black_texture(),
   m_grey_texture(),
-  m_transparent_texture()
+  m_transparent_texture(),
+  m_ortho()
 {
   assert_gl();
 
@@ -122,6 +124,26 @@ GL33CoreContext::ortho(float width, float height, bool vflip)
   const float tx = -1.0f;
   const float ty = 1.0f * (vflip ? 1.0f : -1.0f);
 
+  m_ortho[0] = sx;
+  m_ortho[1] = sy;
+  m_ortho[2] = tx;
+  m_ortho[3] = ty;
+
+  set_translation(Vector(0.0f, 0.0f));
+
+  assert_gl();
+}
+
+void
+GL33CoreContext::set_translation(const Vector& translation)
+{
+  assert_gl();
+
+  const float sx = m_ortho[0];
+  const float sy = m_ortho[1];
+  const float tx = m_ortho[2] + sx * translation.x;
+  const float ty = m_ortho[3] + sy * translation.y;
+
   const float mvp_matrix[] = {
     sx, 0, tx,
     0, sy, ty,
@@ -162,6 +184,12 @@ GL33CoreContext::set_texcoord(float u, float v)
   m_vertex_arrays->set_texcoord(u, v);
 }
 
+void
+GL33CoreContext::bind_vertex_buffer(const GLVertexBuffer& buffer)
+{
+  m_vertex_arrays->bind_vertex_buffer(buffer);
+}
+
 void
 GL33CoreContext::set_colors(const float* data, size_t size)
 {
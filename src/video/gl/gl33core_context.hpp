@@ -37,6 +37,7 @@ public:
   virtual void bind() override;
 
   virtual void ortho(float width, float height, bool vflip) override;
+  virtual void set_translation(const Vector& translation) override;
 
   virtual void blend_func(GLenum src, GLenum dst) override;
 
@@ -45,6 +46,8 @@ public:
   virtual void set_texcoords(const float* data, size_t size) override;
   virtual void set_texcoord(float u, float v) override;
 
+  virtual void bind_vertex_buffer(const GLVertexBuffer& buffer) override;
+
   virtual void set_colors(const float* data, size_t size) override;
   virtual void set_color(const Color& color) override;
 
@@ -67,6 +70,9 @@ private:
   std::unique_ptr<GLTexture> m_grey_texture;
   std::unique_ptr<GLTexture> m_transparent_texture;
 
+  /** Scale and translation of the last ortho() call */
+  float m_ortho[4];
+
 private:
   GL33CoreContext(const GL33CoreContext&) = delete;
   GL33CoreContext& operator=(const GL33CoreContext&) = delete;
@@ -24,7 +24,9 @@
 
 class Color;
 class GLTexture;
+class GLVertexBuffer;
 class Texture;
+class Vector;
 
 class GLContext
 {
@@ -38,6 +40,10 @@ public:
 
   virtual void ortho(float width, float height, bool vflip) = 0;
 
+  /** Moves everything drawn afterwards by translation, reset by
+      ortho() */
+  virtual void set_translation(const Vector& translation) = 0;
+
   virtual void blend_func(GLenum src, GLenum dst) = 0;
 
   virtual void set_positions(const float* data, size_t size) = 0;
@@ -45,6 +51,10 @@ public:
   virtual void set_texcoords(const float* data, size_t size) = 0;
   virtual void set_texcoord(float u, float v) = 0;
 
+  /** Use positions and texcoords of buffer instead of those given
+      to set_positions() and set_texcoords() */
+  virtual void bind_vertex_buffer(const GLVertexBuffer& buffer) = 0;
+
   virtual void set_colors(const float* data, size_t size) = 0;
   virtual void set_color(const Color& color) = 0;
 
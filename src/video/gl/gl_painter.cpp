@@ -28,8 +28,10 @@
 #include "video/gl/gl_renderer.hpp"
 #include "video/gl/gl_texture.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
+#include "video/gl/gl_vertex_buffer.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
+#include "video/static_batch.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -57,6 +59,108 @@ inline GLenum dfactor(Blend blend)
   return std::get<1>(blend_factor(blend));
 }
 
+/** Appends the two triangles of a quad to vertices and uvs */
+void add_quad(std::vector<float>& vertices, std::vector<float>& uvs,
+              const GLTexture& texture, const Rectf& srcrect, const Rectf& dstrect,
+              float angle, Flip flip)
+{
+  const float left = dstrect.get_left();
+  const float top = dstrect.get_top();
+  const float right  = dstrect.get_right();
+  const float bottom = dstrect.get_bottom();
+
+  float uv_left = srcrect.get_left() / static_cast<float>(texture.get_texture_width());
+  float uv_top = srcrect.get_top() / static_cast<float>(texture.get_texture_height());
+  float uv_right = srcrect.get_right() / static_cast<float>(texture.get_texture_width());
+  float uv_bottom = srcrect.get_bottom() / static_cast<float>(texture.get_texture_height());
+
+  if (flip & HORIZONTAL_FLIP)
+    std::swap(uv_left, uv_right);
+
+  if (flip & VERTICAL_FLIP)
+    std::swap(uv_top, uv_bottom);
+
+  if (angle == 0.0f)
+  {
+    auto vertices_lst = {
+      left, top,
+      right, top,
+      right, bottom,
+
+      left, bottom,
+      left, top,
+      right, bottom,
+    };
+    vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
+
+    auto uvs_lst = {
+      uv_left, uv_top,
+      uv_right, uv_top,
+      uv_right, uv_bottom,
+
+      uv_left, uv_bottom,
+      uv_left, uv_top,
+      uv_right, uv_bottom,
+    };
+    uvs.insert(uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
+  }
+  else
+  {
+    // rotated blit
+    const float center_x = (left + right) / 2;
+    const float center_y = (top + bottom) / 2;
+
+    const float sa = sinf(math::radians(angle));
+    const float ca = cosf(math::radians(angle));
+
+    const float new_left = left - center_x;
+    const float new_right = right - center_x;
+
+    const float new_top = top - center_y;
+    const float new_bottom = bottom - center_y;
+
+    const float vertices_lst[] = {
+      new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
+      new_right*ca - new_top*sa + center_x, new_right*sa + new_top*ca + center_y,
+      new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
+
+      new_left*ca - new_bottom*sa + center_x, new_left*sa + new_bottom*ca + center_y,
+      new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
+      new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
+    };
+    vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
+
+    const float uvs_lst[] = {
+      uv_left, uv_top,
+      uv_right, uv_top,
+      uv_right, uv_bottom,
+
+      uv_left, uv_bottom,
+      uv_left, uv_top,
+      uv_right, uv_bottom,
+    };
+    uvs.insert(uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
+  }
+}
+
+/** Vertex buffer holding all quads of a StaticBatch */
+struct GLStaticBatchCache final : public StaticBatchCache
+{
+  GLStaticBatchCache() :
+    buffer(),
+    revision(),
+    flip(),
+    texture()
+  {}
+
+  GLVertexBuffer buffer;
+
+  /** What the buffer was built from */
+  uint32_t revision;
+  Flip flip;
+  const Texture* texture;
+};
+
 } // namespace
 
 GLPainter::GLPainter(GLVideoSystem& video_system, GLRenderer& renderer) :
@@ -72,108 +176,85 @@ GLPainter::draw_texture(const TextureRequest& request)
 
   const auto& texture = static_cast<const GLTexture&>(*request.texture);
 
-  assert(request.srcrects.size() == request.dstrects.size());
-  assert(request.srcrects.size() == request.angles.size());
-
-  std::vector<float> vertices;
-  std::vector<float> uvs;
-  for (size_t i = 0; i < request.srcrects.size(); ++i)
-  {
-    const float left = request.dstrects[i].get_left();
-    const float top = request.dstrects[i].get_top();
-    const float right  = request.dstrects[i].get_right();
-    const float bottom = request.dstrects[i].get_bottom();
-
-    float uv_left = request.srcrects[i].get_left() / static_cast<float>(texture.get_texture_width());
-    float uv_top = request.srcrects[i].get_top() / static_cast<float>(texture.get_texture_height());
-    float uv_right = request.srcrects[i].get_right() / static_cast<float>(texture.get_texture_width());
-    float uv_bottom = request.srcrects[i].get_bottom() / static_cast<float>(texture.get_texture_height());
-
-    if (request.flip & HORIZONTAL_FLIP)
-      std::swap(uv_left, uv_right);
-
-    if (request.flip & VERTICAL_FLIP)
-      std::swap(uv_top, uv_bottom);
-
-    if (request.angles[i] == 0.0f)
-    {
-      auto vertices_lst = {
-        left, top,
-        right, top,
-        right, bottom,
-
-        left, bottom,
-        left, top,
-        right, bottom,
-      };
-      vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
-
-      auto uvs_lst = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
-
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
-      };
-      uvs.insert(uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
-    }
-    else
-    {
-      // rotated blit
-      const float center_x = (left + right) / 2;
-      const float center_y = (top + bottom) / 2;
-
-      const float sa = sinf(math::radians(request.angles[i]));
-      const float ca = cosf(math::radians(request.angles[i]));
-
-      const float new_left = left - center_x;
-      const float new_right = right - center_x;
-
-      const float new_top = top - center_y;
-      const float new_bottom = bottom - center_y;
-
-      const float vertices_lst[] = {
-        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
-        new_right*ca - new_top*sa + center_x, new_right*sa + new_top*ca + center_y,
-        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
-
-        new_left*ca - new_bottom*sa + center_x, new_left*sa + new_bottom*ca + center_y,
-        new_left*ca - new_top*sa + center_x, new_left*sa + new_top*ca + center_y,
-        new_right*ca - new_bottom*sa + center_x, new_right*sa + new_bottom*ca + center_y,
-      };
-      vertices.insert(vertices.end(), std::begin(vertices_lst), std::end(vertices_lst));
-
-      const float uvs_lst[] = {
-        uv_left, uv_top,
-        uv_right, uv_top,
-        uv_right, uv_bottom,
-
-        uv_left, uv_bottom,
-        uv_left, uv_top,
-        uv_right, uv_bottom,
-      };
-      uvs.insert(uvs.end(), std::begin(uvs_lst), std::end(uvs_lst));
-    }
-  }
-
   GLContext& context = m_video_system.get_context();
 
   context.blend_func(sfactor(request.blend), dfactor(request.blend));
   context.bind_texture(texture, request.displacement_texture);
-  context.set_texcoords(uvs.data(), sizeof(float) * uvs.size());
-  context.set_positions(vertices.data(), sizeof(float) * vertices.size());
   context.set_color(Color(request.color.red,
                           request.color.green,
                           request.color.blue,
                           request.color.alpha * request.alpha));
 
-  context.draw_arrays(GL_TRIANGLES, 0, static_cast<GLsizei>(request.srcrects.size() * 2 * 3));
+  if (request.batch)
+  {
+    const GLVertexBuffer& buffer = get_vertex_buffer(*request.batch, texture, request.flip);
+
+    // only the translation changes from frame to frame
+    context.bind_vertex_buffer(buffer);
+    context.set_translation(request.offset);
+    context.draw_arrays(GL_TRIANGLES,
+                        static_cast<GLint>(request.batch_first * 2 * 3),
+                        static_cast<GLsizei>(request.count * 2 * 3));
+    context.set_translation(Vector(0.0f, 0.0f));
+  }
+  else
+  {
+    std::vector<float> vertices;
+    std::vector<float> uvs;
+    for (size_t i = 0; i < request.count; ++i)
+    {
+      add_quad(vertices, uvs, texture,
+               request.srcrects[i], request.dstrects[i].moved(request.offset),
+               request.angles ? request.angles[i] : 0.0f, request.flip);
+    }
+
+    context.set_texcoords(uvs.data(), sizeof(float) * uvs.size());
+    context.set_positions(vertices.data(), sizeof(float) * vertices.size());
+    context.draw_arrays(GL_TRIANGLES, 0, static_cast<GLsizei>(request.count * 2 * 3));
+  }
 
   assert_gl();
 }
 
+const GLVertexBuffer&
+GLPainter::get_vertex_buffer(const StaticBatch& batch, const GLTexture& texture, Flip flip)
+{
+  auto cache = static_cast<GLStaticBatchCache*>(batch.get_cache());
+  if (cache &&
+      cache->revision == batch.get_revision() &&
+      cache->flip == flip &&
+      cache->texture == &texture)
+  {
+    return cache->buffer;
+  }
+
+  if (!cache)
+  {
+    std::unique_ptr<GLStaticBatchCache> new_cache(new GLStaticBatchCache);
+    cache = new_cache.get();
+    batch.set_cache(std::move(new_cache));
+  }
+
+  const auto& srcrects = batch.get_srcrects();
+  const auto& dstrects = batch.get_dstrects();
+
+  std::vector<float> vertices;
+  std::vector<float> uvs;
+  vertices.reserve(batch.size() * 12);
+  uvs.reserve(batch.size() * 12);
+  for (size_t i = 0; i < batch.size(); ++i)
+  {
+    add_quad(vertices, uvs, texture, srcrects[i], dstrects[i], 0.0f, flip);
+  }
+
+  cache->buffer.set_data(vertices.data(), uvs.data(), batch.size() * 2 * 3);
+  cache->revision = batch.get_revision();
+  cache->flip = flip;
+  cache->texture = &texture;
+
+  return cache->buffer;
+}
+
 void
 GLPainter::draw_gradient(const GradientRequest& request)
 {
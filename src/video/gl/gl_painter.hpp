@@ -23,7 +23,10 @@
 
 enum class Blend;
 class GLRenderer;
+class GLTexture;
+class GLVertexBuffer;
 class GLVideoSystem;
+class StaticBatch;
 
 class GLPainter final : public Painter
 {
@@ -43,6 +46,11 @@ public:
   virtual void set_clip_rect(const Rect& rect) override;
   virtual void clear_clip_rect() override;
 
+private:
+  /** Returns the vertex buffer of batch, rebuilt if the batch changed
+      since it was uploaded */
+  const GLVertexBuffer& get_vertex_buffer(const StaticBatch& batch, const GLTexture& texture, Flip flip);
+
 private:
   GLVideoSystem& m_video_system;
   GLRenderer& m_renderer;
@@ -19,6 +19,7 @@
 #include "video/color.hpp"
 #include "video/gl/gl33core_context.hpp"
 #include "video/gl/gl_program.hpp"
+#include "video/gl/gl_vertex_buffer.hpp"
 #include "video/gl/gl_video_system.hpp"
 #include "video/glutil.hpp"
 
@@ -99,6 +100,24 @@ GLVertexArrays::set_texcoord(float u, float v)
   assert_gl();
 }
 
+void
+GLVertexArrays::bind_vertex_buffer(const GLVertexBuffer& buffer)
+{
+  assert_gl();
+
+  int loc = m_context.get_program().get_attrib_location("position");
+  glBindBuffer(GL_ARRAY_BUFFER, buffer.get_positions_buffer());
+  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+  glEnableVertexAttribArray(loc);
+
+  loc = m_context.get_program().get_attrib_location("texcoord");
+  glBindBuffer(GL_ARRAY_BUFFER, buffer.get_texcoords_buffer());
+  glVertexAttribPointer(loc, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+  glEnableVertexAttribArray(loc);
+
+  assert_gl();
+}
+
 void
 GLVertexArrays::set_colors(const float* data, size_t size)
 {
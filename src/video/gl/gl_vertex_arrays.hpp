@@ -23,6 +23,7 @@
 
 class Color;
 class GL33CoreContext;
+class GLVertexBuffer;
 
 class GLVertexArrays final
 {
@@ -38,6 +39,10 @@ public:
   void set_texcoords(const float* data, size_t size);
   void set_texcoord(float u, float v);
 
+  /** Points positions and texcoords to the buffers of buffer, until
+      the next set_positions() and set_texcoords() */
+  void bind_vertex_buffer(const GLVertexBuffer& buffer);
+
   void set_colors(const float* data, size_t size);
   void set_color(const Color& color);
 
@@ -0,0 +1,60 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/gl/gl_vertex_buffer.hpp"
+
+#include "video/glutil.hpp"
+
+GLVertexBuffer::GLVertexBuffer() :
+  m_positions_buffer(),
+  m_texcoords_buffer(),
+  m_vertex_count(0)
+{
+  assert_gl();
+
+  glGenBuffers(1, &m_positions_buffer);
+  glGenBuffers(1, &m_texcoords_buffer);
+
+  assert_gl();
+}
+
+GLVertexBuffer::~GLVertexBuffer()
+{
+  glDeleteBuffers(1, &m_positions_buffer);
+  glDeleteBuffers(1, &m_texcoords_buffer);
+}
+
+void
+GLVertexBuffer::set_data(const float* positions, const float* texcoords, size_t vertex_count)
+{
+  assert_gl();
+
+  const GLsizeiptr size = static_cast<GLsizeiptr>(sizeof(float) * 2 * vertex_count);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_positions_buffer);
+  glBufferData(GL_ARRAY_BUFFER, size, positions, GL_STATIC_DRAW);
+
+  glBindBuffer(GL_ARRAY_BUFFER, m_texcoords_buffer);
+  glBufferData(GL_ARRAY_BUFFER, size, texcoords, GL_STATIC_DRAW);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  m_vertex_count = vertex_count;
+
+  assert_gl();
+}
+
+/* EOF */
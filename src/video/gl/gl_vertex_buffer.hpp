@@ -0,0 +1,51 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_GL_GL_VERTEX_BUFFER_HPP
+#define HEADER_SUPERTUX_VIDEO_GL_GL_VERTEX_BUFFER_HPP
+
+#include <stddef.h>
+
+#include "video/gl.hpp"
+
+/** Positions and texcoords that stay on the GPU across frames,
+    uploaded once with GL_STATIC_DRAW */
+class GLVertexBuffer final
+{
+public:
+  GLVertexBuffer();
+  ~GLVertexBuffer();
+
+  /** positions and texcoords hold two floats per vertex */
+  void set_data(const float* positions, const float* texcoords, size_t vertex_count);
+
+  GLuint get_positions_buffer() const { return m_positions_buffer; }
+  GLuint get_texcoords_buffer() const { return m_texcoords_buffer; }
+  size_t get_vertex_count() const { return m_vertex_count; }
+
+private:
+  GLuint m_positions_buffer;
+  GLuint m_texcoords_buffer;
+  size_t m_vertex_count;
+
+private:
+  GLVertexBuffer(const GLVertexBuffer&) = delete;
+  GLVertexBuffer& operator=(const GLVertexBuffer&) = delete;
+};
+
+#endif
+
+/* EOF */
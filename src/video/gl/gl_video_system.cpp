@@ -73,7 +73,8 @@ GLVideoSystem::GLVideoSystem(bool use_opengl33core) :
 
   assert_gl();
 
-  m_texture_manager.reset(new TextureManager);
+  m_texture_manager.reset(new TextureManager(g_config->use_texture_atlas,
+                                             static_cast<size_t>(g_config->texture_memory_budget) * 1024 * 1024));
 
   assert_gl();
 
@@ -283,7 +284,9 @@ GLVideoSystem::get_back_renderer() const
 TexturePtr
 GLVideoSystem::new_texture(const SDL_Surface& image, const Sampler& sampler)
 {
-  return TexturePtr(new GLTexture(image, sampler));
+  TexturePtr texture(new GLTexture(image, sampler));
+  m_texture_manager->register_texture(*texture);
+  return texture;
 }
 
 void
@@ -0,0 +1,258 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/image_decoder.hpp"
+
+#include <algorithm>
+#include <SDL_image.h>
+
+#include "physfs/physfs_sdl.hpp"
+
+ImageDecoder::ImageDecoder(unsigned int num_threads) :
+  m_threads(),
+  m_mutex(),
+  m_request_cond(),
+  m_done_cond(),
+  m_queue(),
+  m_batches(),
+  m_jobs(),
+  m_quit(false)
+{
+  if (num_threads == 0)
+  {
+    num_threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    num_threads = std::max(1u, num_threads);
+  }
+
+  // SDL_image initializes its loaders lazily, which isn't safe once
+  // several threads decode at the same time
+  IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
+
+  for (unsigned int i = 0; i < num_threads; ++i)
+  {
+    m_threads.emplace_back(&ImageDecoder::run, this);
+  }
+}
+
+ImageDecoder::~ImageDecoder()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_request_cond.notify_all();
+
+  for (auto& thread : m_threads)
+  {
+    thread.join();
+  }
+
+  IMG_Quit();
+}
+
+void
+ImageDecoder::request(const std::string& filename)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto result = m_jobs.emplace(filename, Job());
+    if (!result.second)
+    {
+      // wanted again after all
+      result.first->second.discarded = false;
+      return;
+    }
+    m_queue.push_back(filename);
+  }
+  m_request_cond.notify_one();
+}
+
+bool
+ImageDecoder::take(const std::string& filename, SDLSurfacePtr& surface)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  auto it = m_jobs.find(filename);
+  if (it == m_jobs.end())
+  {
+    return false;
+  }
+  it->second.discarded = false;
+
+  auto queued = std::find(m_queue.begin(), m_queue.end(), filename);
+  if (queued != m_queue.end())
+  {
+    // waiting for the workers to get to it would take longer
+    m_queue.erase(queued);
+    Job result;
+    lock.unlock();
+    decode(filename, result);
+    lock.lock();
+    it->second = std::move(result);
+  }
+  else
+  {
+    m_done_cond.wait(lock, [it]{ return it->second.done; });
+  }
+
+  Job job = std::move(it->second);
+  m_jobs.erase(it);
+  lock.unlock();
+
+  if (!job.surface)
+  {
+    throw std::runtime_error(job.error);
+  }
+
+  surface = std::move(job.surface);
+  return true;
+}
+
+void
+ImageDecoder::discard()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  for (const auto& filename : m_queue)
+  {
+    m_jobs.erase(filename);
+  }
+  m_queue.clear();
+
+  for (auto it = m_jobs.begin(); it != m_jobs.end();)
+  {
+    if (it->second.done)
+    {
+      it = m_jobs.erase(it);
+    }
+    else
+    {
+      // a worker holds on to it
+      it->second.discarded = true;
+      ++it;
+    }
+  }
+}
+
+void
+ImageDecoder::parallel_for(size_t count, const std::function<void (size_t)>& func)
+{
+  Batch batch(count, func);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_batches.push_back(&batch);
+  }
+  m_request_cond.notify_all();
+
+  work(batch);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto it = std::find(m_batches.begin(), m_batches.end(), &batch);
+  if (it != m_batches.end())
+  {
+    m_batches.erase(it);
+  }
+  m_done_cond.wait(lock, [&batch]{ return batch.active == 0; });
+}
+
+void
+ImageDecoder::work(Batch& batch)
+{
+  for (size_t i = batch.next++; i < batch.count; i = batch.next++)
+  {
+    batch.func(i);
+  }
+}
+
+void
+ImageDecoder::decode(const std::string& filename, Job& job)
+{
+  try
+  {
+    job.surface = SDLSurfacePtr(IMG_Load_RW(get_physfs_SDLRWops(filename), 1));
+    if (!job.surface)
+    {
+      job.error = "Couldn't load image '" + filename + "' :" + SDL_GetError();
+    }
+  }
+  catch (const std::exception& err)
+  {
+    job.error = err.what();
+  }
+  job.done = true;
+}
+
+void
+ImageDecoder::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_request_cond.wait(lock, [this]{ return m_quit || !m_batches.empty() || !m_queue.empty(); });
+    if (m_quit)
+    {
+      return;
+    }
+
+    if (!m_batches.empty())
+    {
+      // the caller of parallel_for() is waiting, images only might be
+      Batch* batch = m_batches.front();
+      batch->active += 1;
+      lock.unlock();
+      work(*batch);
+      lock.lock();
+
+      // all indices are handed out, nobody else needs to join in
+      auto it = std::find(m_batches.begin(), m_batches.end(), batch);
+      if (it != m_batches.end())
+      {
+        m_batches.erase(it);
+      }
+
+      batch->active -= 1;
+      if (batch->active == 0)
+      {
+        m_done_cond.notify_all();
+      }
+      continue;
+    }
+
+    const std::string filename = m_queue.front();
+    m_queue.pop_front();
+
+    // std::map doesn't move its elements, so the job stays valid
+    // while unlocked, take() and discard() only remove jobs that are
+    // done
+    auto it = m_jobs.find(filename);
+    Job result;
+    lock.unlock();
+    decode(filename, result);
+    lock.lock();
+
+    if (it->second.discarded)
+    {
+      m_jobs.erase(it);
+    }
+    else
+    {
+      it->second = std::move(result);
+      m_done_cond.notify_all();
+    }
+  }
+}
+
+/* EOF */
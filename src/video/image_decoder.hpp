@@ -0,0 +1,130 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_IMAGE_DECODER_HPP
+#define HEADER_SUPERTUX_VIDEO_IMAGE_DECODER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/currenton.hpp"
+#include "video/sdl_surface_ptr.hpp"
+
+/** Pool of worker threads that decode image files in the background.
+    Images get requested ahead of time, e.g. for everything a tileset
+    references, and the finished SDL_Surface is picked up with take()
+    once it is actually needed, so that only the texture upload is left
+    for the main thread. There is one pool per process, it also keeps
+    SDL_image initialized. */
+class ImageDecoder final : public Currenton<ImageDecoder>
+{
+public:
+  /** num_threads of 0 picks one less than the number of cores */
+  ImageDecoder(unsigned int num_threads = 0);
+  ~ImageDecoder();
+
+  /** Queue filename for decoding, requests for files that are already
+      queued or decoded are ignored */
+  void request(const std::string& filename);
+
+  /** Hands out the decoded image of a requested file, waiting for the
+      workers to finish it if needed. A request that no worker has
+      picked up yet is decoded right away on the calling thread.
+      Returns false if filename was never requested, throws if the file
+      couldn't be decoded. */
+  bool take(const std::string& filename, SDLSurfacePtr& surface);
+
+  /** Forgets every request that wasn't taken, e.g. for images that
+      were prefetched but never loaded, so that their pixels don't
+      stay around. Images still being decoded are dropped once done. */
+  void discard();
+
+  /** Calls func(0) to func(count - 1) on the workers and the calling
+      thread, returning once all calls are done, so that other loaders
+      can share the pool instead of starting threads of their own.
+      Workers take this on before queued images. func must not
+      throw. */
+  void parallel_for(size_t count, const std::function<void (size_t)>& func);
+
+  size_t get_thread_count() const { return m_threads.size(); }
+
+private:
+  struct Job
+  {
+    Job() : done(false), discarded(false), surface(), error() {}
+
+    bool done;
+
+    /** Set by discard() while a worker decodes the image, the worker
+        drops the job when it is done */
+    bool discarded;
+    SDLSurfacePtr surface;
+    std::string error;
+  };
+
+  /** A parallel_for() call, lives on the stack of its caller */
+  struct Batch
+  {
+    Batch(size_t count_, const std::function<void (size_t)>& func_) :
+      count(count_), func(func_), next(0), active(0) {}
+
+    const size_t count;
+    const std::function<void (size_t)>& func;
+    std::atomic<size_t> next;
+
+    /** Workers inside work(), guarded by m_mutex */
+    int active;
+  };
+
+  static void decode(const std::string& filename, Job& job);
+  static void work(Batch& batch);
+
+  void run();
+
+private:
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+
+  /** Signaled when a request is queued or the workers should quit */
+  std::condition_variable m_request_cond;
+
+  /** Signaled when a worker finished a job */
+  std::condition_variable m_done_cond;
+
+  std::deque<std::string> m_queue;
+
+  /** parallel_for() calls that still have indices left */
+  std::deque<Batch*> m_batches;
+
+  std::map<std::string, Job> m_jobs;
+  bool m_quit;
+
+private:
+  ImageDecoder(const ImageDecoder&) = delete;
+  ImageDecoder& operator=(const ImageDecoder&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -50,4 +50,9 @@ NullTexture::get_image_height() const
   return m_image_size.height;
 }
 
+void
+NullTexture::upload(const SDL_Surface& image, int x, int y)
+{
+}
+
 /* EOF */
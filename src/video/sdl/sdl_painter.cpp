@@ -226,13 +226,10 @@ SDLPainter::draw_texture(const TextureRequest& request)
 {
   const auto& texture = static_cast<const SDLTexture&>(*request.texture);
 
-  assert(request.srcrects.size() == request.dstrects.size());
-  assert(request.srcrects.size() == request.angles.size());
-
-  for (size_t i = 0; i < request.srcrects.size(); ++i)
+  for (size_t i = 0; i < request.count; ++i)
   {
     const SDL_Rect& src_rect = to_sdl_rect(request.srcrects[i]);
-    const SDL_Rect& dst_rect = to_sdl_rect(request.dstrects[i]);
+    const SDL_Rect& dst_rect = to_sdl_rect(request.dstrects[i].moved(request.offset));
 
     Uint8 r = static_cast<Uint8>(request.color.red * 255);
     Uint8 g = static_cast<Uint8>(request.color.green * 255);
@@ -256,7 +253,7 @@ SDLPainter::draw_texture(const TextureRequest& request)
 
     RenderCopyEx(m_sdl_renderer, texture.get_texture(),
                  &src_rect, &dst_rect,
-                 static_cast<double>(request.angles[i]), nullptr, flip,
+                 request.angles ? static_cast<double>(request.angles[i]) : 0.0, nullptr, flip,
                  texture.get_sampler());
   }
 }
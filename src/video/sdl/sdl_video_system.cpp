@@ -39,7 +39,8 @@ SDLVideoSystem::SDLVideoSystem() :
   create_window();
 
   m_renderer.reset(new SDLScreenRenderer(*this, m_sdl_renderer.get()));
-  m_texture_manager.reset(new TextureManager);
+  m_texture_manager.reset(new TextureManager(g_config->use_texture_atlas,
+                                             static_cast<size_t>(g_config->texture_memory_budget) * 1024 * 1024));
 
   apply_config();
 }
@@ -110,7 +111,9 @@ SDLVideoSystem::get_lightmap() const
 TexturePtr
 SDLVideoSystem::new_texture(const SDL_Surface& image, const Sampler& sampler)
 {
-  return TexturePtr(new SDLTexture(image, sampler));
+  TexturePtr texture(new SDLTexture(image, sampler));
+  m_texture_manager->register_texture(*texture);
+  return texture;
 }
 
 void
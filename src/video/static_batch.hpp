@@ -0,0 +1,79 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_STATIC_BATCH_HPP
+#define HEADER_SUPERTUX_VIDEO_STATIC_BATCH_HPP
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include "math/rectf.hpp"
+
+/** Renderer specific copy of the quads of a StaticBatch, e.g. a
+    vertex buffer on the GPU */
+class StaticBatchCache
+{
+public:
+  StaticBatchCache() {}
+  virtual ~StaticBatchCache() {}
+
+private:
+  StaticBatchCache(const StaticBatchCache&) = delete;
+  StaticBatchCache& operator=(const StaticBatchCache&) = delete;
+};
+
+/** Quads of a single surface that are kept across frames, like the
+    tiles of a tilemap. Renderers can keep a copy of them in a
+    StaticBatchCache and only have to rebuild it when the revision
+    changes. */
+class StaticBatch final
+{
+public:
+  StaticBatch();
+
+  void clear();
+  void add(const Rectf& srcrect, const Rectf& dstrect);
+
+  size_t size() const { return m_srcrects.size(); }
+  bool empty() const { return m_srcrects.empty(); }
+
+  const std::vector<Rectf>& get_srcrects() const { return m_srcrects; }
+  const std::vector<Rectf>& get_dstrects() const { return m_dstrects; }
+
+  /** Changes whenever quads are added or removed */
+  uint32_t get_revision() const { return m_revision; }
+
+  StaticBatchCache* get_cache() const { return m_cache.get(); }
+  void set_cache(std::unique_ptr<StaticBatchCache> cache) const { m_cache = std::move(cache); }
+
+private:
+  std::vector<Rectf> m_srcrects;
+  std::vector<Rectf> m_dstrects;
+  uint32_t m_revision;
+
+  /** Owned by the batch so that it goes away together with it, but
+      filled in by the renderer */
+  mutable std::unique_ptr<StaticBatchCache> m_cache;
+
+private:
+  StaticBatch(const StaticBatch&) = delete;
+  StaticBatch& operator=(const StaticBatch&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -21,6 +21,7 @@
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/string_util.hpp"
+#include "video/sampler.hpp"
 #include "video/texture.hpp"
 #include "video/texture_manager.hpp"
 #include "video/video_system.hpp"
@@ -28,13 +29,6 @@
 SurfacePtr
 Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>& rect)
 {
-  TexturePtr diffuse_texture;
-  boost::optional<ReaderMapping> diffuse_texture_mapping;
-  if (mapping.get("diffuse-texture", diffuse_texture_mapping))
-  {
-    diffuse_texture = TextureManager::current()->get(*diffuse_texture_mapping, rect);
-  }
-
   TexturePtr displacement_texture;
   boost::optional<ReaderMapping> displacement_texture_mapping;
   if (mapping.get("displacement-texture", displacement_texture_mapping))
@@ -42,6 +36,25 @@ Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>&
     displacement_texture = TextureManager::current()->get(*displacement_texture_mapping, rect);
   }
 
+  TexturePtr diffuse_texture;
+  boost::optional<Rect> region;
+  boost::optional<ReaderMapping> diffuse_texture_mapping;
+  if (mapping.get("diffuse-texture", diffuse_texture_mapping))
+  {
+    if (displacement_texture)
+    {
+      // both textures are sampled with the same coordinates, so the
+      // diffuse one can't be moved into the atlas
+      diffuse_texture = TextureManager::current()->get(*diffuse_texture_mapping, rect);
+    }
+    else
+    {
+      Rect image_region;
+      diffuse_texture = TextureManager::current()->get_image(*diffuse_texture_mapping, rect, image_region);
+      region = image_region;
+    }
+  }
+
   Flip flip = NO_FLIP;
   std::vector<bool> flip_v;
   if (mapping.get("flip", flip_v))
@@ -50,7 +63,14 @@ Surface::from_reader(const ReaderMapping& mapping, const boost::optional<Rect>&
     flip ^= flip_v[1] ? VERTICAL_FLIP : NO_FLIP;
   }
 
-  return SurfacePtr(new Surface(diffuse_texture, displacement_texture, flip));
+  if (region)
+  {
+    return SurfacePtr(new Surface(diffuse_texture, displacement_texture, *region, flip));
+  }
+  else
+  {
+    return SurfacePtr(new Surface(diffuse_texture, displacement_texture, flip));
+  }
 }
 
 SurfacePtr
@@ -73,16 +93,9 @@ Surface::from_file(const std::string& filename, const boost::optional<Rect>& rec
   }
   else
   {
-    if (rect)
-    {
-      TexturePtr texture = TextureManager::current()->get(filename, *rect);
-      return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP));
-    }
-    else
-    {
-      TexturePtr texture = TextureManager::current()->get(filename);
-      return SurfacePtr(new Surface(texture, TexturePtr(), NO_FLIP));
-    }
+    Rect region;
+    TexturePtr texture = TextureManager::current()->get_image(filename, rect, Sampler(), region);
+    return SurfacePtr(new Surface(texture, TexturePtr(), region, NO_FLIP));
   }
 }
 
@@ -132,7 +145,7 @@ Surface::region(const Rect& rect) const
 {
   SurfacePtr surface(new Surface(m_diffuse_texture,
                                  m_displacement_texture,
-                                 rect,
+                                 rect.moved(m_region.left, m_region.top),
                                  m_flip));
   return surface;
 }
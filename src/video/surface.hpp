@@ -46,11 +46,14 @@ private:
 public:
   ~Surface();
 
+  /** rect is relative to the region of this surface */
   SurfacePtr region(const Rect& rect) const;
   SurfacePtr clone(Flip flip = NO_FLIP) const;
 
   TexturePtr get_texture() const;
   TexturePtr get_displacement_texture() const;
+  /** Area of the image on get_texture(), which can be a shared atlas
+      page */
   Rect get_region() const { return m_region; }
   int get_width() const;
   int get_height() const;
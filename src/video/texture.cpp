@@ -19,7 +19,8 @@
 #include "video/texture_manager.hpp"
 
 Texture::Texture() :
-  m_cache_key()
+  m_cache_key(),
+  m_byte_size(0)
 {
 }
 
@@ -31,6 +32,11 @@ Texture::~Texture()
     // been cleared. Remove the entry altogether to save memory.
     TextureManager::current()->reap_cache_entry(*m_cache_key);
   }
+
+  if (TextureManager::current() && m_byte_size)
+  {
+    TextureManager::current()->release_texture(*this);
+  }
 }
 
 /* EOF */
@@ -24,6 +24,8 @@
 #include "math/rect.hpp"
 #include "video/flip.hpp"
 
+struct SDL_Surface;
+
 /** This class is a wrapper around a texture handle. It stores the
     texture width and height and provides convenience functions for
     uploading SDL_Surfaces into the texture. */
@@ -47,9 +49,16 @@ public:
   virtual int get_image_width() const = 0;
   virtual int get_image_height() const = 0;
 
+  /** Replaces the pixels at (x, y) with those of image, used to fill
+      the pages of the texture atlas */
+  virtual void upload(const SDL_Surface& image, int x, int y) = 0;
+
 private:
   boost::optional<Key> m_cache_key;
 
+  /** Memory accounted for by TextureManager::register_texture() */
+  size_t m_byte_size;
+
 private:
   Texture(const Texture&) = delete;
   Texture& operator=(const Texture&) = delete;
@@ -0,0 +1,62 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/texture_atlas.hpp"
+
+TextureAtlas::TextureAtlas(int width, int height) :
+  m_width(width),
+  m_height(height),
+  m_shelves(),
+  m_used_area(0)
+{
+}
+
+boost::optional<Rect>
+TextureAtlas::insert(int width, int height)
+{
+  if (width <= 0 || height <= 0 || width > m_width || height > m_height)
+    return boost::none;
+
+  // pick the lowest shelf the image fits on, to not waste the height
+  // of tall shelves on small images
+  Shelf* best = nullptr;
+  for (auto& shelf : m_shelves)
+  {
+    if (shelf.height >= height &&
+        m_width - shelf.used_width >= width &&
+        (!best || shelf.height < best->height))
+    {
+      best = &shelf;
+    }
+  }
+
+  if (!best)
+  {
+    const int top = m_shelves.empty() ? 0 : m_shelves.back().top + m_shelves.back().height;
+    if (m_height - top < height)
+      return boost::none;
+
+    m_shelves.push_back({ top, height, 0 });
+    best = &m_shelves.back();
+  }
+
+  Rect rect(best->used_width, best->top, best->used_width + width, best->top + height);
+  best->used_width += width;
+  m_used_area += width * height;
+  return rect;
+}
+
+/* EOF */
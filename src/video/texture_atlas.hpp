@@ -0,0 +1,60 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+#define HEADER_SUPERTUX_VIDEO_TEXTURE_ATLAS_HPP
+
+#include <vector>
+#include <boost/optional.hpp>
+
+#include "math/rect.hpp"
+
+/** Shelf packer for the pages of the atlas in TextureManager. Images
+    are placed left to right on horizontal shelves, a new shelf is
+    opened below the last one when no existing shelf has room. */
+class TextureAtlas final
+{
+public:
+  TextureAtlas(int width, int height);
+
+  /** Returns the position of a width x height area on the page, or
+      none if it doesn't fit anymore */
+  boost::optional<Rect> insert(int width, int height);
+
+  int get_width() const { return m_width; }
+  int get_height() const { return m_height; }
+
+  /** Number of pixels handed out by insert() */
+  int get_used_area() const { return m_used_area; }
+
+private:
+  struct Shelf
+  {
+    int top;
+    int height;
+    int used_width;
+  };
+
+private:
+  int m_width;
+  int m_height;
+  std::vector<Shelf> m_shelves;
+  int m_used_area;
+};
+
+#endif
+
+/* EOF */
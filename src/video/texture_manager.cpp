@@ -17,6 +17,7 @@
 #include "video/texture_manager.hpp"
 
 #include <SDL_image.h>
+#include <algorithm>
 #include <assert.h>
 #include <sstream>
 
@@ -26,8 +27,10 @@
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
+#include "util/string_util.hpp"
 #include "video/color.hpp"
 #include "video/gl.hpp"
+#include "video/image_decoder.hpp"
 #include "video/sampler.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture.hpp"
@@ -73,11 +76,38 @@ GLenum string2filter(const std::string& text)
   }
 }
 
+/** Largest image width and height that is still placed in the atlas */
+const int ATLAS_MAX_IMAGE_SIZE = 256;
+
+const int ATLAS_PAGE_SIZE = 1024;
+
+/** Border around each image in the atlas, filled with copies of the
+    image's edge pixels so that filtering doesn't bleed in the
+    neighbors */
+const int ATLAS_PADDING = 1;
+
+bool atlas_supports(const Sampler& sampler)
+{
+  // the texture coordinates of wrapped or animated textures go beyond
+  // the image, which doesn't work with a shared texture
+  return (sampler.get_wrap_s() == GL_CLAMP_TO_EDGE &&
+          sampler.get_wrap_t() == GL_CLAMP_TO_EDGE &&
+          sampler.get_animate().x == 0.0f &&
+          sampler.get_animate().y == 0.0f);
+}
+
 } // namespace
 
-TextureManager::TextureManager() :
+TextureManager::TextureManager(bool use_atlas, size_t budget) :
   m_image_textures(),
-  m_surfaces()
+  m_surfaces(),
+  m_surface_use_counter(0),
+  m_surface_bytes(0),
+  m_texture_bytes(0),
+  m_budget(budget),
+  m_use_atlas(use_atlas),
+  m_atlas_pages(),
+  m_atlas_images()
 {
 }
 
@@ -90,6 +120,8 @@ TextureManager::~TextureManager()
       log_warning << "Texture '" << std::get<0>(texture.first) << "' not freed" << std::endl;
     }
   }
+  m_atlas_images.clear();
+  m_atlas_pages.clear();
   m_image_textures.clear();
   m_surfaces.clear();
 }
@@ -98,6 +130,26 @@ TexturePtr
 TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& region)
 {
   std::string filename;
+  boost::optional<Rect> rect;
+  Sampler sampler;
+  parse_mapping(mapping, region, filename, rect, sampler);
+  return get(filename, rect, sampler);
+}
+
+TexturePtr
+TextureManager::get_image(const ReaderMapping& mapping, const boost::optional<Rect>& region, Rect& image_region)
+{
+  std::string filename;
+  boost::optional<Rect> rect;
+  Sampler sampler;
+  parse_mapping(mapping, region, filename, rect, sampler);
+  return get_image(filename, rect, sampler, image_region);
+}
+
+void
+TextureManager::parse_mapping(const ReaderMapping& mapping, const boost::optional<Rect>& region,
+                              std::string& filename, boost::optional<Rect>& rect, Sampler& sampler) const
+{
   if (!mapping.get("file", filename))
   {
     log_warning << "'file' tag missing" << std::endl;
@@ -107,7 +159,6 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     filename = FileSystem::join(mapping.get_doc().get_directory(), filename);
   }
 
-  boost::optional<Rect> rect;
   std::vector<int> rect_v;
   if (mapping.get("rect", rect_v))
   {
@@ -177,7 +228,7 @@ TextureManager::get(const ReaderMapping& mapping, const boost::optional<Rect>& r
     }
   }
 
-  return get(filename, rect, Sampler(filter, wrap_s, wrap_t, animate));
+  sampler = Sampler(filter, wrap_s, wrap_t, animate);
 }
 
 TexturePtr
@@ -233,11 +284,191 @@ TextureManager::get(const std::string& _filename,
     }
     texture->m_cache_key = key;
     m_image_textures[key] = texture;
+
+    enforce_budget();
+  }
+
+  return texture;
+}
+
+TexturePtr
+TextureManager::get_image(const std::string& _filename,
+                          const boost::optional<Rect>& rect,
+                          const Sampler& sampler,
+                          Rect& region)
+{
+  if (m_use_atlas && atlas_supports(sampler))
+  {
+    std::string filename = FileSystem::normalize(_filename);
+    Texture::Key key(filename, rect ? *rect : Rect());
+
+    auto it = m_atlas_images.find(key);
+    if (it != m_atlas_images.end())
+    {
+      if (TexturePtr page_texture = m_atlas_pages[it->second.first]->texture.lock())
+      {
+        region = it->second.second;
+        return page_texture;
+      }
+    }
+
+    auto i = m_image_textures.find(key);
+    TexturePtr texture = (i != m_image_textures.end()) ? i->second.lock() : TexturePtr();
+    if (!texture)
+    {
+      try
+      {
+        SDLSurfacePtr loaded;
+        const SDL_Surface* image;
+        if (rect)
+        {
+          image = &get_surface(filename);
+        }
+        else
+        {
+          loaded = load_surface(filename);
+          image = loaded.get();
+        }
+
+        const Rect image_rect = rect ? *rect : Rect(0, 0, image->w, image->h);
+        if (image_rect.left < 0 || image_rect.top < 0 ||
+            image_rect.right > image->w || image_rect.bottom > image->h ||
+            image_rect.empty())
+        {
+          std::ostringstream msg;
+          msg << "rect " << image_rect << " outside of image '" << filename << "'";
+          throw std::runtime_error(msg.str());
+        }
+
+        if (image_rect.get_width() <= ATLAS_MAX_IMAGE_SIZE &&
+            image_rect.get_height() <= ATLAS_MAX_IMAGE_SIZE)
+        {
+          std::pair<size_t, Rect> entry;
+          TexturePtr page_texture = add_to_atlas(*image, image_rect, sampler, entry);
+          m_atlas_images[key] = entry;
+          region = entry.second;
+          enforce_budget();
+          return page_texture;
+        }
+        else if (loaded)
+        {
+          // too large for the atlas, but no need to decode it twice
+          texture = VideoSystem::current()->new_texture(*loaded, sampler);
+          texture->m_cache_key = key;
+          m_image_textures[key] = texture;
+        }
+      }
+      catch (const std::exception& err)
+      {
+        log_warning << "Couldn't place '" << filename << "' in texture atlas: " << err.what() << std::endl;
+      }
+    }
+
+    if (texture)
+    {
+      region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+      return texture;
+    }
+  }
+
+  TexturePtr texture = get(_filename, rect, sampler);
+  region = Rect(0, 0, texture->get_image_width(), texture->get_image_height());
+  return texture;
+}
+
+TexturePtr
+TextureManager::add_to_atlas(const SDL_Surface& image, const Rect& rect, const Sampler& sampler,
+                             std::pair<size_t, Rect>& entry)
+{
+  const int width = rect.get_width();
+  const int height = rect.get_height();
+  const int padded_width = width + 2 * ATLAS_PADDING;
+  const int padded_height = height + 2 * ATLAS_PADDING;
+
+  size_t page_idx = 0;
+  TexturePtr texture;
+  boost::optional<Rect> area;
+  for (; page_idx < m_atlas_pages.size(); ++page_idx)
+  {
+    const auto& page = m_atlas_pages[page_idx];
+    if (page && page->sampler.get_filter() == sampler.get_filter())
+    {
+      area = page->atlas.insert(padded_width, padded_height);
+      if (area)
+      {
+        texture = page->texture.lock();
+        assert(texture);
+        break;
+      }
+    }
+  }
+
+  if (!area)
+  {
+    SDLSurfacePtr blank = SDLSurface::create_rgba(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE);
+    texture = VideoSystem::current()->new_texture(*blank, sampler);
+
+    page_idx = std::find(m_atlas_pages.begin(), m_atlas_pages.end(), nullptr) - m_atlas_pages.begin();
+    if (page_idx == m_atlas_pages.size())
+    {
+      m_atlas_pages.emplace_back();
+    }
+    m_atlas_pages[page_idx].reset(new AtlasPage(texture, sampler, ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE));
+
+    area = m_atlas_pages[page_idx]->atlas.insert(padded_width, padded_height);
+    assert(area);
+  }
+
+  // bring the image into RGBA, then extrude its edges into the padding
+  SDLSurfacePtr converted = SDLSurface::create_rgba(width, height);
+  SDL_Rect srcrect = { rect.left, rect.top, width, height };
+  SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
+  SDL_BlitSurface(const_cast<SDL_Surface*>(&image), &srcrect, converted.get(), nullptr);
+
+  SDLSurfacePtr padded = SDLSurface::create_rgba(padded_width, padded_height);
+  for (int y = 0; y < padded_height; ++y)
+  {
+    const int src_y = std::min(std::max(y - ATLAS_PADDING, 0), height - 1);
+    const uint32_t* src_row = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(converted->pixels) +
+                                                                src_y * converted->pitch);
+    uint32_t* dst_row = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(padded->pixels) +
+                                                    y * padded->pitch);
+    for (int x = 0; x < padded_width; ++x)
+    {
+      dst_row[x] = src_row[std::min(std::max(x - ATLAS_PADDING, 0), width - 1)];
+    }
   }
 
+  texture->upload(*padded, area->left, area->top);
+
+  entry = std::make_pair(page_idx, Rect(area->left + ATLAS_PADDING, area->top + ATLAS_PADDING,
+                                        Size(width, height)));
   return texture;
 }
 
+void
+TextureManager::drop_unused_atlas_pages()
+{
+  for (size_t page_idx = 0; page_idx < m_atlas_pages.size(); ++page_idx)
+  {
+    if (m_atlas_pages[page_idx] && m_atlas_pages[page_idx]->texture.expired())
+    {
+      m_atlas_pages[page_idx].reset();
+      for (auto it = m_atlas_images.begin(); it != m_atlas_images.end();)
+      {
+        if (it->second.first == page_idx)
+        {
+          it = m_atlas_images.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+    }
+  }
+}
+
 void
 TextureManager::reap_cache_entry(const Texture::Key& key)
 {
@@ -267,25 +498,120 @@ TextureManager::create_image_texture(const std::string& filename, const Rect& re
   }
 }
 
+void
+TextureManager::release_texture(const Texture& texture)
+{
+  assert(m_texture_bytes >= texture.m_byte_size);
+  m_texture_bytes -= texture.m_byte_size;
+
+  // the texture might have been the last user of an atlas page
+  drop_unused_atlas_pages();
+}
+
+void
+TextureManager::register_texture(Texture& texture)
+{
+  texture.m_byte_size = static_cast<size_t>(texture.get_texture_width()) *
+                        static_cast<size_t>(texture.get_texture_height()) * 4;
+  m_texture_bytes += texture.m_byte_size;
+}
+
 const SDL_Surface&
 TextureManager::get_surface(const std::string& filename)
 {
   auto i = m_surfaces.find(filename);
   if (i != m_surfaces.end())
   {
-    return *i->second;
+    i->second.last_use = ++m_surface_use_counter;
+    return *i->second.surface;
   }
   else
   {
-    SDLSurfacePtr image = SDLSurface::from_file(filename);
+    auto& entry = m_surfaces[filename];
+    entry.surface = load_surface(filename);
+    entry.last_use = ++m_surface_use_counter;
+    m_surface_bytes += static_cast<size_t>(entry.surface->pitch) * static_cast<size_t>(entry.surface->h);
+    return *entry.surface;
+  }
+}
+
+void
+TextureManager::enforce_budget()
+{
+  if (m_budget == 0)
+    return;
+
+  // only surfaces count, textures can't be dropped here and once they
+  // alone went over the budget every new one would flush the cache
+  while (m_surface_bytes > m_budget && !m_surfaces.empty())
+  {
+    auto lru = std::min_element(m_surfaces.begin(), m_surfaces.end(),
+                                [](const std::pair<const std::string, SurfaceEntry>& lhs,
+                                   const std::pair<const std::string, SurfaceEntry>& rhs) {
+                                  return lhs.second.last_use < rhs.second.last_use;
+                                });
+
+    // the texture is uploaded, the image only gets decoded again when
+    // another part of it is requested
+    const SDL_Surface& surface = *lru->second.surface;
+    m_surface_bytes -= static_cast<size_t>(surface.pitch) * static_cast<size_t>(surface.h);
+    log_debug << "evicting surface '" << lru->first << "'" << std::endl;
+    m_surfaces.erase(lru);
+  }
+}
+
+SDLSurfacePtr
+TextureManager::load_surface(const std::string& filename)
+{
+  SDLSurfacePtr image;
+  if (!ImageDecoder::current() || !ImageDecoder::current()->take(filename, image))
+  {
+    image = SDLSurface::from_file(filename);
     if (!image)
     {
       std::ostringstream msg;
       msg << "Couldn't load image '" << filename << "' :" << SDL_GetError();
       throw std::runtime_error(msg.str());
     }
+  }
+  return image;
+}
+
+void
+TextureManager::prefetch(const std::string& _filename)
+{
+  if (StringUtil::has_suffix(_filename, ".surface"))
+  {
+    return;
+  }
+
+  std::string filename = FileSystem::normalize(_filename);
+  Texture::Key key(filename, Rect());
+
+  if (m_surfaces.find(filename) != m_surfaces.end() ||
+      m_atlas_images.find(key) != m_atlas_images.end())
+  {
+    return;
+  }
+
+  auto i = m_image_textures.find(key);
+  if (i != m_image_textures.end() && !i->second.expired())
+  {
+    return;
+  }
+
+  if (ImageDecoder::current())
+  {
+    ImageDecoder::current()->request(filename);
+  }
+}
 
-    return *(m_surfaces[filename] = std::move(image));
+void
+TextureManager::discard_prefetched()
+{
+  if (ImageDecoder::current())
+  {
+    ImageDecoder::current()->discard();
   }
 }
 
@@ -341,19 +667,10 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
 TexturePtr
 TextureManager::create_image_texture_raw(const std::string& filename, const Sampler& sampler)
 {
-  SDLSurfacePtr image = SDLSurface::from_file(filename);
-  if (!image)
-  {
-    std::ostringstream msg;
-    msg << "Couldn't load image '" << filename << "' :" << SDL_GetError();
-    throw std::runtime_error(msg.str());
-  }
-  else
-  {
-    TexturePtr texture = VideoSystem::current()->new_texture(*image, sampler);
-    image.reset(nullptr);
-    return texture;
-  }
+  SDLSurfacePtr image = load_surface(filename);
+  TexturePtr texture = VideoSystem::current()->new_texture(*image, sampler);
+  image.reset(nullptr);
+  return texture;
 }
 
 TexturePtr
@@ -409,7 +726,7 @@ TextureManager::debug_print(std::ostream& out) const
   for(const auto& it : m_surfaces)
   {
     const auto& filename = it.first;
-    const auto& surface = it.second;
+    const auto& surface = it.second.surface;
 
     total_surface_pixels += surface->w * surface->h;
     out << "  surface filename:" << filename << " " << surface->w << "x" << surface->h << std::endl;
@@ -421,6 +738,38 @@ TextureManager::debug_print(std::ostream& out) const
 
   out << "total surface count:" << m_surfaces.size() << std::endl;
   out << "total surface pixels:" << total_surface_pixels << std::endl;
+
+  out << "total surface bytes:" << m_surface_bytes << std::endl;
+  out << "total texture bytes:" << m_texture_bytes << std::endl;
+  out << "budget bytes:" << m_budget << std::endl;
+
+  int total_atlas_used = 0;
+  int total_atlas_pixels = 0;
+  size_t total_atlas_pages = 0;
+  out << "atlas:begin" << std::endl;
+  for(const auto& page : m_atlas_pages)
+  {
+    if (!page)
+      continue;
+
+    const auto& atlas = page->atlas;
+    const int page_pixels = atlas.get_width() * atlas.get_height();
+
+    total_atlas_used += atlas.get_used_area();
+    total_atlas_pixels += page_pixels;
+    total_atlas_pages += 1;
+    out << "  page " << atlas.get_width() << "x" << atlas.get_height()
+        << " filter:" << page->sampler.get_filter()
+        << " use_count:" << page->texture.use_count()
+        << " occupancy:" << 100 * atlas.get_used_area() / page_pixels << "%" << std::endl;
+  }
+  out << "atlas:end" << std::endl;
+
+  out << "total atlas images:" << m_atlas_images.size() << std::endl;
+  out << "total atlas pages:" << total_atlas_pages << std::endl;
+  out << "total atlas bytes:" << total_atlas_pixels * 4 << std::endl;
+  out << "total atlas occupancy:"
+      << (total_atlas_pixels ? 100 * total_atlas_used / total_atlas_pixels : 0) << "%" << std::endl;
 }
 
 /* EOF */
@@ -31,6 +31,7 @@
 #include "video/sampler.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
 #include "video/texture_ptr.hpp"
 
 class GLTexture;
@@ -43,7 +44,13 @@ public:
   friend class Texture;
 
 public:
-  TextureManager();
+  /** With use_atlas set, small images get packed into shared
+      textures, see get_image(). Once the decoded images kept for
+      further uploads take up more than budget bytes, the least
+      recently used ones get dropped, 0 disables the limit. Textures,
+      atlas pages included, are counted but not limited, they are
+      freed with their last user. */
+  TextureManager(bool use_atlas = false, size_t budget = 0);
   ~TextureManager();
 
   TexturePtr get(const ReaderMapping& mapping, const boost::optional<Rect>& region = boost::none);
@@ -52,11 +59,55 @@ public:
                  const boost::optional<Rect>& rect,
                  const Sampler& sampler = Sampler());
 
+  /** Like get(), but the image may end up on a page of the texture
+      atlas together with others. region receives the area of the
+      image on the returned texture. */
+  TexturePtr get_image(const std::string& filename,
+                       const boost::optional<Rect>& rect,
+                       const Sampler& sampler,
+                       Rect& region);
+  TexturePtr get_image(const ReaderMapping& mapping, const boost::optional<Rect>& region, Rect& image_region);
+
+  /** Starts decoding filename in the background, so that a later
+      get() or get_image() only has to upload it */
+  void prefetch(const std::string& filename);
+
+  /** Drops prefetched images that nothing loaded, called once loading
+      is done */
+  void discard_prefetched();
+
+  /** Accounts for the memory of a texture created by the VideoSystem,
+      the texture takes itself off again when it is destroyed */
+  void register_texture(Texture& texture);
+
+  /** Bytes of decoded images kept around for further uploads */
+  size_t get_surface_bytes() const { return m_surface_bytes; }
+
+  /** Bytes of all textures alive */
+  size_t get_texture_bytes() const { return m_texture_bytes; }
+
+  size_t get_budget() const { return m_budget; }
+
   void debug_print(std::ostream& out) const;
 
 private:
+  /** Reads the file, rect and sampler settings of a texture
+      description, rect is the part of the image covered by region */
+  void parse_mapping(const ReaderMapping& mapping, const boost::optional<Rect>& region,
+                     std::string& filename, boost::optional<Rect>& rect, Sampler& sampler) const;
+
+  /** Picks up a prefetched image or decodes it right away, throws on
+      error */
+  SDLSurfacePtr load_surface(const std::string& filename);
+
   const SDL_Surface& get_surface(const std::string& filename);
   void reap_cache_entry(const Texture::Key& key);
+  void release_texture(const Texture& texture);
+
+  /** Drops least recently used surfaces until the budget is met,
+      must not be called while a reference from get_surface() is in
+      use */
+  void enforce_budget();
 
   TexturePtr create_image_texture(const std::string& filename, const Rect& rect, const Sampler& sampler);
 
@@ -69,9 +120,55 @@ private:
 
   TexturePtr create_dummy_texture();
 
+  /** Places the rect area of image on an atlas page and returns the
+      page texture, entry receives the page index and the area used on
+      the page */
+  TexturePtr add_to_atlas(const SDL_Surface& image, const Rect& rect, const Sampler& sampler,
+                          std::pair<size_t, Rect>& entry);
+
+  /** Forgets the pages whose texture is gone together with the images
+      placed on them */
+  void drop_unused_atlas_pages();
+
+private:
+  struct AtlasPage
+  {
+    AtlasPage(const TexturePtr& texture_, const Sampler& sampler_, int width, int height) :
+      texture(texture_),
+      sampler(sampler_),
+      atlas(width, height)
+    {}
+
+    /** Held by the users of the images on the page only */
+    std::weak_ptr<Texture> texture;
+    Sampler sampler;
+    TextureAtlas atlas;
+  };
+
+  struct SurfaceEntry
+  {
+    SDLSurfacePtr surface;
+    unsigned last_use;
+  };
+
 private:
   std::map<Texture::Key, std::weak_ptr<Texture> > m_image_textures;
-  std::map<std::string, SDLSurfacePtr> m_surfaces;
+  std::map<std::string, SurfaceEntry> m_surfaces;
+  unsigned m_surface_use_counter;
+
+  size_t m_surface_bytes;
+  size_t m_texture_bytes;
+  size_t m_budget;
+
+  bool m_use_atlas;
+
+  /** A page goes away with the last user of any of its images, its
+      slot stays empty until the next new page so that the indices in
+      m_atlas_images remain valid */
+  std::vector<std::unique_ptr<AtlasPage> > m_atlas_pages;
+
+  /** Page index and area of the images placed in the atlas */
+  std::map<Texture::Key, std::pair<size_t, Rect> > m_atlas_images;
 
 private:
   TextureManager(const TextureManager&) = delete;
@@ -32,7 +32,8 @@ TTFFont::TTFFont(const std::string& filename, int font_size, float line_spacing,
   m_font_size(font_size),
   m_line_spacing(line_spacing),
   m_shadow_size(shadow_size),
-  m_border(border)
+  m_border(border),
+  m_glyph_cache(*this)
 {
   m_font = TTF_OpenFontRW(get_physfs_SDLRWops(m_filename), 1, font_size);
   if (!m_font)
@@ -61,9 +62,9 @@ TTFFont::get_text_width(const std::string& text) const
   {
     const std::string& line = iter.get();
 
-    // Since create_surface() takes a surface from the cache instead of
-    // generating it from scratch it should be faster than doing a whole
-    // layout.
+    // The glyph cache only sums up advances of already rasterised
+    // glyphs, create_surface() is left for glyphs that don't fit into
+    // the atlas.
     if ((false))
     {
       int w = 0;
@@ -75,6 +76,10 @@ TTFFont::get_text_width(const std::string& text) const
       }
       max_width = std::max(max_width, static_cast<float>(w));
     }
+    else if (auto width = m_glyph_cache.get_line_width(line))
+    {
+      max_width = std::max(max_width, static_cast<float>(*width));
+    }
     else
     {
       TTFSurfacePtr surface = TTFSurfaceManager::current()->create_surface(*this, line);
@@ -120,21 +125,20 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
 
     if (!line.empty())
     {
-      TTFSurfacePtr ttf_surface = TTFSurfaceManager::current()->create_surface(*this, line);
-
       Vector new_pos(pos.x, last_y);
 
-      if (alignment == ALIGN_CENTER)
+      if (alignment != ALIGN_LEFT)
       {
-        new_pos.x -= static_cast<float>(ttf_surface->get_width()) / 2.0f;
+        const float width = get_text_width(line);
+        new_pos.x -= (alignment == ALIGN_CENTER) ? width / 2.0f : width;
       }
-      else if (alignment == ALIGN_RIGHT)
+
+      // draw text, the glyph atlas covers everything but oversized glyphs
+      if (!m_glyph_cache.draw_line(canvas, line, new_pos.floor(), color, layer))
       {
-        new_pos.x -= static_cast<float>(ttf_surface->get_width());
+        TTFSurfacePtr ttf_surface = TTFSurfaceManager::current()->create_surface(*this, line);
+        canvas.draw_surface(ttf_surface->get_surface(), new_pos.floor(), 0.0f, color, Blend(), layer);
       }
-
-      // draw text
-      canvas.draw_surface(ttf_surface->get_surface(), new_pos.floor(), 0.0f, color, Blend(), layer);
     }
 
     last_y += get_height();
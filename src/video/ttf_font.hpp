@@ -22,6 +22,7 @@
 
 #include "video/color.hpp"
 #include "video/font.hpp"
+#include "video/ttf_glyph_cache.hpp"
 
 class Canvas;
 class Painter;
@@ -62,6 +63,8 @@ private:
   int m_shadow_size;
   int m_border;
 
+  mutable TTFGlyphCache m_glyph_cache;
+
 private:
   TTFFont(const TTFFont&) = delete;
   TTFFont& operator=(const TTFFont&) = delete;
@@ -0,0 +1,300 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/ttf_glyph_cache.hpp"
+
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <assert.h>
+
+#include "util/log.hpp"
+#include "util/utf8_iterator.hpp"
+#include "video/canvas.hpp"
+#include "video/sdl_surface.hpp"
+#include "video/sdl_surface_ptr.hpp"
+#include "video/surface.hpp"
+#include "video/texture.hpp"
+#include "video/ttf_font.hpp"
+#include "video/ttf_surface.hpp"
+#include "video/video_system.hpp"
+
+namespace {
+
+/** Size of a glyph atlas page, a few hundred glyphs of menu sized
+    text fit onto a single page */
+const int GLYPH_PAGE_SIZE = 512;
+
+/** Transparent gap between glyphs, keeps linear filtering from
+    bleeding neighbouring glyphs into each other */
+const int GLYPH_PADDING = 1;
+
+std::string encode_utf8(uint32_t codepoint)
+{
+  std::string result;
+  if (codepoint < 0x80)
+  {
+    result += static_cast<char>(codepoint);
+  }
+  else if (codepoint < 0x800)
+  {
+    result += static_cast<char>(0xC0 | (codepoint >> 6));
+    result += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  else if (codepoint < 0x10000)
+  {
+    result += static_cast<char>(0xE0 | (codepoint >> 12));
+    result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  else
+  {
+    result += static_cast<char>(0xF0 | (codepoint >> 18));
+    result += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    result += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    result += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+  return result;
+}
+
+} // namespace
+
+TTFGlyphCache::TTFGlyphCache(const TTFFont& font) :
+  m_font(font),
+  m_glyphs(),
+  m_pages(),
+  m_batches()
+{
+}
+
+boost::optional<int>
+TTFGlyphCache::get_line_width(const std::string& line)
+{
+  return layout(line, [](const Glyph&, int) {});
+}
+
+bool
+TTFGlyphCache::draw_line(Canvas& canvas, const std::string& line, const Vector& pos,
+                         const Color& color, int layer)
+{
+  for (auto& batch : m_batches)
+  {
+    batch.back_srcrects.clear();
+    batch.back_dstrects.clear();
+    batch.core_srcrects.clear();
+    batch.core_dstrects.clear();
+  }
+
+  auto width = layout(line, [this, &pos](const Glyph& glyph, int pen)
+  {
+    if (static_cast<size_t>(glyph.page) >= m_batches.size())
+    {
+      m_batches.resize(glyph.page + 1);
+    }
+
+    auto& batch = m_batches[glyph.page];
+    const Vector origin(pos.x + static_cast<float>(pen), pos.y);
+
+    if (glyph.back.get_width() > 0)
+    {
+      batch.back_srcrects.emplace_back(glyph.back);
+      batch.back_dstrects.emplace_back(origin, Sizef(static_cast<float>(glyph.back.get_width()),
+                                                     static_cast<float>(glyph.back.get_height())));
+    }
+
+    batch.core_srcrects.emplace_back(glyph.core);
+    batch.core_dstrects.emplace_back(origin, Sizef(static_cast<float>(glyph.core.get_width()),
+                                                   static_cast<float>(glyph.core.get_height())));
+  });
+
+  if (!width)
+  {
+    return false;
+  }
+
+  // shadows and outlines of the whole line go below all glyphs, as
+  // they would in a surface rendered by TTFSurface
+  for (size_t i = 0; i < m_batches.size(); ++i)
+  {
+    if (!m_batches[i].back_srcrects.empty())
+    {
+      canvas.draw_surface_batch(m_pages[i]->surface,
+                                m_batches[i].back_srcrects, m_batches[i].back_dstrects,
+                                color, layer);
+    }
+  }
+
+  for (size_t i = 0; i < m_batches.size(); ++i)
+  {
+    if (!m_batches[i].core_srcrects.empty())
+    {
+      canvas.draw_surface_batch(m_pages[i]->surface,
+                                m_batches[i].core_srcrects, m_batches[i].core_dstrects,
+                                color, layer);
+    }
+  }
+
+  return true;
+}
+
+template<typename F>
+boost::optional<int>
+TTFGlyphCache::layout(const std::string& line, F place)
+{
+  int pen = 0;
+  int width = 0;
+  uint32_t prev = 0;
+
+  for (UTF8Iterator it(line); !it.done(); ++it)
+  {
+    const uint32_t codepoint = *it;
+    const Glyph* glyph = get_glyph(codepoint);
+    if (!glyph)
+    {
+      return boost::none;
+    }
+
+    if (prev)
+    {
+      pen += get_kerning(prev, codepoint);
+    }
+
+    if (glyph->page >= 0)
+    {
+      place(*glyph, pen);
+      width = std::max(width, pen + glyph->core.get_width());
+    }
+
+    pen += glyph->advance;
+    width = std::max(width, pen);
+    prev = codepoint;
+  }
+
+  return width + std::max(m_font.get_border() * 2, m_font.get_shadow_size() * 2);
+}
+
+const TTFGlyphCache::Glyph*
+TTFGlyphCache::get_glyph(uint32_t codepoint)
+{
+  auto it = m_glyphs.find(codepoint);
+  if (it == m_glyphs.end())
+  {
+    it = m_glyphs.emplace(codepoint, create_glyph(codepoint)).first;
+  }
+  return it->second.get();
+}
+
+std::unique_ptr<TTFGlyphCache::Glyph>
+TTFGlyphCache::create_glyph(uint32_t codepoint)
+{
+  TTF_Font* font = m_font.get_ttf_font();
+
+  auto glyph = std::make_unique<Glyph>();
+  glyph->page = -1;
+  glyph->advance = 0;
+
+  int minx, maxx, miny, maxy;
+  const bool has_metrics = codepoint <= 0xFFFF &&
+    TTF_GlyphMetrics(font, static_cast<Uint16>(codepoint),
+                     &minx, &maxx, &miny, &maxy, &glyph->advance) == 0;
+
+  const std::string text = encode_utf8(codepoint);
+  SDLSurfacePtr text_surface(TTF_RenderUTF8_Blended(font, text.c_str(), SDL_Color{255, 255, 255, 255}));
+  if (!text_surface || text_surface->w == 0 || text_surface->h == 0)
+  {
+    // whitespace and glyphs missing from the font only move the pen
+    return glyph;
+  }
+
+  if (!has_metrics)
+  {
+    glyph->advance = text_surface->w;
+  }
+
+  SDLSurfacePtr back;
+  if (m_font.get_shadow_size() > 0 || m_font.get_border() > 0)
+  {
+    back = TTFSurface::composite(m_font, *text_surface, false);
+  }
+
+  // composite() leaves its color and alpha modulation on the surface
+  SDL_SetSurfaceAlphaMod(text_surface.get(), 255);
+  SDL_SetSurfaceColorMod(text_surface.get(), 255, 255, 255);
+
+  const int back_width = back ? back->w : 0;
+  const int back_height = back ? back->h : 0;
+  const int area_width = back_width + text_surface->w + 3 * GLYPH_PADDING;
+  const int area_height = std::max(back_height, text_surface->h) + 2 * GLYPH_PADDING;
+
+  if (area_width > GLYPH_PAGE_SIZE || area_height > GLYPH_PAGE_SIZE)
+  {
+    log_warning << "glyph " << codepoint << " too large for glyph atlas" << std::endl;
+    return {};
+  }
+
+  boost::optional<Rect> area;
+  size_t page_idx = 0;
+  for (; page_idx < m_pages.size(); ++page_idx)
+  {
+    area = m_pages[page_idx]->atlas.insert(area_width, area_height);
+    if (area) break;
+  }
+
+  if (!area)
+  {
+    SDLSurfacePtr blank = SDLSurface::create_rgba(GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE);
+    TexturePtr texture = VideoSystem::current()->new_texture(*blank);
+    m_pages.emplace_back(new Page(texture, Surface::from_texture(texture),
+                                  GLYPH_PAGE_SIZE, GLYPH_PAGE_SIZE));
+
+    page_idx = m_pages.size() - 1;
+    area = m_pages.back()->atlas.insert(area_width, area_height);
+    assert(area);
+  }
+
+  auto& page = *m_pages[page_idx];
+  const int x = area->left + GLYPH_PADDING;
+  const int y = area->top + GLYPH_PADDING;
+
+  if (back)
+  {
+    page.texture->upload(*back, x, y);
+    glyph->back = Rect(x, y, Size(back_width, back_height));
+  }
+
+  const int core_x = x + back_width + GLYPH_PADDING;
+  page.texture->upload(*text_surface, core_x, y);
+  glyph->core = Rect(core_x, y, Size(text_surface->w, text_surface->h));
+  glyph->page = static_cast<int>(page_idx);
+
+  return glyph;
+}
+
+int
+TTFGlyphCache::get_kerning(uint32_t left, uint32_t right) const
+{
+#if SDL_TTF_MAJOR_VERSION > 2 || \
+  (SDL_TTF_MAJOR_VERSION == 2 && (SDL_TTF_MINOR_VERSION > 0 || SDL_TTF_PATCHLEVEL >= 14))
+  if (left <= 0xFFFF && right <= 0xFFFF)
+  {
+    return TTF_GetFontKerningSizeGlyphs(m_font.get_ttf_font(),
+                                        static_cast<Uint16>(left),
+                                        static_cast<Uint16>(right));
+  }
+#endif
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,122 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HEADER_SUPERTUX_VIDEO_TTF_GLYPH_CACHE_HPP
+#define HEADER_SUPERTUX_VIDEO_TTF_GLYPH_CACHE_HPP
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/optional.hpp>
+
+#include "math/rect.hpp"
+#include "math/rectf.hpp"
+#include "video/surface_ptr.hpp"
+#include "video/texture_atlas.hpp"
+#include "video/texture_ptr.hpp"
+
+class Canvas;
+class Color;
+class TTFFont;
+class Vector;
+
+/** Rasterises the glyphs of a TTFFont once and keeps them in shared
+    atlas pages, text is then drawn as a batch of quads per page
+    instead of rendering every distinct string into its own texture. */
+class TTFGlyphCache final
+{
+public:
+  TTFGlyphCache(const TTFFont& font);
+
+  /** Width of line as it would be drawn by draw_line(), none if a
+      glyph of the line is too large for the atlas */
+  boost::optional<int> get_line_width(const std::string& line);
+
+  /** Draws a single line with its top left corner at pos, returns
+      false without drawing anything if a glyph is too large for the
+      atlas */
+  bool draw_line(Canvas& canvas, const std::string& line, const Vector& pos,
+                 const Color& color, int layer);
+
+private:
+  struct Glyph
+  {
+    /** Index into m_pages, -1 for glyphs without pixels */
+    int page;
+
+    /** Shadow and outline of the glyph, empty when the font has neither */
+    Rect back;
+
+    /** The white glyph itself */
+    Rect core;
+
+    int advance;
+  };
+
+  struct Page
+  {
+    Page(const TexturePtr& texture_, const SurfacePtr& surface_, int width, int height) :
+      texture(texture_),
+      surface(surface_),
+      atlas(width, height)
+    {}
+
+    TexturePtr texture;
+    SurfacePtr surface;
+    TextureAtlas atlas;
+  };
+
+  struct Batch
+  {
+    std::vector<Rectf> back_srcrects;
+    std::vector<Rectf> back_dstrects;
+    std::vector<Rectf> core_srcrects;
+    std::vector<Rectf> core_dstrects;
+  };
+
+private:
+  /** Returns the glyph for codepoint, rasterising it on first use,
+      or nullptr if it doesn't fit into an atlas page */
+  const Glyph* get_glyph(uint32_t codepoint);
+  std::unique_ptr<Glyph> create_glyph(uint32_t codepoint);
+
+  int get_kerning(uint32_t left, uint32_t right) const;
+
+  /** Runs the layout of line, calling place() with the pen position
+      of every glyph, returns the width of the line or none if a glyph
+      is missing */
+  template<typename F>
+  boost::optional<int> layout(const std::string& line, F place);
+
+private:
+  const TTFFont& m_font;
+  std::unordered_map<uint32_t, std::unique_ptr<Glyph> > m_glyphs;
+  std::vector<std::unique_ptr<Page> > m_pages;
+
+  /** Per page quads of the line in draw_line(), kept around to reuse
+      their allocations */
+  std::vector<Batch> m_batches;
+
+private:
+  TTFGlyphCache(const TTFGlyphCache&) = delete;
+  TTFGlyphCache& operator=(const TTFGlyphCache&) = delete;
+};
+
+#endif
+
+/* EOF */
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "math/vector.hpp"
+#include "video/sdl_surface_ptr.hpp"
 #include "video/surface_ptr.hpp"
 
 class TTFFont;
@@ -34,6 +35,11 @@ class TTFSurface final
 public:
   static TTFSurfacePtr create(const TTFFont& font, const std::string& text);
 
+  /** Renders the shadow and outline of the font around text_surface,
+      the white core is only included when with_core is set. The
+      result is grown by the size of the effects. */
+  static SDLSurfacePtr composite(const TTFFont& font, SDL_Surface& text_surface, bool with_core);
+
 public:
   TTFSurface(const SurfacePtr& surface, const Vector& offset);
 
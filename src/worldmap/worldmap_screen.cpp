@@ -44,7 +44,7 @@ WorldMapScreen::leave()
 }
 
 void
-WorldMapScreen::draw(Compositor& compositor)
+WorldMapScreen::draw(Compositor& compositor, float alpha)
 {
   auto& context = compositor.make_context();
   m_worldmap->draw(context);
@@ -0,0 +1,43 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "sprite/action_handle.hpp"
+
+TEST(ActionHandleTest, intern)
+{
+  ActionHandle left("action-handle-test-left");
+  ActionHandle right("action-handle-test-right");
+
+  ASSERT_TRUE(left.is_valid());
+  ASSERT_TRUE(right.is_valid());
+  ASSERT_NE(left, right);
+  ASSERT_EQ(left, ActionHandle("action-handle-test-left"));
+  ASSERT_EQ("action-handle-test-left", left.get_name());
+  ASSERT_EQ("action-handle-test-right", right.get_name());
+}
+
+TEST(ActionHandleTest, invalid)
+{
+  ActionHandle handle;
+
+  ASSERT_FALSE(handle.is_valid());
+  ASSERT_NE(handle, ActionHandle(""));
+  ASSERT_EQ("", handle.get_name());
+}
+
+/* EOF */
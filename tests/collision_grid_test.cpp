@@ -0,0 +1,101 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "collision/collision_grid.hpp"
+#include "collision/collision_listener.hpp"
+#include "math/rectf.hpp"
+
+namespace {
+
+class DummyListener final : public CollisionListener
+{
+public:
+  virtual void collision_solid(const CollisionHit&) override {}
+  virtual bool collides(GameObject&, const CollisionHit&) const override { return true; }
+  virtual HitResponse collision(GameObject&, const CollisionHit&) override { return CONTINUE; }
+  virtual void collision_tile(uint32_t) override {}
+  virtual bool listener_is_valid() const override { return true; }
+};
+
+bool contains(const std::vector<CollisionObject*>& objects, const CollisionObject& object)
+{
+  return std::find(objects.begin(), objects.end(), &object) != objects.end();
+}
+
+} // namespace
+
+TEST(CollisionGridTest, query)
+{
+  DummyListener listener;
+  CollisionObject near_obj(COLGROUP_STATIC, listener);
+  CollisionObject far_obj(COLGROUP_STATIC, listener);
+
+  CollisionGrid grid;
+  grid.update(near_obj, Rectf(0.0f, 0.0f, 32.0f, 32.0f));
+  grid.update(far_obj, Rectf(2000.0f, 2000.0f, 2032.0f, 2032.0f));
+
+  std::vector<CollisionObject*> result;
+  grid.query(Rectf(16.0f, 16.0f, 48.0f, 48.0f), result);
+  ASSERT_TRUE(contains(result, near_obj));
+  ASSERT_FALSE(contains(result, far_obj));
+
+  // objects touching the query only at the border are returned too
+  grid.query(Rectf(2032.0f, 2032.0f, 2100.0f, 2100.0f), result);
+  ASSERT_FALSE(contains(result, near_obj));
+  ASSERT_TRUE(contains(result, far_obj));
+}
+
+TEST(CollisionGridTest, update_and_remove)
+{
+  DummyListener listener;
+  CollisionObject obj(COLGROUP_MOVING, listener);
+
+  CollisionGrid grid;
+  grid.update(obj, Rectf(0.0f, 0.0f, 200.0f, 32.0f));
+
+  std::vector<CollisionObject*> result;
+  grid.query(Rectf(150.0f, 0.0f, 160.0f, 10.0f), result);
+  ASSERT_EQ(1u, result.size());
+
+  grid.update(obj, Rectf(1000.0f, 0.0f, 1032.0f, 32.0f));
+  grid.query(Rectf(150.0f, 0.0f, 160.0f, 10.0f), result);
+  ASSERT_TRUE(result.empty());
+  grid.query(Rectf(1000.0f, 0.0f, 1010.0f, 10.0f), result);
+  ASSERT_EQ(1u, result.size());
+
+  grid.remove(obj);
+  grid.query(Rectf(1000.0f, 0.0f, 1010.0f, 10.0f), result);
+  ASSERT_TRUE(result.empty());
+}
+
+TEST(CollisionGridTest, oversized)
+{
+  DummyListener listener;
+  CollisionObject huge(COLGROUP_TOUCHABLE, listener);
+
+  CollisionGrid grid;
+  grid.update(huge, Rectf(0.0f, 0.0f, 100000.0f, 100000.0f));
+
+  std::vector<CollisionObject*> result;
+  grid.query(Rectf(50000.0f, 50000.0f, 50010.0f, 50010.0f), result);
+  ASSERT_TRUE(contains(result, huge));
+}
+
+/* EOF */
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include "collision/collision.hpp"
+#include "math/aatriangle.hpp"
 #include "math/rectf.hpp"
 
 TEST(collisionTest, intersects_test)
@@ -47,4 +48,32 @@ TEST(collisionTest, intersects_test)
     ASSERT_EQ(true, collision::intersects(r9, r10));
 }
 
+TEST(collisionTest, clip_line_test)
+{
+    Rectf r(0.0, 0.0, 10.0, 10.0);
+    float t_enter;
+    float t_exit;
+
+    ASSERT_EQ(true, collision::clip_line(r, Vector(-10.0, 5.0), Vector(10.0, 5.0), t_enter, t_exit));
+    ASSERT_FLOAT_EQ(0.5f, t_enter);
+    ASSERT_FLOAT_EQ(1.0f, t_exit);
+
+    ASSERT_EQ(false, collision::clip_line(r, Vector(-10.0, 20.0), Vector(20.0, 20.0), t_enter, t_exit));
+}
+
+TEST(collisionTest, intersects_line_aatriangle_test)
+{
+    // solid in the lower left half of the tile
+    AATriangle triangle(Rectf(0.0, 0.0, 32.0, 32.0), AATriangle::SOUTHWEST);
+
+    // passes through the empty upper right half
+    ASSERT_EQ(false, collision::intersects_line(triangle, Vector(16.0, -8.0), Vector(40.0, 16.0)));
+
+    // passes through the solid part
+    ASSERT_EQ(true, collision::intersects_line(triangle, Vector(-8.0, 24.0), Vector(40.0, 24.0)));
+
+    // misses the tile
+    ASSERT_EQ(false, collision::intersects_line(triangle, Vector(-8.0, 40.0), Vector(40.0, 40.0)));
+}
+
 /* EOF */
@@ -0,0 +1,104 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "util/reader_cache.hpp"
+#include "util/reader_document.hpp"
+#include "util/reader_mapping.hpp"
+
+namespace {
+
+std::string to_string(const sexp::Value& sx)
+{
+  std::ostringstream out;
+  out << sx;
+  return out.str();
+}
+
+} // namespace
+
+TEST(ReaderCacheTest, roundtrip)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (mybool #t)\n"
+    "   (myint -123456789)\n"
+    "   (myfloat 1.125)\n"
+    "   (mystring \"Hello World\")\n"
+    "   (mystringtrans (_ \"Hello World\"))\n"
+    "   (mymapping (a 1) (b 2) (a 3))\n"
+    "   (empty)\n"
+    ")\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+  const std::string data = ReaderCache::serialize(doc.get_sexp());
+  const sexp::Value sx = ReaderCache::deserialize(data);
+  ASSERT_EQ(to_string(doc.get_sexp()), to_string(sx));
+
+  ReaderDocument cached("<cache>", sx);
+  auto mapping = cached.get_root().get_mapping();
+
+  int myint = 0;
+  mapping.get("myint", myint);
+  ASSERT_EQ(-123456789, myint);
+
+  float myfloat = 0.0f;
+  mapping.get("myfloat", myfloat);
+  ASSERT_EQ(1.125f, myfloat);
+
+  std::string mystring;
+  mapping.get("mystringtrans", mystring);
+  ASSERT_EQ("Hello World", mystring);
+}
+
+TEST(ReaderCacheTest, interned)
+{
+  std::istringstream in("(a (name \"foo\") (name \"foo\") (name \"foo\") (name \"foo\"))");
+  auto doc = ReaderDocument::from_stream(in);
+  const std::string data = ReaderCache::serialize(doc.get_sexp());
+
+  // 'name' and "foo" are only stored once each
+  ASSERT_EQ(1u, std::count(data.begin(), data.end(), 'f'));
+  ASSERT_EQ(1u, std::count(data.begin(), data.end(), 'n'));
+}
+
+TEST(ReaderCacheTest, truncated)
+{
+  std::istringstream in("(a (b 1 2 3))");
+  auto doc = ReaderDocument::from_stream(in);
+  const std::string data = ReaderCache::serialize(doc.get_sexp());
+
+  for (size_t len = 0; len < data.size(); ++len)
+  {
+    ASSERT_THROW(ReaderCache::deserialize(data.substr(0, len)), std::runtime_error);
+  }
+}
+
+TEST(ReaderCacheTest, is_cacheable)
+{
+  ASSERT_TRUE(ReaderCache::is_cacheable("levels/world1/intro.stl"));
+  ASSERT_TRUE(ReaderCache::is_cacheable("levels/world1/worldmap.stwm"));
+  ASSERT_TRUE(ReaderCache::is_cacheable("images/creatures/tux/tux.sprite"));
+  ASSERT_TRUE(ReaderCache::is_cacheable("images/tiles.strf"));
+  ASSERT_FALSE(ReaderCache::is_cacheable("config"));
+  ASSERT_FALSE(ReaderCache::is_cacheable("levels/world1/info"));
+}
+
+/* EOF */
@@ -137,4 +137,54 @@ TEST(ReaderTest, syntax_error)
   ASSERT_THROW({mymapping->get("b", myint);}, std::runtime_error);
 }
 
+TEST(ReaderTest, large_mapping)
+{
+  std::ostringstream text;
+  text << "(supertux-test\n";
+  for (int i = 0; i < 100; ++i)
+  {
+    text << "   (key" << i << " " << i << ")\n";
+  }
+  text << "   (key7 1000)\n";
+  text << ")\n";
+
+  std::istringstream in(text.str());
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  for (int i = 0; i < 100; ++i)
+  {
+    int value = -1;
+    ASSERT_TRUE(mapping.get(("key" + std::to_string(i)).c_str(), value));
+    ASSERT_EQ(i, value);
+  }
+
+  int value = -1;
+  ASSERT_FALSE(mapping.get("key100", value));
+  ASSERT_FALSE(mapping.get("key", value));
+  ASSERT_EQ(-1, value);
+
+  // copies keep working
+  ReaderMapping copy = mapping;
+  ASSERT_TRUE(copy.get("key99", value));
+  ASSERT_EQ(99, value);
+}
+
+TEST(ReaderTest, large_mapping_syntax_error)
+{
+  std::istringstream in(
+    "(supertux-test\n"
+    "   (a 1) (b 2) (c 3) (d 4) (e 5) (f 6) (g 7) (h 8)\n"
+    "   err\n"
+    "   (i 9))\n");
+
+  auto doc = ReaderDocument::from_stream(in);
+  auto mapping = doc.get_root().get_mapping();
+
+  int value;
+  ASSERT_TRUE(mapping.get("h", value));
+  ASSERT_EQ(8, value);
+  ASSERT_THROW({mapping.get("i", value);}, std::runtime_error);
+}
+
 /* EOF */
@@ -0,0 +1,138 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iostream>
+#include <physfs.h>
+#include <stdint.h>
+#include <vector>
+
+#include "audio/sound_manager.hpp"
+#include "audio/sound_source.hpp"
+#include "supertux/globals.hpp"
+
+/** Ends a test that needs the loopback output when OpenAL lacks
+    ALC_SOFT_loopback, gtest versions without GTEST_SKIP() get the
+    skip printed instead */
+#ifdef GTEST_SKIP
+#  define SKIP_WITHOUT_LOOPBACK() GTEST_SKIP() << "OpenAL without ALC_SOFT_loopback"
+#else
+#  define SKIP_WITHOUT_LOOPBACK()                                         \
+  do {                                                                    \
+    std::cout << "[  SKIPPED ] OpenAL without ALC_SOFT_loopback\n";      \
+    return;                                                               \
+  } while (false)
+#endif
+
+namespace {
+
+/** One game frame of audio */
+const size_t CHUNK_FRAMES = SoundManager::LOOPBACK_RATE / 50;
+
+class SoundManagerTest : public ::testing::Test
+{
+protected:
+  virtual void SetUp() override
+  {
+    PHYSFS_init(nullptr);
+    PHYSFS_mount("data", nullptr, 1);
+    g_real_time = 0.0f;
+  }
+
+  virtual void TearDown() override
+  {
+    PHYSFS_deinit();
+  }
+};
+
+/** Advances the game clock and the mix by seconds */
+std::vector<int16_t> render(SoundManager& sound_manager, float seconds)
+{
+  const size_t chunks = static_cast<size_t>(seconds * 50.0f);
+  std::vector<int16_t> samples(2 * CHUNK_FRAMES * chunks);
+  for (size_t i = 0; i < chunks; ++i)
+  {
+    g_real_time += 1.0f / 50.0f;
+    sound_manager.update();
+    sound_manager.render(samples.data() + 2 * CHUNK_FRAMES * i, CHUNK_FRAMES);
+  }
+  return samples;
+}
+
+bool is_silent(const std::vector<int16_t>& samples)
+{
+  return std::all_of(samples.begin(), samples.end(),
+                     [](int16_t sample) { return sample == 0; });
+}
+
+std::vector<int16_t> render_scene()
+{
+  SoundManager sound_manager(SoundManager::OUTPUT_LOOPBACK);
+  sound_manager.set_sound_volume(100);
+  sound_manager.set_music_volume(100);
+  sound_manager.play_music("music/airship_remix.music");
+  sound_manager.play("sounds/coin.wav");
+  return render(sound_manager, 2.0f);
+}
+
+} // namespace
+
+TEST_F(SoundManagerTest, render_is_deterministic)
+{
+  if (!SoundManager(SoundManager::OUTPUT_LOOPBACK).is_audio_enabled())
+    SKIP_WITHOUT_LOOPBACK();
+
+  const auto first = render_scene();
+  const auto second = render_scene();
+  ASSERT_FALSE(is_silent(first));
+  ASSERT_EQ(first, second);
+}
+
+TEST_F(SoundManagerTest, looping_source_keeps_playing)
+{
+  SoundManager sound_manager(SoundManager::OUTPUT_LOOPBACK);
+  if (!sound_manager.is_audio_enabled())
+    SKIP_WITHOUT_LOOPBACK();
+
+  sound_manager.set_sound_volume(100);
+  auto source = sound_manager.create_sound_source("sounds/coin.wav");
+  source->set_looping(true);
+  source->play();
+
+  // the sound is far shorter than that
+  render(sound_manager, 3.0f);
+  ASSERT_TRUE(source->playing());
+  ASSERT_FALSE(is_silent(render(sound_manager, 0.5f)));
+}
+
+TEST_F(SoundManagerTest, music_fades_out)
+{
+  SoundManager sound_manager(SoundManager::OUTPUT_LOOPBACK);
+  if (!sound_manager.is_audio_enabled())
+    SKIP_WITHOUT_LOOPBACK();
+
+  sound_manager.set_music_volume(100);
+  sound_manager.play_music("music/airship_remix.music");
+  ASSERT_FALSE(is_silent(render(sound_manager, 1.0f)));
+
+  sound_manager.stop_music(0.5f);
+  render(sound_manager, 0.6f);
+  ASSERT_TRUE(is_silent(render(sound_manager, 0.5f)));
+}
+
+/* EOF */
@@ -0,0 +1,79 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util/spsc_queue.hpp"
+
+TEST(SPSCQueueTest, push_pop)
+{
+  SPSCQueue<int> queue(2);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(2u, queue.capacity());
+
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_FALSE(queue.push(3));
+
+  int value = 0;
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(queue.push(3));
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(2, value);
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(3, value);
+  EXPECT_FALSE(queue.pop(value));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SPSCQueueTest, threads)
+{
+  const int count = 100000;
+  SPSCQueue<int> queue(16);
+
+  std::thread producer([&queue]{
+      for (int i = 0; i < count; ++i)
+      {
+        while (!queue.push(i))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+  int expected = 0;
+  while (expected < count)
+  {
+    int value;
+    if (queue.pop(value))
+    {
+      ASSERT_EQ(expected, value);
+      ++expected;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  producer.join();
+  EXPECT_TRUE(queue.empty());
+}
+
+/* EOF */
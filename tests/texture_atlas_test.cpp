@@ -0,0 +1,49 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include "video/texture_atlas.hpp"
+
+TEST(TextureAtlasTest, insert)
+{
+  TextureAtlas atlas(128, 128);
+
+  auto a = atlas.insert(64, 32);
+  auto b = atlas.insert(64, 32);
+  ASSERT_TRUE(a && b);
+  ASSERT_EQ(Rect(0, 0, 64, 32), *a);
+  ASSERT_EQ(Rect(64, 0, 128, 32), *b);
+
+  // first shelf is full, a new one gets opened below it
+  auto c = atlas.insert(16, 16);
+  ASSERT_TRUE(c);
+  ASSERT_EQ(Rect(0, 32, 16, 48), *c);
+
+  ASSERT_EQ(64 * 32 * 2 + 16 * 16, atlas.get_used_area());
+}
+
+TEST(TextureAtlasTest, full)
+{
+  TextureAtlas atlas(64, 64);
+
+  ASSERT_FALSE(atlas.insert(65, 1));
+  ASSERT_TRUE(atlas.insert(64, 60));
+  ASSERT_FALSE(atlas.insert(8, 8));
+  ASSERT_TRUE(atlas.insert(8, 4));
+}
+
+/* EOF */
@@ -0,0 +1,103 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Development Team
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "util/tiles_parser.hpp"
+#include "util/writer.hpp"
+
+TEST(TilesParserTest, extract)
+{
+  std::string text =
+    "(tilemap\n"
+    "  (tiles 1 2 3\n"
+    "    0 (rle 7 3) ; comment\n"
+    "    5)\n"
+    "  (name \"(tiles 9)\"))\n";
+
+  std::vector<std::vector<uint32_t> > blocks;
+  TilesParser::extract(text, blocks);
+
+  ASSERT_EQ(1u, blocks.size());
+  ASSERT_EQ(std::vector<uint32_t>({1, 2, 3, 0, 7, 7, 7, 5}), blocks[0]);
+  ASSERT_EQ("(tilemap\n"
+            "  (tiles (tile-block 0)\n"
+            "\n"
+            ")\n"
+            "  (name \"(tiles 9)\"))\n",
+            text);
+}
+
+TEST(TilesParserTest, extract_fallback)
+{
+  const std::string original =
+    "(tileset (tiles (ids 1 2) (width 2))\n"
+    "  (tiles -1 2) (tiles 1.5) (tiles 4294967296) (tiles (rle 1)) (tilesx 1) (tiles))";
+  std::string text = original;
+
+  std::vector<std::vector<uint32_t> > blocks;
+  TilesParser::extract(text, blocks);
+
+  ASSERT_TRUE(blocks.empty());
+  ASSERT_EQ(original, text);
+}
+
+TEST(TilesParserTest, writer_roundtrip)
+{
+  std::vector<unsigned int> tiles(20 * 4, 0);
+  tiles[5] = 12;
+  tiles[6] = 13;
+  for (size_t i = 40; i < 60; ++i) tiles[i] = 99;
+  tiles[79] = 4294967295u;
+
+  std::ostringstream out;
+  {
+    Writer writer(out);
+    writer.set_rle_tiles(true);
+    writer.write_tiles("tiles", tiles, 20);
+  }
+
+  std::string text = out.str();
+  ASSERT_NE(std::string::npos, text.find("(rle 99 20)"));
+
+  std::vector<std::vector<uint32_t> > blocks;
+  TilesParser::extract(text, blocks);
+  ASSERT_EQ(1u, blocks.size());
+  ASSERT_EQ(std::vector<uint32_t>(tiles.begin(), tiles.end()), blocks[0]);
+}
+
+TEST(TilesParserTest, writer_plain_by_default)
+{
+  std::vector<unsigned int> tiles(20 * 4, 99);
+
+  std::ostringstream out;
+  {
+    Writer writer(out);
+    writer.write_tiles("tiles", tiles, 20);
+  }
+
+  std::string text = out.str();
+  ASSERT_EQ(std::string::npos, text.find("rle"));
+
+  std::vector<std::vector<uint32_t> > blocks;
+  TilesParser::extract(text, blocks);
+  ASSERT_EQ(1u, blocks.size());
+  ASSERT_EQ(std::vector<uint32_t>(tiles.begin(), tiles.end()), blocks[0]);
+}
+
+/* EOF */